@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Inverted index from interned artist ids to library rows
+ *
+ * Each artist owns a posting list of the rows that credit it, kept sorted. Rows
+ * normally arrive in increasing order and are simply appended; a row re-added
+ * after an edit is inserted in place.
+ * AND queries intersect the lists smallest-first, galloping through the longer
+ * ones; OR queries are a k-way merge. Both return rows in library order.
+ */
+class ArtistIndex {
+public:
+    typedef std::vector<uint32_t> Postings;
+
+    ArtistIndex();
+
+    /**
+     * @brief Record that a library row credits an artist
+     * @param artist_id Id from the library catalog's artist pool
+     * @param row Library row; O(1) amortized when larger than every row added before
+     */
+    void add(uint32_t artist_id, size_t row);
+
+    /**
+     * @brief Forget that a library row credits an artist (no-op if it did not)
+     */
+    void remove(uint32_t artist_id, size_t row);
+
+    /**
+     * @brief Rows crediting the artist, ascending (empty for an unknown id)
+     */
+    const Postings& postings(uint32_t artist_id) const;
+
+    /**
+     * @brief Rows crediting every one of the artists
+     */
+    std::vector<size_t> match_all(const std::vector<uint32_t>& artist_ids) const;
+
+    /**
+     * @brief Rows crediting at least one of the artists
+     */
+    std::vector<size_t> match_any(const std::vector<uint32_t>& artist_ids) const;
+
+    size_t artist_count() const { return lists.size(); }
+    void clear();
+
+private:
+    std::vector<Postings> lists;  // indexed by artist id
+    Postings none;
+
+    // First position >= from whose row is >= target, probing 1, 2, 4, ... ahead
+    static size_t gallop(const Postings& list, size_t from, uint32_t target);
+};
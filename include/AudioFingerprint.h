@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Compact acoustic fingerprint of a waveform (128 bits)
+ *
+ * The waveform is cut into kBits + 1 equal frames, and bit i is set when frame
+ * i + 1 carries more energy than frame i. Lossy re-encoding nudges every frame
+ * energy a little, so it only flips the bits of neighbouring frames whose
+ * energies were already close: copies of one recording end up a few bits
+ * apart, unrelated recordings about kBits / 2 apart.
+ * Frame energies are summed with SSE2 when the compiler targets it.
+ */
+struct AudioFingerprint {
+    static const size_t kBits = 128;
+
+    uint64_t bits[2];
+
+    AudioFingerprint() : bits() {}
+
+    /**
+     * @brief Fingerprint of count samples; empty() when there are fewer than two per frame
+     */
+    static AudioFingerprint compute(const double* samples, size_t count);
+
+    /**
+     * @brief Same as compute() without SIMD (the fallback, and the benchmark baseline)
+     */
+    static AudioFingerprint compute_scalar(const double* samples, size_t count);
+
+    /**
+     * @brief Number of differing bits (Hamming distance)
+     */
+    int distance(const AudioFingerprint& other) const {
+        return __builtin_popcountll(bits[0] ^ other.bits[0]) + __builtin_popcountll(bits[1] ^ other.bits[1]);
+    }
+
+    bool empty() const { return bits[0] == 0 && bits[1] == 0; }
+    bool operator==(const AudioFingerprint& other) const {
+        return bits[0] == other.bits[0] && bits[1] == other.bits[1];
+    }
+};
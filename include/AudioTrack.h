@@ -1,8 +1,10 @@
 #pragma once
 #include <string>
 #include "PointerWrapper.h"
+#include "AudioFingerprint.h"
 #include <memory>
 #include <vector>
+#include <iosfwd>
 /**
  * Base class for all audio track types in the DJ library system.
  * This class demonstrates virtual functions, Rule of 5, and dynamic memory management.
@@ -24,14 +26,28 @@ protected:
     int bpm;  // beats per minute for mixing
     double* waveform_data;  // Dynamic array for audio analysis
     size_t waveform_size;   // Size of the waveform array
+    AudioFingerprint fingerprint;  // Of waveform_data, computed once the samples are final
+    std::ostream* log_stream;      // where load()/analyze_beatgrid() print; not copied, copies print to std::cout
+
+    // Tag for formats that alter the rendered samples (MP3 quantizes them)
+    struct DeferFingerprint {};
+
+    /**
+     * Constructor that leaves fingerprint empty; the derived constructor computes it
+     * once it has finished with waveform_data, so it is computed only once
+     */
+    AudioTrack(const std::string& title, const std::vector<std::string>& artists,
+               int duration, int bpm, size_t waveform_samples, DeferFingerprint);
 
 public:
+    static const size_t kDefaultWaveformSamples = 1000;
+
     /**
      * Constructor - initializes basic track information
      * Students should call this from derived class constructors
      */
     AudioTrack(const std::string& title, const std::vector<std::string>& artists, 
-               int duration, int bpm, size_t waveform_samples = 1000);
+               int duration, int bpm, size_t waveform_samples = kDefaultWaveformSamples);
 
     // ========== RULE OF 5 - STUDENTS MUST IMPLEMENT ALL OF THESE ==========
 
@@ -71,6 +87,13 @@ public:
      */
     void set_bpm(int bpm);
 
+    /**
+     * Redirect the messages of load() and analyze_beatgrid(), e.g. into a buffer while
+     * they run on a worker thread
+     * @param out Not owned; nullptr restores std::cout
+     */
+    void set_log_stream(std::ostream* out);
+
 
     // ========== VIRTUAL FUNCTIONS FOR POLYMORPHISM ==========
 
@@ -107,10 +130,22 @@ public:
      * Function to get a copy of the waveform data
      */
     void get_waveform_copy(double* buffer, size_t buffer_size) const;
+
+    /**
+     * Fill samples with the waveform of a recording. Copies of one recording (same
+     * title once bracketed tags like "(Original Mix)" are dropped, same lead artist,
+     * case and punctuation ignored) get the same samples in every format.
+     * The samples, and so the fingerprint, depend only on that title and artist:
+     * "X (Radio Edit)" and "X (Extended Mix)" render identically
+     */
+    static void render_waveform(const std::string& title, const std::vector<std::string>& artists,
+                                double* samples, size_t count);
     
     // ========== ACCESSOR FUNCTIONS ==========
     std::string get_title() const { return title; }
     int get_bpm() const { return bpm; }
     int get_duration() const { return duration_seconds; }
     std::vector<std::string> get_artists() const { return artists; }
+    size_t get_waveform_size() const { return waveform_size; }
+    const AudioFingerprint& get_fingerprint() const { return fingerprint; }
 };
\ No newline at end of file
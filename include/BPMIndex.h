@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Bucketed BPM index over the track library
+ *
+ * One bucket per integer BPM, kept in an ordered map; inside a bucket rows are
+ * ordered by quality score (best first, ties by row). A "what can I mix next" query locates the
+ * first bucket in O(log B) and merges the buckets inside the tolerance window by
+ * quality, so the cost is logarithmic in the library size plus the size of the answer.
+ * Entries refer to library rows (0-based positions in DJLibraryService's library).
+ */
+class BPMIndex {
+public:
+    BPMIndex();
+
+    /**
+     * @brief Index a library row; O(log B + log bucket size)
+     * @param row Library position of the track
+     * @param bpm Track BPM (bucket key)
+     * @param quality Track quality score (secondary ordering, higher first)
+     */
+    void add(size_t row, int bpm, double quality);
+
+    /**
+     * @brief Drop a row indexed with these values; O(log B + log bucket size)
+     * @return false if no such entry exists
+     */
+    bool remove(size_t row, int bpm, double quality);
+
+    /**
+     * @brief All rows with |bpm - target| <= tolerance, best quality first
+     * @param bpm Target BPM (typically the active deck)
+     * @param tolerance Maximum BPM difference
+     * @param limit Maximum number of rows to return (0 = no limit)
+     */
+    std::vector<size_t> query(int bpm, int tolerance, size_t limit = 0) const;
+
+    size_t size() const { return entry_count; }
+    bool empty() const { return entry_count == 0; }
+    void clear();
+
+private:
+    typedef std::pair<double, size_t> Entry;  // (quality, row)
+    struct Better {
+        bool operator()(const Entry& a, const Entry& b) const;  // higher quality, then lower row
+    };
+    typedef std::set<Entry, Better> Bucket;
+
+    std::map<int, Bucket> buckets;
+    size_t entry_count;
+};
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+/**
+ * @brief Performance benchmarks for the DJ system
+ *
+ * Invoked from the command line: ./bin/dj_manager -B [benchmark] [args...]
+ * With no benchmark name every benchmark runs with its default parameters.
+ * Results go to stdout; noisy per-track logging is silenced while a benchmark runs.
+ */
+class BenchmarkRunner {
+public:
+    /**
+     * @brief Run the benchmark named by args[0] (or all of them)
+     * @param args Benchmark name followed by benchmark-specific arguments
+     * @return Process exit code (0 on success, 1 for an unknown benchmark)
+     */
+    static int run(const std::vector<std::string>& args);
+
+private:
+    // Plan a synthetic crate with SetPlanner. args: [track_count]
+    static void bench_set_planner(const std::vector<std::string>& args);
+
+    // BPMIndex queries vs. a linear library scan. args: [track_count] [query_count]
+    static void bench_bpm_index(const std::vector<std::string>& args);
+
+    // Playlist append / scan / display / lookup over synthetic tracks vs. a linked list. args: [track_count]
+    static void bench_playlist(const std::vector<std::string>& args);
+
+    // Stream / materialize / import a generated .playlist file. args: [line_count]
+    static void bench_playlist_import(const std::vector<std::string>& args);
+
+    // Smart-playlist query on TrackTable vs. a loop over AudioTrack*. args: [track_count]
+    static void bench_track_table(const std::vector<std::string>& args);
+
+    // LibraryCatalog footprint vs. one AudioTrack per library row. args: [track_count]
+    static void bench_catalog(const std::vector<std::string>& args);
+
+    // Artist AND / OR queries on posting lists vs. a scan over artist lists. args: [track_count] [query_count]
+    static void bench_artist_index(const std::vector<std::string>& args);
+
+    // Top-k trigram search latency / recall for typed, misspelled prefixes. args: [track_count] [query_log]
+    static void bench_fuzzy_search(const std::vector<std::string>& args);
+
+    // Text config parse + library build vs. binary snapshot restore. args: [track_count]
+    static void bench_snapshot(const std::vector<std::string>& args);
+
+    // Incremental reloadLibrary of a few edited tracks vs. a full rebuild. args: [track_count] [changed_tracks]
+    static void bench_reload(const std::vector<std::string>& args);
+
+    // PagedCatalog build / title lookup / playlist resolution with a bounded buffer pool. args: [track_count] [pool_pages]
+    static void bench_paged_catalog(const std::vector<std::string>& args);
+
+    // Waveform fingerprints (SSE2 vs scalar), LSH index build, duplicate grouping and recall. args: [track_count]
+    static void bench_fingerprint(const std::vector<std::string>& args);
+
+    // Reader throughput on published library versions, with and without concurrent reloads, vs a mutex. args: [track_count] [reader_threads]
+    static void bench_versions(const std::vector<std::string>& args);
+
+    // ifstream vs. mapped TextView vs. parallel chunked config parse, 10K lines up to max_lines. args: [max_lines] [threads]
+    static void bench_config_parse(const std::vector<std::string>& args);
+
+    // ConfigKeys perfect-hash lookup vs. the == / prefix comparison chain. args: [lookups]
+    static void bench_config_keys(const std::vector<std::string>& args);
+
+    // Config edit -> settings taken at a track boundary via ConfigWatcher, and the cost of each boundary check. args: [track_count] [updates]
+    static void bench_config_watch(const std::vector<std::string>& args);
+
+    // TextScan delimiter pass per level (bytes per TSC cycle) vs find() per line and field, plus parse throughput. args: [megabytes]
+    static void bench_text_scan(const std::vector<std::string>& args);
+};
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Fixed-size cache of file pages with CLOCK replacement
+ *
+ * The pool owns capacity frames of page_size bytes, allocated once, so its
+ * memory never grows with the file. fetch() returns a page from a frame when
+ * it is resident and reads it with pread() otherwise. When no frame is free,
+ * the clock hand sweeps the frames: a frame used since the last sweep gets its
+ * reference bit cleared and a second chance, and the first frame whose bit is
+ * already clear is evicted. This approximates LRU at O(1) bookkeeping per hit.
+ */
+class BufferPool {
+public:
+    struct Stats {
+        size_t hits = 0;
+        size_t misses = 0;
+        size_t evictions = 0;
+    };
+
+    BufferPool();
+    ~BufferPool();
+
+    BufferPool(const BufferPool&) = delete;
+    BufferPool& operator=(const BufferPool&) = delete;
+
+    /**
+     * @brief Open the file read-only and allocate the frames (drops any previous file)
+     * @param capacity Number of frames (at least 1)
+     * @return false if the file cannot be opened
+     */
+    bool open(const std::string& path, size_t page_size, size_t capacity);
+    void close();
+    bool is_open() const { return fd >= 0; }
+
+    /**
+     * @brief Bytes of a page, read from disk on a miss
+     * @return nullptr on I/O error; otherwise valid until the next fetch()
+     */
+    const char* fetch(uint64_t page_no);
+
+    size_t page_size() const { return page_bytes; }
+    size_t capacity() const { return frames.size(); }
+    size_t memory_bytes() const;
+    const Stats& stats() const { return counters; }
+    void reset_stats() { counters = Stats(); }
+
+private:
+    struct Frame {
+        uint64_t page_no;
+        bool used;        // holds a page
+        bool referenced;  // CLOCK bit: fetched since the hand last passed
+    };
+
+    int fd;
+    size_t page_bytes;
+    std::vector<char> memory;                      // frames back to back
+    std::vector<Frame> frames;
+    std::unordered_map<uint64_t, size_t> resident; // page number -> frame
+    size_t hand;
+    Stats counters;
+
+    size_t pick_victim();
+};
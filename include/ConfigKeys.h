@@ -0,0 +1,149 @@
+#pragma once
+
+#include "TextView.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+/**
+ * @brief Keys with a fixed meaning in dj_config.txt
+ *
+ * The named keys come first, in the order of ConfigKeyHash::kNames; any other
+ * key is Unknown (the session parser reads those as playlist definitions).
+ */
+enum class ConfigKey : uint8_t {
+    AppName,
+    Version,
+    ControllerCacheSize,
+    CacheSize,
+    DefaultCrossfadeTime,
+    BpmTolerance,
+    AutoSync,
+    LibraryTrack,   // library_track_<N>
+    Unknown
+};
+
+/**
+ * @brief The names behind ConfigKeys
+ *
+ * The named keys all have different lengths, so the length alone picks the one
+ * name a key can be. ConfigKeys::lookup() switches on it, and the compiler
+ * rejects the switch if a new name shares a length with another one.
+ */
+struct ConfigKeyHash {
+    static constexpr size_t kCount = 7;  // named keys (ConfigKey values before LibraryTrack)
+    static constexpr const char* kNames[kCount] = {
+        "app_name", "version", "controller_cache_size", "cache_size",
+        "default_crossfade_time", "bpm_tolerance", "auto_sync",
+    };
+
+    static constexpr size_t length(const char* text) {
+        return *text ? 1 + length(text + 1) : 0;
+    }
+};
+
+static_assert(ConfigKeyHash::kCount == 7, "ConfigKeys::lookup switches over 7 names");
+static_assert(ConfigKeyHash::kCount == static_cast<size_t>(ConfigKey::LibraryTrack),
+              "every named ConfigKey needs an entry in ConfigKeyHash::kNames");
+
+/**
+ * @brief Recognize config keys with one length switch and one compare, and bind typed setters to them
+ *
+ * lookup() checks the library_track_ prefix (the common case) with a single
+ * memcmp; any other key is dispatched on its length and compared with the one
+ * name of that length, a memcmp of constant size the compiler inlines. The
+ * setters are templates over a member pointer, so a table of them maps each
+ * key to code that parses the value straight into a typed field of the
+ * caller's settings struct.
+ *
+ * Against the old if/else chain of compares (-B config_keys): library track
+ * keys take the same prefix compare in both, so only the chain's first two
+ * misses are saved. Setting and playlist keys cost one compare here instead of
+ * up to six, though the chain's misses are cheap too because each compare
+ * rejects on length first. The difference per key is small either way; what
+ * the switch adds is a ConfigKey that indexes the setter tables.
+ */
+class ConfigKeys {
+public:
+    static ConfigKey lookup(const TextView& key) {
+        static const size_t kPrefixLength = 14;
+        if (key.size() >= kPrefixLength && std::memcmp(key.data(), "library_track_", kPrefixLength) == 0) {
+            return ConfigKey::LibraryTrack;
+        }
+        switch (key.size()) {
+        case ConfigKeyHash::length(ConfigKeyHash::kNames[0]): return named<0>(key);
+        case ConfigKeyHash::length(ConfigKeyHash::kNames[1]): return named<1>(key);
+        case ConfigKeyHash::length(ConfigKeyHash::kNames[2]): return named<2>(key);
+        case ConfigKeyHash::length(ConfigKeyHash::kNames[3]): return named<3>(key);
+        case ConfigKeyHash::length(ConfigKeyHash::kNames[4]): return named<4>(key);
+        case ConfigKeyHash::length(ConfigKeyHash::kNames[5]): return named<5>(key);
+        case ConfigKeyHash::length(ConfigKeyHash::kNames[6]): return named<6>(key);
+        default: return ConfigKey::Unknown;
+        }
+    }
+
+    /**
+     * @brief "true", "1" or "yes" in any case (the session config's boolean spelling)
+     */
+    static bool parse_flag(const TextView& value) {
+        static const char* const kTrue[] = {"true", "1", "yes"};
+        for (const char* word : kTrue) {
+            const size_t length = std::strlen(word);
+            if (value.size() != length) continue;
+            size_t i = 0;
+            while (i < length && ascii_lower(value[i]) == word[i]) ++i;
+            if (i == length) return true;
+        }
+        return false;
+    }
+
+    // Typed setters: parse value into target.*Field; false if the value is invalid (field untouched)
+    template <typename Target, std::string Target::*Field>
+    static bool set_text(Target& target, const TextView& value) {
+        (target.*Field).assign(value.data(), value.size());
+        return true;
+    }
+
+    template <typename Target, int Target::*Field>
+    static bool set_int(Target& target, const TextView& value) {
+        return value.to_int(target.*Field);
+    }
+
+    template <typename Target, bool Target::*Field>
+    static bool set_flag(Target& target, const TextView& value) {
+        target.*Field = parse_flag(value);
+        return true;
+    }
+
+private:
+    // Compare with a name of known length, so the memcmp is inlined
+    template <size_t Index>
+    static ConfigKey named(const TextView& key) {
+        return std::memcmp(key.data(), ConfigKeyHash::kNames[Index], ConfigKeyHash::length(ConfigKeyHash::kNames[Index])) == 0
+            ? static_cast<ConfigKey>(Index) : ConfigKey::Unknown;
+    }
+
+    static char ascii_lower(char c) {
+        return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+    }
+};
+
+/**
+ * @brief Typed setter bound to a named key, for a table indexed by ConfigKey
+ *
+ * Each consumer lists one entry per named key, in ConfigKey order, and checks
+ * the order with static_assert(bindings_in_order(table)).
+ */
+template <typename Target>
+struct SettingBinding {
+    ConfigKey key;
+    bool (*set)(Target&, const TextView&);  // nullptr: not a setting of Target
+    const char* invalid;                     // warning when the value does not parse
+};
+
+template <typename Target, size_t N>
+constexpr bool bindings_in_order(const SettingBinding<Target> (&bindings)[N], size_t i = 0) {
+    return N == ConfigKeyHash::kCount
+        && (i >= N || (bindings[i].key == static_cast<ConfigKey>(i) && bindings_in_order(bindings, i + 1)));
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "SessionFileParser.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/**
+ * @brief Watches the session config with inotify and re-parses it on a background thread
+ *
+ * The watch is on the file's directory, so editors that save by writing a temp
+ * file and renaming it over the config are seen as well as in-place writes
+ * (IN_CLOSE_WRITE or IN_MOVED_TO for the file's name). Events are allowed to
+ * settle for kSettleMs, then the file is parsed and validated off the session
+ * thread. The result is published as one Update that the session collects with
+ * take() at its next track boundary: taking it is a pointer swap under a mutex
+ * that is never held during a parse, so track processing does not wait. Only
+ * the newest update is kept; an older one that was never taken is replaced.
+ *
+ * Linux only; start() fails elsewhere and the session keeps its polling reload.
+ */
+class ConfigWatcher {
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    static const int kSettleMs = 20;
+
+    struct Update {
+        std::unique_ptr<SessionConfig> config;  // null if the new file was rejected
+        std::string log;                        // parser warnings and summary
+        std::string rejected;                   // why, when config is null
+        uint64_t size;                          // stamp of the parsed file, taken before parsing
+        int64_t mtime_ns;
+        Clock::time_point changed;              // when the first event of the change arrived
+        double parse_ms;
+
+        Update() : config(), log(), rejected(), size(0), mtime_ns(0), changed(), parse_ms(0) {}
+    };
+
+    ConfigWatcher();
+    ~ConfigWatcher();
+
+    ConfigWatcher(const ConfigWatcher&) = delete;
+    ConfigWatcher& operator=(const ConfigWatcher&) = delete;
+
+    /**
+     * @brief Start watching path (stops any previous watch)
+     * @param reason Set when false is returned
+     */
+    bool start(const std::string& path, std::string& reason);
+    void stop();
+    bool is_running() const { return worker.joinable(); }
+
+    /**
+     * @brief Move out the newest update since the last take()
+     * @return false if there is none
+     */
+    bool take(Update& update);
+
+    /**
+     * @brief Updates published so far (parsed changes, valid or not)
+     */
+    size_t published() const;
+
+private:
+    std::string config_path;
+    std::string file_name;
+    int inotify_fd;
+    int wake_pipe[2];      // written by stop() to end the worker's poll
+    std::thread worker;
+
+    mutable std::mutex pending_mutex;
+    std::unique_ptr<Update> pending;
+    size_t published_count;
+
+    void run();
+    bool drain_events();   // true if an event concerned the config file
+    void reparse(Clock::time_point changed);
+};
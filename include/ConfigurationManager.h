@@ -10,14 +10,34 @@
  * Phase 4 note: For this assignment, the playlists directory is always "./playlists"
  * and cache capacity is fixed to 8 by policy; ConfigurationManager may still parse
  * bpm_tolerance and auto_sync.
+ *
+ * Keys are recognized through ConfigKeys (one hash and one compare) and parsed
+ * once into the typed Settings struct; only keys without a fixed meaning are
+ * kept as strings for getSetting. library_track_N lines belong to
+ * SessionFileParser and are skipped.
  */
 class ConfigurationManager {
+public:
+    /**
+     * @brief Settings with a fixed key, stored typed
+     */
+    struct Settings {
+        std::string app_name;
+        std::string version;
+        int cache_size;               // cache_size or controller_cache_size
+        int default_crossfade_time;
+        int bpm_tolerance;
+        bool auto_sync;
+
+        Settings()
+            : app_name(), version(), cache_size(8), default_crossfade_time(5), bpm_tolerance(10),
+              auto_sync(true) {}
+    };
+
 private:
-    int cache_size;
-    int bpm_tolerance;
-    bool auto_sync;
+    Settings settings;
     
-    // Additional config parameters
+    // Additional config parameters (keys without a typed field)
     std::unordered_map<std::string, std::string> additional_settings;
 
 public:
@@ -34,12 +54,19 @@ public:
     bool loadFromFile(const std::string& config_path);
     
     // Configuration getters
-    int getCacheSize() const { return cache_size; }
-    int getBPMTolerance() const { return bpm_tolerance; }
-    bool getAutoSync() const { return auto_sync; }
+    int getCacheSize() const { return settings.cache_size; }
+    int getBPMTolerance() const { return settings.bpm_tolerance; }
+    bool getAutoSync() const { return settings.auto_sync; }
+    int getCrossfadeTime() const { return settings.default_crossfade_time; }
+    const Settings& getSettings() const { return settings; }
+
+    /**
+     * @brief Replace every typed setting at once (e.g. with a reloaded config's values)
+     */
+    void setSettings(const Settings& fresh) { settings = fresh; }
     
     /**
-     * @brief Get additional configuration value by key
+     * @brief Get additional configuration value by key (keys without a typed field only)
      */
     std::string getSetting(const std::string& key) const;
     
@@ -4,6 +4,7 @@
 #include "LRUCache.h"
 #include "CacheSlot.h"
 #include "PointerWrapper.h"
+#include "LatencyTracer.h"
 #include <string>
 
 /**
@@ -17,6 +18,10 @@ public:
     // Construct with a given cache size
     explicit DJControllerService(size_t cache_size = 8);
 
+    // The cache owns non-copyable track slots
+    DJControllerService(const DJControllerService&) = delete;
+    DJControllerService& operator=(const DJControllerService&) = delete;
+
     // Contract: Ensure a track is present in cache by key (full playlist line)
     // Input: A reference to an AudioTrack.
     // Output: An integer indicating the result: 1 for HIT, 0 for MISS without eviction, -1 for MISS with eviction.
@@ -40,8 +45,19 @@ public:
      */
     AudioTrack* getTrackFromCache(const std::string& track_title);
 
+    // Contract: Drop a cached copy whose library track changed; the next load is a MISS
+    // Output: true if the track was cached
+    bool removeTrackFromCache(const std::string& track_title);
+
+    /**
+     * @brief Time cache fills (and their clone/load/analyze stages) into the given tracer
+     * @param tracer Not owned; nullptr disables tracing
+     */
+    void set_tracer(LatencyTracer* tracer) { this->tracer = tracer; }
+
 private:
     LRUCache cache;
+    LatencyTracer* tracer;
 };
 
 #endif // DJCONTROLLERSERVICE_H
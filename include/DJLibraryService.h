@@ -4,6 +4,16 @@
 #include "Playlist.h"
 #include "AudioTrack.h"
 #include "SessionFileParser.h"
+#include "BPMIndex.h"
+#include "TrackTable.h"
+#include "LibraryCatalog.h"
+#include "ArtistIndex.h"
+#include "TrigramIndex.h"
+#include "FingerprintIndex.h"
+#include "PagedCatalog.h"
+#include "LibraryVersion.h"
+#include "EpochDomain.h"
+#include <unordered_map>
 #include <vector>
 #include <string>
 
@@ -14,7 +24,10 @@
 class DJLibraryService {
 public:
     DJLibraryService(const Playlist& playlist);
-    DJLibraryService(): playlist(),library(){}
+    DJLibraryService(): playlist(),catalog(),library(),bpm_index(),track_table(),artist_index(),title_search(),
+        fingerprint_index(),bpm_indexed(0),table_indexed(0),artist_indexed(0),search_indexed(0),fingerprint_indexed(0),
+        recordings(),collapse_duplicates(false),paged(),paged_tracks(),version_epochs(),published(version_epochs),
+        versioning(false),version_tracks(),dirty_rows(),playlist_rows(),version_number(0){}
 
      /**
      * @brief Destructor
@@ -27,6 +40,78 @@ public:
      */
     void buildLibrary(const std::vector<SessionConfig::TrackInfo>& library_tracks);
 
+    /**
+     * @brief Bring the library in line with a re-parsed config, touching only rows that changed
+     * @param library_tracks The new config's tracks; position N-1 is library_track_N
+     * @return Titles of the tracks that were updated or retired, whose cached copies are now stale
+     *
+     * Rows are compared by position. A changed row is rewritten in place and re-indexed,
+     * rows past the end of the new list are retired, and new rows are appended. Unchanged
+     * rows keep their materialized tracks and index entries.
+     */
+    std::vector<std::string> reloadLibrary(const std::vector<SessionConfig::TrackInfo>& library_tracks);
+
+    /**
+     * @brief Write the library and the config it came from to a binary snapshot
+     * @param snapshot_path Snapshot file to (re)write
+     * @param config_path Text config the library was built from
+     * @param config Parsed settings and playlists to store alongside the library
+     * @return false on I/O error
+     */
+    bool saveSnapshot(const std::string& snapshot_path, const std::string& config_path,
+                      const SessionConfig& config) const;
+
+    /**
+     * @brief Replace the library with a snapshot, if it is still current
+     * @param snapshot_path Snapshot file written by saveSnapshot
+     * @param config_path Text config the snapshot must match (size and mtime)
+     * @param config Output settings and playlists (library_tracks stays empty)
+     * @return false if the snapshot is missing, stale or corrupt; the library is then unchanged
+     */
+    bool loadSnapshot(const std::string& snapshot_path, const std::string& config_path, SessionConfig& config);
+
+    /**
+     * @brief Serve the library from a paged catalog file instead of memory
+     * @param path File written by PagedCatalog::build
+     * @param pool_pages Buffer pool size in 4 KiB frames
+     * @param reason Set when false is returned
+     *
+     * Playlists and findTrack then resolve tracks through the file, and only the
+     * tracks of the loaded playlist (plus titles looked up since) are materialized.
+     */
+    bool openPagedCatalog(const std::string& path, size_t pool_pages, std::string& reason);
+
+    /**
+     * @brief Rewrite the paged catalog from a re-parsed config and reopen it
+     * @param stale_titles Set to the titles of the tracks that changed or were retired, whose
+     *        cached copies are now stale
+     * @return false (after reporting why) if a stored row cannot be read or the catalog cannot be
+     *         rewritten; the open catalog is then left as it was
+     */
+    bool reloadPagedCatalog(const std::string& path, const std::string& config_path,
+                            const std::vector<SessionConfig::TrackInfo>& library_tracks,
+                            std::vector<std::string>& stale_titles);
+
+    /**
+     * @brief Published library versions, for reading the library from other threads
+     *
+     * The first call publishes the current library. From then on, every change
+     * (build, reload, snapshot restore, playlist load or import) publishes a new
+     * immutable LibraryVersion once it is complete. A reader thread registers an
+     * EpochDomain::Reader on versionDomain() and takes EpochPublished<LibraryVersion>::Pin
+     * objects: the pinned version stays valid and unchanged until the Pin is gone,
+     * without locks, and is freed after the last Pin on it is released.
+     * Only the in-memory library is versioned. Copying a paged catalog's rows into
+     * versions would undo its bounded memory, so opening one stops publishing: the
+     * last version stays readable but describes the library before the switch.
+     * @return nullptr, after reporting an error, while a paged catalog is open
+     */
+    const EpochPublished<LibraryVersion>* versions();
+    EpochDomain& versionDomain() { return version_epochs; }
+
+    bool isPaged() const { return paged.is_open(); }
+    const PagedCatalog& getPagedCatalog() const { return paged; }
+
     /**
      * @brief Load a playlist by constructing it from track indices
      * @param playlist_name Name of the playlist
@@ -34,6 +119,16 @@ public:
      */
     void loadPlaylistFromIndices(const std::string& playlist_name, const std::vector<int>& track_indices);
 
+    /**
+     * @brief Stream a .playlist file straight into the current playlist
+     * @param playlist_path Path to the .playlist file
+     * @return Number of tracks added, or -1 if the file cannot be opened
+     *
+     * Each line resolves to the library track with the same title; tracks the
+     * library does not know yet are created and added to the library first.
+     */
+    long importPlaylistFile(const std::string& playlist_path);
+
     // Returns a reference to the loaded playlist
     Playlist& getPlaylist();
 
@@ -47,6 +142,8 @@ public:
      * The library retains ownership of the track.
      */
     AudioTrack* findTrack(const std::string& track_title);
+    // With a paged catalog, titles missing from the playlist are looked up in the file; such
+    // tracks stay valid until the next playlist load.
 
     /**
      * @brief Get a vector of all track titles in the current playlist.
@@ -54,9 +151,150 @@ public:
      */
     std::vector<std::string> getTrackTitles() const;
 
+    /**
+     * @brief Library tracks that can be mixed against the given BPM, best quality first.
+     * @param bpm BPM of the reference track (usually the active deck).
+     * @param tolerance Maximum BPM difference, as used by can_mix_tracks.
+     * @param limit Maximum number of tracks to return (0 = all).
+     * @return Raw pointers into the library; ownership stays with the library.
+     */
+    std::vector<AudioTrack*> findMixCandidates(int bpm, int tolerance, size_t limit = 0) const;
+
+    /**
+     * @brief Library tracks matching a column query, in library order
+     * @param query Predicates over bpm / duration / format / quality / artist
+     * @param limit Maximum number of tracks to return (0 = all)
+     * @return Raw pointers into the library; ownership stays with the library.
+     */
+    std::vector<AudioTrack*> queryLibrary(const TrackTable::Query& query, size_t limit = 0) const;
+
+    /**
+     * @brief Library tracks credited to the given artists, in library order
+     * @param artists Exact artist names as they appear in the library
+     * @param match_all true = credited to every artist (AND), false = to any of them (OR)
+     * @return Raw pointers into the library; ownership stays with the library.
+     */
+    std::vector<AudioTrack*> findTracksByArtists(const std::vector<std::string>& artists, bool match_all) const;
+
+    /**
+     * @brief Fuzzy search-as-you-type over library titles and artists
+     * @param query Partial or misspelled text, e.g. "armin van bu" or "stobe"
+     * @param limit Maximum number of results (top-k)
+     * @return Best matches first; raw pointers into the library, which keeps ownership.
+     */
+    std::vector<AudioTrack*> searchLibrary(const std::string& query, size_t limit = 10) const;
+
+    /**
+     * @brief Library tracks that are copies of one recording, found by acoustic fingerprint
+     *
+     * The synthesized waveforms, and so the fingerprints, depend only on the title without
+     * bracketed tags and the lead artist. Rows are therefore copies only if they also have
+     * the same configured bpm and duration.
+     * @return One group per recording with two or more copies. The first track of a group is
+     *         the copy playlists use when duplicates are collapsed: best quality, then earliest.
+     *         Raw pointers into the library, which keeps ownership.
+     */
+    std::vector<std::vector<AudioTrack*>> findDuplicates() const;
+
+    /**
+     * @brief Resolve every playlist entry to the kept copy of its recording, so all copies share
+     * one cache entry and are loaded and analyzed once (in-memory library only)
+     */
+    void setCollapseDuplicates(bool enabled) { collapse_duplicates = enabled; }
+
 private:
-    Playlist playlist;
-    std::vector<AudioTrack*> library;  // Library of all tracks (owned)
+    Playlist playlist;                 // Non-owning view over library tracks
+    LibraryCatalog catalog;            // Library metadata, one SoA row per track
+    mutable std::vector<AudioTrack*> library;  // Materialized tracks by row, nullptr until first use (owned);
+                                               // grows on demand, so it may be shorter than the catalog
+
+    // Secondary indexes over catalog rows. Each one folds in the rows it has not seen yet the
+    // first time a query needs it, so building or restoring a library never pays for them.
+    mutable BPMIndex bpm_index;        // BPM buckets over library rows, quality-ordered
+    mutable TrackTable track_table;    // Columnar copy of library metadata, row == library index
+    mutable ArtistIndex artist_index;  // Catalog artist id -> sorted library rows
+    mutable TrigramIndex title_search; // Trigrams of "title artists" -> library rows
+    mutable FingerprintIndex fingerprint_index;  // LSH buckets of waveform fingerprints -> library rows
+    mutable size_t bpm_indexed;        // catalog rows already in bpm_index
+    mutable size_t table_indexed;      // ... in track_table
+    mutable size_t artist_indexed;     // ... in artist_index
+    mutable size_t search_indexed;     // ... in title_search
+    mutable size_t fingerprint_indexed;  // ... in fingerprint_index
+
+    // Row -> kept copy of the same recording; rebuilt when it no longer covers the catalog
+    mutable std::vector<uint32_t> recordings;
+    bool collapse_duplicates;
+
+    // Out-of-core backend (-C): rows live on disk, only tracks in use are materialized (owned)
+    PagedCatalog paged;
+    std::unordered_map<size_t, AudioTrack*> paged_tracks;
+
+    // Published versions (see versions()); the domain outlives the pointer that retires into it
+    EpochDomain version_epochs;
+    EpochPublished<LibraryVersion> published;
+    bool versioning;                                            // publishing started
+    PersistentVector<SessionConfig::TrackInfo> version_tracks;  // draft of the next version's rows
+    std::vector<uint32_t> dirty_rows;                           // rewritten since the last publish
+    std::vector<uint32_t> playlist_rows;                        // rows behind the playlist entries
+    uint64_t version_number;
+
+    size_t add_library_track(const std::string& type, const std::string& title,
+                             const std::vector<std::string>& artists, int duration,
+                             int bpm, int extra_param1, int extra_param2);
+
+    /**
+     * @brief The AudioTrack for a library row, built from the catalog on first use
+     */
+    AudioTrack* track_at(size_t row) const;
+
+    /**
+     * @brief The AudioTrack for a paged catalog row, taken from previous if it was built before
+     */
+    AudioTrack* paged_track_at(size_t row, std::unordered_map<size_t, AudioTrack*>& previous);
+    void release_paged_tracks(std::unordered_map<size_t, AudioTrack*>& tracks);
+
+    void sync_bpm_index() const;
+    void sync_track_table() const;
+    void sync_artist_index() const;
+    void sync_title_search() const;
+    void sync_fingerprint_index() const;
+
+    /**
+     * @brief Kept copy of every row's recording (the row itself when it has no duplicates)
+     */
+    const std::vector<uint32_t>& recording_rows() const;
+
+    /**
+     * @brief Text title_search indexes for a row: the title followed by its artists
+     */
+    std::string search_text(size_t row) const;
+
+    /**
+     * @brief Rewrite a catalog row and patch every index that already covers it,
+     * touching only the index entries whose keys changed
+     */
+    void update_row(size_t row, const SessionConfig::TrackInfo& info);
+
+    /**
+     * @brief Take a row out of every index that covers it (the caller truncates the catalog)
+     */
+    void retire_row(size_t row);
+
+    /**
+     * @brief Delete the row's materialized track, if any
+     * @return true if a track was deleted (the playlist may point at it)
+     */
+    bool forget_track(size_t row);
+
+    /**
+     * @brief Drop materialized tracks and indexes, e.g. after the catalog was replaced
+     */
+    void reset_derived_state();
+
+    /**
+     * @brief Bring the draft up to date and publish it as the next version (if versioning)
+     */
+    void publish_version();
 };
 
 #endif // DJLIBRARYSERVICE_H
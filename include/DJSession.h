@@ -5,6 +5,13 @@
 #include "MixingEngineService.h"
 #include "SessionFileParser.h"
 #include "ConfigurationManager.h"
+#include "ConfigWatcher.h"
+#include "SetPlanner.h"
+#include "WavWriter.h"
+#include "LatencyTracer.h"
+#include <chrono>
+#include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -39,7 +46,49 @@ private:
     ConfigurationManager config_manager;
     SessionConfig session_config;
     std::vector<std::string> track_titles;
+    std::vector<size_t> track_positions;  // playlist entry behind each track_titles slot
     bool play_all;
+    bool plan_set_order;
+    bool preload_next;
+
+    // Binary library snapshot (-S): restored instead of parsing the text config when current
+    bool use_snapshot;
+    bool library_restored;
+
+    // Paged catalog (-C): the library is served from disk through a fixed-size buffer pool
+    bool paged_catalog;
+
+    // Duplicate collapsing (-D): copies of one recording share a cache entry and one analysis
+    bool collapse_duplicates;
+
+    // Size and mtime of the config file the session was loaded from, to notice edits
+    uint64_t config_size;
+    int64_t config_mtime_ns;
+
+    // Live config (-W): edits are parsed by a background watcher; settings are applied at the
+    // next track boundary, library and playlist changes at the next playlist boundary
+    bool watch_config;
+    ConfigWatcher config_watcher;
+    std::unique_ptr<SessionConfig> watched_config;  // settings applied, library changes still due
+    double watched_parse_ms;
+    struct LiveConfigStats {
+        size_t applied = 0;
+        size_t rejected = 0;
+        double total_ms = 0;   // change on disk -> settings live
+        double max_ms = 0;
+    } live_config;
+
+    // Stage latency tracing (-T / -J)
+    bool trace_latency;
+    std::string latency_json_path;
+    LatencyTracer tracer;
+
+    // Offline render (-R): the played session is mixed straight into a WAV file
+    std::string render_path;
+    WavWriter render_writer;
+    std::vector<int16_t> render_buffer;  // one chunk of interleaved stereo frames
+    double render_audio_seconds;
+    std::chrono::steady_clock::time_point render_started;
     // Session statistics
     struct SessionStats {
         size_t tracks_processed = 0;
@@ -75,11 +124,20 @@ public:
 
     /**
      * Contract: Load playlist into the session library
-     * - Input: playlist name (key from session config)
+     * - Input: playlist name (key from session config), or the path of a .playlist file
+     *   (see load_playlist_file)
      * - Output: true on success; false if playlist not found or empty
      */
     bool load_playlist(const std::string& playlist_name);
 
+    /**
+     * Contract: Stream a .playlist file into the session library (PlaylistReader)
+     * - Input: path of the file, e.g. one found under ./playlists
+     * - Output: true on success; false if the file cannot be read, has no valid track,
+     *   or the library is a paged catalog (-C)
+     */
+    bool load_playlist_file(const std::string& playlist_path);
+
     /**
      * Contract: Demand-load a track into the controller cache.
      * - Input: The name of the track to load.
@@ -104,6 +162,62 @@ public:
 
     const std::string& get_session_name() const { return session_name; }
 
+    /**
+     * @brief Reorder each loaded playlist with SetPlanner before playing it
+     */
+    void set_plan_set_order(bool enabled) { plan_set_order = enabled; }
+
+    /**
+     * @brief Preload the next playlist track into the inactive deck on a worker thread
+     */
+    void set_preload_next(bool enabled) { preload_next = enabled; }
+
+    /**
+     * @brief Start from the binary snapshot next to the config file when it is still current,
+     * and (re)write it after building the library from text otherwise
+     */
+    void set_use_snapshot(bool enabled) { use_snapshot = enabled; }
+
+    /**
+     * @brief Keep the library in a paged file next to the config (rebuilt when the config
+     * changes) instead of in memory; takes precedence over the snapshot
+     */
+    void set_paged_catalog(bool enabled) { paged_catalog = enabled; }
+
+    /**
+     * @brief Find copies of the same recording by acoustic fingerprint, report them, and
+     * play the best copy wherever a playlist lists another (ignored with a paged catalog)
+     */
+    void set_collapse_duplicates(bool enabled) { collapse_duplicates = enabled; }
+
+    /**
+     * @brief Watch the config file (inotify) and apply edits during a set: settings at the
+     * next track boundary, library and playlist changes before the next playlist loads
+     */
+    void set_watch_config(bool enabled) { watch_config = enabled; }
+
+    /**
+     * @brief Time every stage of a track's path (lookup, cache fill, clone, load, analyze,
+     * BPM sync, deck swap) and show per-stage histograms in the session summary
+     * @param json_path If non-empty, the histograms are also exported there as JSON
+     */
+    void set_latency_tracing(bool enabled, const std::string& json_path = "");
+
+    /**
+     * @brief Render the session's mix to a WAV file instead of only simulating it
+     * @param path Output file; an empty path disables rendering
+     */
+    void set_render_output(const std::string& path) { render_path = path; }
+
+    /**
+     * Contract: "What can I mix next" against the active deck
+     * - Input: maximum number of suggestions (0 = all)
+     * - Output: library tracks within bpm_tolerance of the active deck, best quality first;
+     *   empty when no deck is live. The library retains ownership.
+     * - Used by the playlist menu's /mix command
+     */
+    std::vector<AudioTrack*> get_mix_candidates(size_t limit = 0) const;
+
     // TODO: Add more status and display methods as needed, delegating to services
 
 private:
@@ -114,12 +228,106 @@ private:
      * @return true if configuration loaded successfully
      */
     bool load_configuration();
+
+    /**
+     * @brief Re-parse the config file if it changed on disk and apply only the differences:
+     * changed library tracks are rebuilt (and dropped from the controller cache), settings
+     * are re-applied and the playlist definitions are replaced. Deck contents are untouched.
+     * @return true if a new configuration was applied
+     */
+    bool reload_configuration_if_changed();
+
+    /**
+     * @brief Take the watcher's newest parsed config, if any, and apply its settings now;
+     * its library and playlist changes are kept for reload_configuration_if_changed
+     * @return true if new settings were applied
+     */
+    bool apply_watched_config();
+
+    /**
+     * @brief Diff a freshly parsed config into the library and make it the session's config
+     * @param parse_ms Reported alongside the apply time
+     * @return false if the library could not be updated; the session then keeps its current config
+     */
+    bool apply_reloaded_config(SessionConfig& fresh, double parse_ms);
+
+    /**
+     * @brief Print the library's duplicate recordings, kept copy first
+     */
+    void report_duplicates();
+
+    /**
+     * @brief Answer a library query typed at the playlist menu and print the tracks
+     * @param input "/search <text>", "/artist <name> [| <name>...]" (any of them),
+     *        "/artist <name> & <name>..." (all of them), "/bpm <low>-<high>" or "/mix"
+     *        (tracks within bpm_tolerance of the active deck)
+     */
+    void run_library_command(const std::string& input);
+
+    /**
+     * @brief Apply session_config's mixing and cache settings to the services and config_manager
+     */
+    void apply_settings();
+
+    /**
+     * @brief (Re)write the binary snapshot of the current library and config
+     */
+    void save_library_snapshot();
+
+    /**
+     * @brief Open the paged catalog, (re)building it from the parsed config if it is missing or stale
+     * @return false if it can be neither opened nor built
+     */
+    bool open_paged_catalog();
     
     /**
-     * @brief Display available playlists from config and prompt user to select one
-     * @return Selected playlist name, or empty string if cancelled
+     * @brief The .playlist files under ./playlists, sorted by path
+     */
+    std::vector<std::string> find_playlist_files() const;
+
+    /**
+     * @brief Take the loaded playlist's track order, planning it if -P was given
+     */
+    void use_loaded_playlist();
+
+    /**
+     * @brief Display available playlists from config and ./playlists and prompt user to select one
+     * @return Selected playlist name or file path, or empty string if cancelled
      */
     std::string display_playlist_menu_from_config();
+
+    /**
+     * @brief Reorder track_titles to minimize total transition cost and report before/after
+     */
+    void plan_track_order();
+
+    /**
+     * @brief Process every entry of the loaded playlist in order
+     */
+    void play_loaded_playlist();
+
+    /**
+     * @brief Process one playlist entry: controller cache, mixer deck, and render if enabled.
+     * With preloading on, the following entry is handed to the mixer's background preload.
+     * @param position Index into track_titles
+     */
+    void play_track(size_t position);
+
+    /**
+     * @brief Open the render output and switch the mixer into render mode
+     * @return false if the output file cannot be created
+     */
+    bool start_render();
+
+    /**
+     * @brief Stream the active deck's full duration into the render output in fixed-size chunks
+     */
+    void render_active_deck();
+
+    /**
+     * @brief Finalize the WAV file and report the real-time factor
+     */
+    void finish_render();
     /**
      * @brief Print final session summary with statistics
      */
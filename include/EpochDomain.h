@@ -0,0 +1,160 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Epoch-based reclamation: free shared objects once no reader can still see them
+ *
+ * Readers register once per thread (a slot claimed with one compare-and-swap), then
+ * bracket every read with a Guard, which stores the current global epoch in the
+ * reader's slot and clears it again. No locks, and no shared counter is written,
+ * so readers never contend with each other or with writers.
+ *
+ * A writer first unpublishes an object (so new readers cannot reach it), then
+ * retire()s it: the object is stamped with the current epoch and the epoch moves
+ * on. collect() frees every retired object whose stamp is older than every epoch
+ * still pinned. A reader pinned at epoch e can only hold objects retired at e or
+ * later, because pinning happens before the read.
+ */
+class EpochDomain {
+public:
+    static const size_t kMaxReaders = 64;
+
+    /**
+     * @brief A registered reader thread; one per thread, used by one thread at a time
+     */
+    class Reader {
+    public:
+        /**
+         * @throws std::runtime_error when all kMaxReaders slots are taken
+         */
+        explicit Reader(EpochDomain& domain);
+        ~Reader();
+
+        Reader(const Reader&) = delete;
+        Reader& operator=(const Reader&) = delete;
+
+        EpochDomain& domain() const { return owner; }
+
+    private:
+        friend class EpochDomain;
+        EpochDomain& owner;
+        size_t slot;
+    };
+
+    /**
+     * @brief Pins the reader for its lifetime; objects read meanwhile stay alive
+     */
+    class Guard {
+    public:
+        explicit Guard(Reader& reader);
+        ~Guard();
+
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+
+    private:
+        Reader& reader;
+    };
+
+    EpochDomain();
+
+    /**
+     * @brief Frees everything still retired; no reader may be pinned any more
+     */
+    ~EpochDomain();
+
+    EpochDomain(const EpochDomain&) = delete;
+    EpochDomain& operator=(const EpochDomain&) = delete;
+
+    /**
+     * @brief Hand over an object that readers can no longer reach; reclaim runs once it is safe
+     */
+    void retire(std::function<void()> reclaim);
+
+    /**
+     * @brief Run the reclaims of retired objects no pinned reader can see
+     * @return Number of objects reclaimed
+     */
+    size_t collect();
+
+    size_t pending() const;
+    uint64_t epoch() const { return global_epoch.load(); }
+
+private:
+    // One cache line per reader, so pinning never invalidates another reader's line
+    struct alignas(64) Slot {
+        std::atomic<bool> claimed;
+        std::atomic<uint64_t> pinned;  // epoch pinned at, 0 when idle
+    };
+
+    std::atomic<uint64_t> global_epoch;  // starts at 1, so 0 can mean idle
+    Slot slots[kMaxReaders];
+    mutable std::mutex retired_mutex;   // writers only
+    std::vector<std::pair<uint64_t, std::function<void()>>> retired;
+};
+
+/**
+ * @brief A pointer writers replace atomically and readers follow without locks
+ *
+ * publish() swaps in a new object and retires the previous one to the domain, so
+ * a reader holding a Pin keeps one consistent, immutable object for as long as it
+ * needs, while Pins taken later see the newest one.
+ */
+template<typename T>
+class EpochPublished {
+public:
+    /**
+     * @brief A pinned read of the object current when the Pin was taken (may be nullptr)
+     */
+    class Pin {
+    public:
+        Pin(const EpochPublished& published, EpochDomain::Reader& reader)
+            : guard(reader), value(published.current.load()) {}
+
+        Pin(const Pin&) = delete;
+        Pin& operator=(const Pin&) = delete;
+
+        const T* get() const { return value; }
+        const T& operator*() const { return *value; }
+        const T* operator->() const { return value; }
+
+    private:
+        EpochDomain::Guard guard;  // pinned before value is read
+        const T* value;
+    };
+
+    explicit EpochPublished(EpochDomain& domain) : domain(domain), current(nullptr) {}
+
+    /**
+     * @brief Deletes the current object; retired ones belong to the domain
+     */
+    ~EpochPublished() { delete current.load(); }
+
+    EpochPublished(const EpochPublished&) = delete;
+    EpochPublished& operator=(const EpochPublished&) = delete;
+
+    /**
+     * @brief Make next (owned from now on) the current object and reclaim what is safe
+     */
+    void publish(const T* next) {
+        const T* previous = current.exchange(next);
+        if (previous != nullptr) domain.retire([previous]() { delete previous; });
+        domain.collect();
+    }
+
+    /**
+     * @brief The current object, for the writer thread only (readers take a Pin)
+     */
+    const T* latest() const { return current.load(); }
+
+private:
+    EpochDomain& domain;
+    std::atomic<const T*> current;
+};
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "AudioFingerprint.h"
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Locality-sensitive hash index over library fingerprints, for near-duplicate search
+ *
+ * Each fingerprint is split into kBands interleaved bands of 16 bits, and every band value
+ * owns a bucket of the rows that have it. Two fingerprints at most kBands - 1
+ * bits apart must agree on a whole band (one band per differing bit at most), so
+ * a lookup only compares against the rows sharing a bucket with the query and
+ * never misses such a pair; pairs further apart are still found whenever their
+ * differences leave a band untouched. Unrelated fingerprints share a 16-bit band
+ * with probability 1 / 65536 per band, so buckets stay small.
+ */
+class FingerprintIndex {
+public:
+    static const size_t kBands = 8;
+
+    /**
+     * @brief Largest distance at which two fingerprints count as the same recording
+     */
+    static const int kMaxDistance = 16;
+
+    FingerprintIndex();
+
+    /**
+     * @brief Index a row (replacing what it had); empty fingerprints are not indexed
+     */
+    void add(size_t row, const AudioFingerprint& print);
+
+    /**
+     * @brief Un-index a row (no-op if it is not indexed)
+     */
+    void remove(size_t row);
+
+    /**
+     * @brief Indexed rows within max_distance of the fingerprint, ascending
+     */
+    std::vector<size_t> near(const AudioFingerprint& print, int max_distance = kMaxDistance) const;
+
+    /**
+     * @brief Rows grouped by recording: near-duplicate pairs joined transitively (union-find)
+     * @return Groups of two or more rows, each ascending, ordered by their first row
+     */
+    std::vector<std::vector<size_t>> groups(int max_distance = kMaxDistance) const;
+
+    size_t size() const { return indexed; }
+    size_t memory_bytes() const;
+    void clear();
+
+private:
+    typedef std::vector<uint32_t> Postings;
+
+    std::unordered_map<uint32_t, Postings> buckets;  // (band << 16 | band value) -> rows, ascending
+    std::vector<AudioFingerprint> prints;            // by row; empty when not indexed
+    size_t indexed;
+
+    static uint32_t band_key(const AudioFingerprint& print, size_t band);
+};
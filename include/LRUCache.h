@@ -65,6 +65,13 @@ public:
      * @return true if a track was evicted
      */
     bool evictLRU();
+
+    /**
+     * @brief Drop one track, e.g. because its library entry changed
+     * @param track_id Track identifier
+     * @return true if the track was cached
+     */
+    bool remove(const std::string& track_id);
     
     /**
      * @brief Get current cache usage
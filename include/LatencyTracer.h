@@ -0,0 +1,93 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+
+/**
+ * @brief High-resolution timing of every stage on a track's path to the decks
+ *
+ * Each stage owns a log2 histogram of nanosecond durations (bucket i holds samples in
+ * [2^i, 2^(i+1)) ns) plus count/min/max/total. Services record through a Scope placed
+ * around the stage; a null tracer makes the Scope a no-op, so untraced sessions pay nothing.
+ * record() is thread-safe because background preloads time load/analyze on a worker.
+ *
+ * Stages never nest: each sample is time spent in that stage alone, so stage totals add
+ * up. A cache miss times its clone, load and analysis as CACHE_CLONE/CACHE_LOAD/
+ * CACHE_ANALYZE and the insert (with any eviction) as CACHE_FILL; CLONE, LOAD and
+ * ANALYZE_BEATGRID hold only the deck path's samples, preloaded or not.
+ */
+class LatencyTracer {
+public:
+    enum Stage {
+        LIBRARY_LOOKUP,
+        CACHE_CLONE,
+        CACHE_LOAD,
+        CACHE_ANALYZE,
+        CACHE_FILL,
+        CLONE,
+        LOAD,
+        ANALYZE_BEATGRID,
+        BPM_SYNC,
+        DECK_SWAP,
+        STAGE_COUNT
+    };
+
+    static const size_t kBuckets = 40;  // up to 2^40 ns (~18 minutes)
+
+    struct Histogram {
+        uint64_t count;
+        uint64_t total_ns;
+        uint64_t min_ns;
+        uint64_t max_ns;
+        uint64_t buckets[kBuckets];
+
+        Histogram();
+        void add(uint64_t ns);
+        double mean_ns() const { return count ? static_cast<double>(total_ns) / count : 0.0; }
+        /** Upper bound of the bucket holding the given percentile (0-100), clamped to max */
+        uint64_t percentile_ns(double percentile) const;
+    };
+
+    /**
+     * @brief RAII timer: measures from construction to destruction and records the stage
+     */
+    class Scope {
+    public:
+        Scope(LatencyTracer* tracer, Stage stage);
+        ~Scope();
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        LatencyTracer* tracer;
+        Stage stage;
+        std::chrono::steady_clock::time_point start;
+    };
+
+    LatencyTracer();
+
+    void record(Stage stage, uint64_t nanoseconds);
+    Histogram get_histogram(Stage stage) const;
+    void reset();
+
+    static const char* stage_name(Stage stage);
+
+    /**
+     * @brief Print per-stage statistics and bucket distributions (session summary)
+     */
+    void print_summary(std::ostream& out) const;
+
+    /**
+     * @brief Write all histograms as JSON
+     * @return true if the file was written
+     */
+    bool export_json(const std::string& path) const;
+
+private:
+    mutable std::mutex mutex;
+    Histogram histograms[STAGE_COUNT];
+};
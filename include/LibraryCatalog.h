@@ -0,0 +1,144 @@
+#pragma once
+
+#include "StringPool.h"
+#include "MappedColumn.h"
+#include "AudioFingerprint.h"
+#include "SessionFileParser.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class AudioTrack;
+class SnapshotWriter;
+class SnapshotReader;
+
+/**
+ * @brief Compact struct-of-arrays store for library track metadata
+ *
+ * Each track is one row: a title id, a span of artist ids and fixed-width
+ * numeric columns. Titles and artists are interned in StringPools, so an artist
+ * credited on a thousand tracks is stored once. No AudioTrack exists until
+ * materialize() is asked for one; the waveform, vtable and per-track heap strings
+ * are only paid for tracks that are actually used.
+ *
+ * The string pools only grow: a title or artist that no row uses any more after
+ * set() or truncate() keeps its id and bytes until the catalog is rebuilt.
+ */
+class LibraryCatalog {
+public:
+    static const size_t npos = static_cast<size_t>(-1);
+
+    LibraryCatalog();
+
+    /**
+     * @brief Append a track row
+     * @param type "MP3" or "WAV" (anything else is stored as WAV, as buildLibrary always did)
+     * @return Row number (0-based, in insertion order)
+     */
+    size_t add(const std::string& type, const std::string& title, const std::vector<std::string>& artists,
+               int duration, int bpm, int extra_param1, int extra_param2);
+
+    /**
+     * @brief Overwrite a row in place, e.g. when its config line changed
+     *
+     * The row keeps its number. An artist list that does not fit the row's old
+     * span is appended to the artist column and the old span becomes unused; the
+     * column is compacted once more than half of it is unused.
+     */
+    void set(size_t row, const std::string& type, const std::string& title,
+             const std::vector<std::string>& artists, int duration, int bpm,
+             int extra_param1, int extra_param2);
+
+    /**
+     * @brief True if the row already holds exactly these values (no allocation)
+     */
+    bool matches(size_t row, const std::string& type, const std::string& title,
+                 const std::vector<std::string>& artists, int duration, int bpm,
+                 int extra_param1, int extra_param2) const;
+
+    /**
+     * @brief Drop every row from rows on; interned strings stay in the pools,
+     * and the retired artist spans count as unused (see set())
+     */
+    void truncate(size_t rows);
+
+    size_t size() const { return title_ids.size(); }
+
+    /**
+     * @brief First row with exactly this title, or npos
+     */
+    size_t find_title(const std::string& title) const;
+
+    std::string title(size_t row) const { return titles.str(title_ids[row]); }
+    std::vector<std::string> artists(size_t row) const;
+    const uint32_t* artist_ids_begin(size_t row) const { return artist_ids.data() + artist_begins[row]; }
+    const uint32_t* artist_ids_end(size_t row) const { return artist_ids.data() + artist_ends[row]; }
+    int duration(size_t row) const { return durations[row]; }
+    int bpm(size_t row) const { return bpms[row]; }
+    bool is_mp3(size_t row) const { return formats[row] == FORMAT_MP3; }
+
+    /**
+     * @brief Same value the materialized track's get_quality_score() would return
+     */
+    double quality(size_t row) const;
+
+    /**
+     * @brief Build a new AudioTrack for the row (the caller owns it)
+     */
+    AudioTrack* materialize(size_t row) const;
+
+    /**
+     * @brief Fingerprint of the waveform materialize() would give the row, computed
+     * without building the track
+     */
+    AudioFingerprint fingerprint(size_t row) const;
+
+    /**
+     * @brief The row as a config track entry
+     */
+    SessionConfig::TrackInfo info(size_t row) const;
+
+    /**
+     * @brief Bytes held by all columns and string pools (capacity-based)
+     */
+    size_t memory_bytes() const;
+
+    /**
+     * @brief Write / restore every column and both string pools, for LibrarySnapshot
+     * @return load() returns false (leaving the catalog unchanged) if the data is inconsistent
+     */
+    void save(SnapshotWriter& out) const;
+    bool load(SnapshotReader& in);
+
+    const StringPool& title_pool() const { return titles; }
+    const StringPool& artist_pool() const { return artist_names; }
+
+private:
+    enum Format : uint8_t { FORMAT_MP3 = 1, FORMAT_WAV = 2 };
+    static const uint32_t kNoRow = 0xFFFFFFFFu;
+
+    StringPool titles;
+    StringPool artist_names;
+
+    MappedColumn<uint32_t> title_ids;
+    MappedColumn<uint32_t> artist_begins;   // row r credits artist_ids[begins[r], ends[r])
+    MappedColumn<uint32_t> artist_ends;
+    MappedColumn<uint32_t> artist_ids;
+    MappedColumn<int32_t> durations;
+    MappedColumn<int32_t> bpms;
+    MappedColumn<int32_t> extra_param1;     // bitrate for MP3, sample_rate for WAV
+    MappedColumn<int32_t> extra_param2;     // has_tags for MP3, bit_depth for WAV
+    MappedColumn<uint8_t> formats;
+
+    MappedColumn<uint32_t> first_row_by_title;  // title id -> first row using it, or kNoRow
+    MappedColumn<uint32_t> title_rows;          // title id -> number of rows using it
+    size_t unused_artist_ids;                   // artist_ids entries outside every row's span
+
+    // Keep first_row_by_title and title_rows right when row starts / stops using the title
+    void note_title_row(uint32_t title_id, size_t row);
+    void forget_title_row(uint32_t title_id, size_t row);
+
+    // Repack artist_ids in row order once more than half of it is unused
+    void reclaim_artist_ids();
+};
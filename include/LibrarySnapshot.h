@@ -0,0 +1,188 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "MappedColumn.h"
+
+struct SessionConfig;
+class LibraryCatalog;
+
+/**
+ * @brief Sequential binary writer for snapshot sections
+ *
+ * Values are written in native byte order; columns are a uint64 element count
+ * followed by the raw elements, padded to start on an 8-byte boundary so they
+ * can be read in place from a mapping and restored with one copy each.
+ */
+class SnapshotWriter {
+public:
+    static const size_t kAlignment = 8;
+
+    explicit SnapshotWriter(std::ostream& out) : out(out), written(0) {}
+
+    template <typename T>
+    void value(const T& v) {
+        static_assert(std::is_trivially_copyable<T>::value, "snapshot values must be trivially copyable");
+        bytes(reinterpret_cast<const char*>(&v), sizeof(T));
+    }
+
+    template <typename T>
+    void column(const T* values, size_t count) {
+        static_assert(std::is_trivially_copyable<T>::value, "snapshot columns must be trivially copyable");
+        value(static_cast<uint64_t>(count));
+        static const char zeros[kAlignment] = {};
+        bytes(zeros, (kAlignment - written % kAlignment) % kAlignment);
+        if (count) bytes(reinterpret_cast<const char*>(values), count * sizeof(T));
+    }
+
+    template <typename T>
+    void column(const std::vector<T>& values) { column(values.data(), values.size()); }
+
+    template <typename T>
+    void column(const MappedColumn<T>& values) { column(values.data(), values.size()); }
+
+    void string(const std::string& text) {
+        value(static_cast<uint64_t>(text.size()));
+        bytes(text.data(), text.size());
+    }
+
+    bool good() const { return out.good(); }
+
+private:
+    std::ostream& out;
+    uint64_t written;
+
+    void bytes(const char* data, size_t size) {
+        out.write(data, static_cast<std::streamsize>(size));
+        written += size;
+    }
+};
+
+/**
+ * @brief Bounds-checked reader over a mapped snapshot
+ *
+ * Every read fails (and keeps failing) instead of running past the end, so a
+ * truncated or corrupt file is reported rather than crashing the loader.
+ * MappedColumns are attached to the mapping in place; std::vectors are copied.
+ */
+class SnapshotReader {
+public:
+    /**
+     * @param keep_alive Owner of the bytes (the mapping); attached columns hold on to it
+     */
+    SnapshotReader(const std::shared_ptr<const void>& keep_alive, const char* data, size_t size)
+        : mapping(keep_alive), begin(data), cursor(data), end(data + size), good(true) {}
+
+    SnapshotReader(const SnapshotReader&) = delete;
+    SnapshotReader& operator=(const SnapshotReader&) = delete;
+
+    template <typename T>
+    bool value(T& v) {
+        static_assert(std::is_trivially_copyable<T>::value, "snapshot values must be trivially copyable");
+        if (!take(sizeof(T))) return false;
+        std::memcpy(&v, cursor - sizeof(T), sizeof(T));
+        return true;
+    }
+
+    template <typename T>
+    bool column(std::vector<T>& values) {
+        const T* first = nullptr;
+        size_t count = 0;
+        if (!column_span(first, count)) return false;
+        values.assign(first, first + count);
+        return true;
+    }
+
+    template <typename T>
+    bool column(MappedColumn<T>& values) {
+        const T* first = nullptr;
+        size_t count = 0;
+        if (!column_span(first, count)) return false;
+        values.attach(mapping, first, count);
+        return true;
+    }
+
+    bool string(std::string& text) {
+        uint64_t length = 0;
+        if (!value(length) || length > static_cast<uint64_t>(end - cursor)) return good = false;
+        text.assign(cursor, length);
+        cursor += length;
+        return true;
+    }
+
+    bool ok() const { return good; }
+    bool at_end() const { return cursor == end; }
+
+private:
+    std::shared_ptr<const void> mapping;
+    const char* begin;   // mapping base; page-aligned, so column offsets are aligned pointers
+    const char* cursor;
+    const char* end;
+    bool good;
+
+    bool take(size_t bytes) {
+        if (!good || bytes > static_cast<size_t>(end - cursor)) return good = false;
+        cursor += bytes;
+        return true;
+    }
+
+    template <typename T>
+    bool column_span(const T*& first, size_t& count) {
+        static_assert(std::is_trivially_copyable<T>::value, "snapshot columns must be trivially copyable");
+        uint64_t stored = 0;
+        if (!value(stored)) return false;
+        const size_t offset = static_cast<size_t>(cursor - begin);
+        if (!take((SnapshotWriter::kAlignment - offset % SnapshotWriter::kAlignment) % SnapshotWriter::kAlignment)
+            || stored > static_cast<uint64_t>(end - cursor) / sizeof(T)) {
+            return good = false;
+        }
+        first = reinterpret_cast<const T*>(cursor);
+        count = static_cast<size_t>(stored);
+        return take(count * sizeof(T));
+    }
+};
+
+/**
+ * @brief Versioned binary snapshot of the parsed session config and library
+ *
+ * Layout: header (magic, format version, size and mtime of the text config it
+ * was built from), session settings, playlist index arrays, then the library
+ * catalog's string pools and fixed-width columns. Loading maps the file and
+ * the catalog's columns are used in place from the mapping (copied only if the
+ * library is later modified), skipping text parsing and per-track work entirely.
+ *
+ * A snapshot is only used when its version matches and the text config still
+ * has the recorded size and mtime; otherwise the caller falls back to parsing
+ * the text file (and normally rewrites the snapshot).
+ */
+class LibrarySnapshot {
+public:
+    static const uint32_t kVersion = 2;  // 2: per-row artist spans instead of CSR offsets
+
+    /**
+     * @brief Write a snapshot of config settings, playlists and catalog
+     * @param snapshot_path Output file (written to a temp file, then renamed)
+     * @param source_path Text config the data came from (for staleness checks)
+     * @return false on I/O error
+     */
+    static bool save(const std::string& snapshot_path, const std::string& source_path,
+                     const SessionConfig& config, const LibraryCatalog& catalog);
+
+    /**
+     * @brief Restore config settings, playlists and catalog from a snapshot
+     * @param snapshot_path Snapshot file
+     * @param source_path Text config the snapshot must still match
+     * @param config Output; library_tracks is left empty (the catalog holds the tracks)
+     * @param catalog Output; replaced entirely on success, untouched on failure
+     * @param reason Set to why the snapshot was rejected
+     * @return true if the snapshot was current and complete
+     */
+    static bool load(const std::string& snapshot_path, const std::string& source_path,
+                     SessionConfig& config, LibraryCatalog& catalog, std::string& reason);
+};
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "PersistentVector.h"
+#include "SessionFileParser.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class AudioTrack;
+
+/**
+ * @brief One published, immutable state of the library, for readers on other threads
+ *
+ * Versions share structure: tracks is a PersistentVector, so the version published
+ * after a reload that changed k rows shares every trie node with its predecessor
+ * except the O(k log32 n) on the changed paths. Nothing in a version changes once it
+ * is published; DJLibraryService keeps editing its own draft instead.
+ */
+struct LibraryVersion {
+    uint64_t number;                                    // 1, 2, ... in publish order
+    PersistentVector<SessionConfig::TrackInfo> tracks;  // row N-1 = library_track_N
+    std::string playlist_name;                          // playlist loaded at publish time
+    std::vector<uint32_t> playlist_rows;                // its entries, as rows of tracks
+
+    LibraryVersion() : number(0), tracks(), playlist_name(), playlist_rows() {}
+
+    /**
+     * @brief Build a new AudioTrack for a row (the caller owns it)
+     */
+    AudioTrack* materialize(size_t row) const;
+};
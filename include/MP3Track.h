@@ -24,7 +24,8 @@ public:
      * Constructor for MP3Track
      */
     MP3Track(const std::string& title, const std::vector<std::string>& artists, 
-             int duration, int bpm, int bitrate, bool has_tags = true);
+             int duration, int bpm, int bitrate, bool has_tags = true,
+             size_t waveform_samples = kDefaultWaveformSamples);
 
     // ========== TODO: IMPLEMENT VIRTUAL FUNCTIONS ==========
 
@@ -46,6 +47,17 @@ public:
      */
     double get_quality_score() const override;
 
+    /**
+     * Quality score of an MP3 with these properties (what get_quality_score() returns)
+     */
+    static double quality_for(int bitrate, bool has_tags);
+
+    /**
+     * Simulated lossy coding: samples snap to a grid of step 2^-(bitrate / 32),
+     * so lower bitrates stray further from the source recording
+     */
+    static void encode_lossy(double* samples, size_t count, int bitrate);
+
     /**
      * TODO: Implement clone function
      * HINT: Return a unique_ptr to a new MP3Track with same properties
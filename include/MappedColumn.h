@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief Growable array that can also be a read-only view into a mapped file
+ *
+ * A column restored from a LibrarySnapshot points straight into the mapping
+ * (which it keeps alive) instead of copying it, so restoring costs nothing per
+ * element. The first mutation copies the view into an owned vector; from then
+ * on it behaves like std::vector. Const access never copies.
+ */
+template <typename T>
+class MappedColumn {
+public:
+    MappedColumn() : owned(), mapping(), view(nullptr), length(0) {}
+    MappedColumn(size_t count, const T& value) : owned(count, value), mapping(), view(nullptr), length(0) {}
+
+    // Copies share the view (and the mapping) until either one is modified
+    MappedColumn(const MappedColumn&) = default;
+    MappedColumn& operator=(const MappedColumn&) = default;
+    MappedColumn(MappedColumn&&) = default;
+    MappedColumn& operator=(MappedColumn&&) = default;
+
+    /**
+     * @brief Become a view of count elements at data, which mapping keeps alive
+     */
+    void attach(const std::shared_ptr<const void>& keep_alive, const T* data, size_t count) {
+        std::vector<T>().swap(owned);
+        mapping = keep_alive;
+        view = data;
+        length = count;
+    }
+
+    bool is_mapped() const { return view != nullptr; }
+
+    size_t size() const { return view ? length : owned.size(); }
+    bool empty() const { return size() == 0; }
+    const T* data() const { return view ? view : owned.data(); }
+    const T* begin() const { return data(); }
+    const T* end() const { return data() + size(); }
+    const T& operator[](size_t i) const { return data()[i]; }
+    const T& back() const { return data()[size() - 1]; }
+
+    T& operator[](size_t i) {
+        detach();
+        return owned[i];
+    }
+
+    void push_back(const T& value) {
+        detach();
+        owned.push_back(value);
+    }
+
+    void resize(size_t count) {
+        detach();
+        owned.resize(count);
+    }
+
+    void append(const T* first, size_t count) {
+        detach();
+        owned.insert(owned.end(), first, first + count);
+    }
+
+    void swap(std::vector<T>& other) {
+        detach();
+        owned.swap(other);
+    }
+
+    /**
+     * @brief Heap bytes held (a mapped view holds none)
+     */
+    size_t memory_bytes() const { return owned.capacity() * sizeof(T); }
+
+private:
+    std::vector<T> owned;
+    std::shared_ptr<const void> mapping;
+    const T* view;
+    size_t length;
+
+    void detach() {
+        if (!view) return;
+        owned.assign(view, view + length);
+        view = nullptr;
+        length = 0;
+        mapping.reset();
+    }
+};
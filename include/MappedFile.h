@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Read-only memory mapping of a whole file
+ *
+ * The mapping lives as long as the object and data() points straight into the
+ * page cache. Callers read whole files front to back, so pages are prefaulted
+ * in one go where the platform allows it instead of faulting one at a time.
+ * Empty files map to a null pointer with size 0 and still count as open.
+ */
+class MappedFile {
+public:
+    MappedFile();
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * @brief Map the file, replacing any previous mapping
+     * @return false if the file cannot be opened or mapped
+     */
+    bool open(const std::string& path);
+    void close();
+
+    bool is_open() const { return opened; }
+    const char* data() const { return bytes; }
+    size_t size() const { return length; }
+
+    /**
+     * @brief Size and modification time of a file without opening it
+     * @return false if the file does not exist
+     */
+    static bool stat(const std::string& path, uint64_t& size, int64_t& mtime_ns);
+
+private:
+    const char* bytes;
+    size_t length;
+    bool opened;
+};
@@ -2,19 +2,68 @@
 #define MIXINGENGINESERVICE_H
 
 #include "AudioTrack.h"
+#include "LatencyTracer.h"
+#include <atomic>
+#include <cstdint>
+#include <future>
 #include <string>
+#include <vector>
 
 // Service responsible for deck operations and track analysis
 // Phase 4 binding:
 // - Enforces instant transitions and deck alternation policy.
 // - After loading to a deck: call track.load(); then analyze_beatgrid(); then switch active deck.
 // - The previously active deck becomes finished and is unloaded immediately.
+// Background preload (optional): the next track can be cloned, loaded and analyzed on a
+// worker thread while the active deck plays; the transition then only installs the
+// prepared track and atomically flips active_deck.
 class MixingEngineService {
+public:
+    /**
+     * @brief Transition timing: from loadTrackToDeck() being called until the new deck is live
+     */
+    struct TransitionStats {
+        size_t preloaded;       // transitions served by a background preload
+        size_t inline_loads;    // transitions that cloned/loaded/analyzed inline
+        double total_us;
+        double max_us;
+        double last_us;
+
+        TransitionStats() : preloaded(0), inline_loads(0), total_us(0), max_us(0), last_us(0) {}
+    };
+
 private:
     AudioTrack* decks[2];
-    size_t active_deck;
+    std::atomic<size_t> active_deck;
     bool auto_sync;
     int bpm_tolerance;
+
+    // Offline render state (inactive unless enable_render() was called)
+    std::vector<double> deck_waveforms[2];  // wavetable per deck, one pass = one beat
+    double playheads[2];
+    int render_sample_rate;
+    int crossfade_seconds;
+    size_t frames_since_transition;
+
+    // Background preload for the inactive deck
+    struct Preloaded {
+        AudioTrack* track;  // loaded and analyzed clone (owned)
+        std::string log;    // what load()/analyze_beatgrid() printed on the worker
+    };
+    std::future<Preloaded> preload_job;
+    std::string preload_title;
+    TransitionStats transition_stats;
+    LatencyTracer* tracer;  // not owned; nullptr disables stage timing
+
+    void prepare_deck_for_render(size_t deck);
+    double next_render_sample(size_t deck);
+
+    /**
+     * @brief Collect the pending preload; returns it only if it matches the requested title.
+     * Waits for the worker if it is still running; a mismatching preload is discarded.
+     * @param log Receives the worker's buffered load/analyze messages for a matching preload
+     */
+    PointerWrapper<AudioTrack> take_preloaded(const std::string& title, std::string& log);
 public:
     MixingEngineService();
     ~MixingEngineService();
@@ -30,9 +79,36 @@ public:
      */
     int loadTrackToDeck(const AudioTrack& track);
 
+    /** Contract: Prepare the next track for the inactive deck in the background
+     * - @param track: the track that will be requested next; cloned on the calling thread
+     * - @brief load() and analyze_beatgrid() run on a worker thread. A later loadTrackToDeck()
+     *   for the same title installs the prepared clone instead of loading inline.
+     *   Their messages are buffered and printed by that loadTrackToDeck() call, so they never
+     *   interleave with the main thread's output.
+     *   Any earlier, unused preload is discarded.
+     */
+    void preloadTrack(const AudioTrack& track);
+
+    /**
+     * @brief Time clone/load/analyze/BPM sync/deck swap stages into the given tracer
+     * @param tracer Not owned; nullptr disables tracing
+     */
+    void set_tracer(LatencyTracer* tracer) { this->tracer = tracer; }
+
+    const TransitionStats& getTransitionStats() const { return transition_stats; }
+    void resetTransitionStats() { transition_stats = TransitionStats(); }
+
     // Display deck status
     void displayDeckStatus() const;
 
+    /**
+     * @brief Track currently playing on the active deck (nullptr if the deck is empty)
+     * Does not transfer ownership.
+     */
+    const AudioTrack* getActiveTrack() const { return decks[active_deck]; }
+
+    int get_bpm_tolerance() const { return bpm_tolerance; }
+
     /**
      * Contract: Determine if decks A and the given track can be mixed
      * @return true if mixable by BPM/key criteria; false otherwise
@@ -63,6 +139,31 @@ public:
         bpm_tolerance = tolerance;
     }
 
+    /**
+     * @brief Seconds the previous deck fades out under a newly loaded track (render mode)
+     * @param seconds Negative values are treated as 0 (no crossfade)
+     */
+    void set_crossfade(int seconds) {
+        crossfade_seconds = seconds > 0 ? seconds : 0;
+    }
+
+    /**
+     * @brief Enable offline rendering: decks keep playback state from the next load on
+     * @param sample_rate Output sample rate in Hz
+     * @param crossfade Seconds the previous deck fades out under a newly loaded track;
+     *        negative values are treated as 0
+     */
+    void enable_render(int sample_rate, int crossfade);
+
+    /**
+     * Contract: Render the current mix (offline render mode)
+     * - @param out: interleaved 16-bit stereo buffer with room for frames * 2 samples
+     * - @param frames: number of stereo frames to produce
+     * - @brief The active deck plays at its (possibly synced) BPM; during the first crossfade
+     *   seconds after a transition the previous deck fades out underneath it.
+     */
+    void render(int16_t* out, size_t frames);
+
 };
 
 #endif // MIXINGENGINESERVICE_H
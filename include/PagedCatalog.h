@@ -0,0 +1,149 @@
+#pragma once
+
+#include "BufferPool.h"
+#include "SessionFileParser.h"
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+class AudioTrack;
+
+/**
+ * @brief Out-of-core library catalog: track records in fixed-size pages on disk
+ *
+ * File layout, in 4 KiB pages:
+ *   header | record pages | title index pages | row directory | fence keys
+ *
+ * Record pages are slotted: a record count, one offset per record, then the
+ * records (format, duration, bpm, extra params, title, artists). A track's row
+ * number is its ID; records are stored in row order and never span pages.
+ *
+ * The title index is a single sorted run of (FNV-1a 64-bit title hash, row)
+ * entries. Two small arrays stay in memory: the first row of every record page
+ * and the first hash of every index page (fence keys). Together they act as the
+ * inner level of a two-level B+-tree, so a lookup by row or by title is a binary
+ * search in memory plus one or two page reads through the BufferPool. Resident
+ * memory is the pool plus about 12 bytes per 4 KiB page of the file, no matter
+ * how many tracks the catalog holds.
+ */
+class PagedCatalog {
+public:
+    static const size_t npos = static_cast<size_t>(-1);
+    static const size_t kPageSize = 4096;
+    static const uint32_t kVersion = 1;
+
+    /**
+     * @brief Streams records into a new catalog file; memory is one page plus the title index entries
+     */
+    class Writer {
+    public:
+        Writer();
+        ~Writer();
+
+        Writer(const Writer&) = delete;
+        Writer& operator=(const Writer&) = delete;
+
+        /**
+         * @brief Start writing path (via a temp file)
+         * @param source_size / source_mtime_ns Stamp of the config the records come from
+         */
+        bool open(const std::string& path, uint64_t source_size, int64_t source_mtime_ns);
+
+        /**
+         * @brief Append the next row
+         * @return false if the record cannot fit in a page or the file cannot be written
+         */
+        bool add(const SessionConfig::TrackInfo& track);
+
+        /**
+         * @brief Write the index and directories, then move the file into place
+         */
+        bool finish();
+
+    private:
+        std::ofstream file;
+        std::string path;
+        std::string temp_path;
+        uint64_t source_size;
+        int64_t source_mtime;
+        std::vector<char> page;                 // record page being filled
+        std::vector<uint16_t> offsets;          // its record offsets
+        size_t page_fill;                       // bytes of records in page
+        std::vector<uint32_t> first_rows;       // first row of every written record page
+        std::vector<std::pair<uint64_t, uint32_t>> title_entries;
+        uint64_t rows;
+        bool failed;
+
+        void flush_page();
+        void write_page(const char* bytes);
+    };
+
+    PagedCatalog();
+
+    PagedCatalog(const PagedCatalog&) = delete;
+    PagedCatalog& operator=(const PagedCatalog&) = delete;
+
+    /**
+     * @brief Write every track to a new catalog file
+     * @return false on I/O error or a record too large for a page
+     */
+    static bool build(const std::string& path, const std::string& source_path,
+                      const std::vector<SessionConfig::TrackInfo>& tracks);
+
+    /**
+     * @brief Open a catalog file with a pool of pool_pages frames
+     * @param reason Set when false is returned
+     */
+    bool open(const std::string& path, size_t pool_pages, std::string& reason);
+    void close();
+    bool is_open() const { return pool.is_open(); }
+
+    size_t size() const { return static_cast<size_t>(rows); }
+
+    /**
+     * @brief Stamp of the config the file was built from (see MappedFile::stat)
+     */
+    uint64_t source_size() const { return source_bytes; }
+    int64_t source_mtime_ns() const { return source_mtime; }
+
+    /**
+     * @brief Decode one row
+     * @return false if row is out of range or its page cannot be read
+     */
+    bool read(size_t row, SessionConfig::TrackInfo& track);
+
+    /**
+     * @brief First row with exactly this title, or npos
+     */
+    size_t find_title(const std::string& title);
+
+    /**
+     * @brief Build a new AudioTrack for the row (the caller owns it), or nullptr
+     */
+    AudioTrack* materialize(size_t row);
+
+    /**
+     * @brief Pages in the file, and bytes held in memory (pool + directories)
+     */
+    uint64_t page_count() const { return total_pages; }
+    size_t capacity_pages() const { return pool.capacity(); }
+    size_t memory_bytes() const;
+    const BufferPool::Stats& pool_stats() const { return pool.stats(); }
+    void reset_pool_stats() { pool.reset_stats(); }
+
+private:
+    BufferPool pool;
+    uint64_t rows;
+    uint64_t total_pages;
+    uint64_t source_bytes;
+    int64_t source_mtime;
+    uint64_t index_entries;
+    uint64_t index_first_page;
+    std::vector<uint32_t> first_rows;   // record page p holds rows [first_rows[p], first_rows[p + 1])
+    std::vector<uint64_t> fences;       // first title hash of each index page
+
+    static uint64_t hash(const std::string& text);
+    bool title_at(size_t row, std::string& title);
+};
@@ -0,0 +1,190 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Persistent hash map: a hash array mapped trie whose nodes are shared between copies
+ *
+ * Each inner node consumes kBits bits of the key's hash and keeps only the
+ * children that exist (a 32-bit bitmap plus a packed child array). Keys sit in
+ * small leaf buckets that split into an inner node once they hold more than
+ * kLeafSize keys, while hash bits are left to tell them apart.
+ *
+ * As in PersistentVector, copying is O(1) (the copy shares the root), and an
+ * edit clones only the nodes on its root-to-leaf path that another copy still
+ * references, so set() and erase() cost O(log32 n) and leave every other copy
+ * untouched. Nodes that only this map references are edited in place.
+ *
+ * Copies may be read concurrently; each individual copy must be mutated from one
+ * thread at a time.
+ */
+template<typename K, typename V, typename Hash = std::hash<K> >
+class PersistentMap {
+public:
+    PersistentMap() : root(), count(0) {}
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    /**
+     * @brief Value stored for key, or nullptr; valid until this map is next edited
+     */
+    const V* find(const K& key) const {
+        const size_t hash = Hash()(key);
+        const Node* node = root.get();
+        for (unsigned shift = 0; node; shift += kBits) {
+            if (node->is_leaf()) {
+                for (const Item& item : node->items) {
+                    if (item.hash == hash && item.key == key) return &item.value;
+                }
+                return nullptr;
+            }
+            const uint32_t bit = bit_for(hash, shift);
+            if ((node->bitmap & bit) == 0) return nullptr;
+            node = node->children[child_index(node->bitmap, bit)].get();
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Insert key, or replace its value
+     */
+    void set(const K& key, const V& value) {
+        std::pair<V*, bool> stored = insert(key, value);
+        if (!stored.second) *stored.first = value;
+    }
+
+    /**
+     * @brief Insert key with value unless it is present
+     * @return The stored value, which this map no longer shares and the caller may edit
+     *         until the map is next edited, and whether it was inserted
+     */
+    std::pair<V*, bool> insert(const K& key, const V& value) {
+        const size_t hash = Hash()(key);
+        if (!root) root = std::make_shared<Node>();
+        std::shared_ptr<Node>* slot = &root;
+        for (unsigned shift = 0;; shift += kBits) {
+            own(*slot);
+            Node* node = slot->get();
+            if (node->is_leaf()) {
+                for (Item& item : node->items) {
+                    if (item.hash == hash && item.key == key) return std::make_pair(&item.value, false);
+                }
+                if (node->items.size() < kLeafSize || shift >= kHashBits) {
+                    node->items.push_back(Item{hash, key, value});
+                    ++count;
+                    return std::make_pair(&node->items.back().value, true);
+                }
+                split(*node, shift);
+            }
+            const uint32_t bit = bit_for(hash, shift);
+            const size_t index = child_index(node->bitmap, bit);
+            if ((node->bitmap & bit) == 0) {
+                node->bitmap |= bit;
+                node->children.insert(node->children.begin() + static_cast<std::ptrdiff_t>(index),
+                                      std::make_shared<Node>());
+            }
+            slot = &node->children[index];
+        }
+    }
+
+    /**
+     * @brief Remove key
+     * @return false if it was not present
+     */
+    bool erase(const K& key) {
+        if (!find(key)) return false;
+        const size_t hash = Hash()(key);
+        std::shared_ptr<Node>* slot = &root;
+        std::shared_ptr<Node>* parent = nullptr;
+        uint32_t parent_bit = 0;
+        for (unsigned shift = 0;; shift += kBits) {
+            own(*slot);
+            Node* node = slot->get();
+            if (node->is_leaf()) {
+                for (size_t i = 0; i < node->items.size(); ++i) {
+                    if (node->items[i].hash == hash && node->items[i].key == key) {
+                        node->items.erase(node->items.begin() + static_cast<std::ptrdiff_t>(i));
+                        break;
+                    }
+                }
+                // An emptied leaf is unlinked; inner nodes are not merged back
+                if (node->items.empty() && parent) {
+                    Node* up = parent->get();
+                    up->children.erase(up->children.begin()
+                                       + static_cast<std::ptrdiff_t>(child_index(up->bitmap, parent_bit)));
+                    up->bitmap &= ~parent_bit;
+                }
+                --count;
+                return true;
+            }
+            parent = slot;
+            parent_bit = bit_for(hash, shift);
+            slot = &node->children[child_index(node->bitmap, parent_bit)];
+        }
+    }
+
+    void clear() {
+        root.reset();
+        count = 0;
+    }
+
+private:
+    static const unsigned kBits = 5;
+    static const unsigned kHashBits = sizeof(size_t) * 8;
+    static const size_t kLeafSize = 8;
+
+    struct Item {
+        size_t hash;
+        K key;
+        V value;
+    };
+
+    struct Node {
+        uint32_t bitmap;                              // inner nodes: which 32 slots have a child
+        std::vector<std::shared_ptr<Node>> children;  // packed in slot order
+        std::vector<Item> items;                      // leaves
+
+        Node() : bitmap(0), children(), items() {}
+        bool is_leaf() const { return bitmap == 0; }
+    };
+
+    std::shared_ptr<Node> root;
+    size_t count;
+
+    static uint32_t bit_for(size_t hash, unsigned shift) {
+        return static_cast<uint32_t>(1) << ((hash >> shift) & 31);
+    }
+
+    static size_t child_index(uint32_t bitmap, uint32_t bit) {
+        return static_cast<size_t>(__builtin_popcount(bitmap & (bit - 1)));
+    }
+
+    // Copy-on-write: clone a node before editing it if another map shares it
+    static void own(std::shared_ptr<Node>& node) {
+        if (node.use_count() > 1) {
+            node = std::make_shared<Node>(*node);
+        }
+    }
+
+    // Turn a full leaf into an inner node whose children are leaves keyed by the next bits
+    static void split(Node& node, unsigned shift) {
+        std::vector<Item> items;
+        items.swap(node.items);
+        for (Item& item : items) {
+            const uint32_t bit = bit_for(item.hash, shift);
+            const size_t index = child_index(node.bitmap, bit);
+            if ((node.bitmap & bit) == 0) {
+                node.bitmap |= bit;
+                node.children.insert(node.children.begin() + static_cast<std::ptrdiff_t>(index),
+                                     std::make_shared<Node>());
+            }
+            node.children[index]->items.push_back(std::move(item));
+        }
+    }
+};
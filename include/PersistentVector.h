@@ -0,0 +1,241 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief Default measure for PersistentVector: keeps no summary at all
+ *
+ * A measure tells PersistentVector what to cache per trie node. It provides
+ * summary_type (a monoid), identity(), measure(value) and combine(a, b), where
+ * combine must be associative and identity() its neutral element.
+ */
+template<typename T>
+struct NoMeasure {
+    struct summary_type {};
+    static summary_type identity() { return summary_type(); }
+    static summary_type measure(const T&) { return summary_type(); }
+    static summary_type combine(const summary_type&, const summary_type&) { return summary_type(); }
+};
+
+/**
+ * @brief Persistent vector: a 32-way trie whose nodes are shared between copies
+ *
+ * Copying is O(1): the copy just shares the root. Every edit (set / push_back)
+ * walks one root-to-leaf path and clones only the nodes on it that another copy
+ * still references, so an edit costs O(log32 n) and leaves every other copy
+ * untouched. Nodes that only this vector references are edited in place, which
+ * keeps bulk appends into a fresh vector close to std::vector speed.
+ *
+ * Each node also caches the Measure summary of everything below it, refreshed
+ * along the edited path. summary() is O(1), summarize(first, last) answers any
+ * window in O(32 log32 n), and search() finds the first prefix satisfying a
+ * monotone predicate in the same time.
+ *
+ * Copies may be read concurrently; each individual copy must be mutated from one
+ * thread at a time.
+ */
+template<typename T, typename Measure = NoMeasure<T> >
+class PersistentVector {
+public:
+    typedef typename Measure::summary_type Summary;
+
+    PersistentVector() : root(), count(0), shift(0) {}
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    /**
+     * @brief Element at position i (no bounds check)
+     */
+    const T& operator[](size_t i) const {
+        const Node* node = root.get();
+        for (unsigned level = shift; level > 0; level -= kBits) {
+            node = node->children[(i >> level) & kMask].get();
+        }
+        return node->values[i & kMask];
+    }
+
+    /**
+     * @brief Replace the element at position i (no bounds check)
+     */
+    void set(size_t i, const T& value) {
+        Node* path[kMaxDepth];
+        size_t depth = 0;
+        std::shared_ptr<Node>* slot = &root;
+        for (unsigned level = shift; level > 0; level -= kBits) {
+            own(*slot);
+            path[depth++] = slot->get();
+            slot = &(*slot)->children[(i >> level) & kMask];
+        }
+        own(*slot);
+        Node* leaf = slot->get();
+        leaf->values[i & kMask] = value;
+
+        // Anything in the leaf may have changed relative to its neighbours: refold bottom-up
+        leaf->summary = Measure::identity();
+        for (const T& v : leaf->values) leaf->summary = Measure::combine(leaf->summary, Measure::measure(v));
+        while (depth > 0) {
+            Node* node = path[--depth];
+            node->summary = Measure::identity();
+            for (const std::shared_ptr<Node>& child : node->children) {
+                node->summary = Measure::combine(node->summary, child->summary);
+            }
+        }
+    }
+
+    /**
+     * @brief Append an element at the end
+     */
+    void push_back(const T& value) {
+        if (!root) {
+            root = std::make_shared<Node>();
+        } else if (count == (static_cast<size_t>(1) << (shift + kBits))) {
+            // Full tree: grow one level, the old root becomes the first child
+            std::shared_ptr<Node> grown = std::make_shared<Node>();
+            grown->children.push_back(root);
+            grown->summary = root->summary;
+            root = grown;
+            shift += kBits;
+        }
+
+        // The new value lands at the end of every node on its path, so summaries extend on the right
+        const Summary added = Measure::measure(value);
+        std::shared_ptr<Node>* slot = &root;
+        for (unsigned level = shift; level > 0; level -= kBits) {
+            own(*slot);
+            (*slot)->summary = Measure::combine((*slot)->summary, added);
+            std::vector<std::shared_ptr<Node>>& children = (*slot)->children;
+            size_t index = (count >> level) & kMask;
+            if (index == children.size()) {
+                children.push_back(std::make_shared<Node>());
+            }
+            slot = &children[index];
+        }
+        own(*slot);
+        (*slot)->summary = Measure::combine((*slot)->summary, added);
+        (*slot)->values.push_back(value);
+        ++count;
+    }
+
+    void clear() {
+        root.reset();
+        count = 0;
+        shift = 0;
+    }
+
+    /**
+     * @brief Visit every element in order; leaves are walked as contiguous chunks
+     */
+    template<typename F>
+    void for_each(F visit) const {
+        if (root) visit_node(root.get(), shift, visit);
+    }
+
+    /**
+     * @brief Summary of the whole vector, O(1)
+     */
+    Summary summary() const {
+        return root ? root->summary : Measure::identity();
+    }
+
+    /**
+     * @brief Summary of positions [first, last), O(32 log32 n)
+     */
+    Summary summarize(size_t first, size_t last) const {
+        if (!root || first >= last) return Measure::identity();
+        return summarize_node(root.get(), shift, 0, first, last);
+    }
+
+    /**
+     * @brief Smallest i such that done(summary of [0, i]) holds, or size() if none does
+     * @param done Predicate that, once true for a prefix, stays true for every longer one
+     */
+    template<typename Pred>
+    size_t search(Pred done) const {
+        if (!root) return 0;
+        Summary prefix = Measure::identity();
+        const Node* node = root.get();
+        size_t start = 0;
+        for (unsigned level = shift; level > 0; level -= kBits) {
+            const Node* next = nullptr;
+            for (const std::shared_ptr<Node>& child : node->children) {
+                Summary with_child = Measure::combine(prefix, child->summary);
+                if (done(with_child)) {
+                    next = child.get();
+                    break;
+                }
+                prefix = with_child;
+                start += static_cast<size_t>(1) << level;
+            }
+            if (!next) return count;
+            node = next;
+        }
+        for (const T& value : node->values) {
+            prefix = Measure::combine(prefix, Measure::measure(value));
+            if (done(prefix)) return start;
+            ++start;
+        }
+        return count;
+    }
+
+private:
+    static const unsigned kBits = 5;
+    static const size_t kMask = (static_cast<size_t>(1) << kBits) - 1;
+    static const size_t kMaxDepth = 14;  // 5 * 13 bits covers any 64-bit index
+
+    struct Node {
+        std::vector<std::shared_ptr<Node>> children;  // inner nodes
+        std::vector<T> values;                        // leaves
+        Summary summary;                              // of everything below this node
+
+        Node() : children(), values(), summary(Measure::identity()) {}
+    };
+
+    std::shared_ptr<Node> root;
+    size_t count;
+    unsigned shift;   // kBits * (height - 1)
+
+    // Copy-on-write: clone a node before editing it if another vector shares it
+    static void own(std::shared_ptr<Node>& node) {
+        if (node.use_count() > 1) {
+            node = std::make_shared<Node>(*node);
+        }
+    }
+
+    template<typename F>
+    static void visit_node(const Node* node, unsigned level, F& visit) {
+        if (level == 0) {
+            for (const T& value : node->values) visit(value);
+            return;
+        }
+        for (const std::shared_ptr<Node>& child : node->children) {
+            visit_node(child.get(), level - kBits, visit);
+        }
+    }
+
+    static Summary summarize_node(const Node* node, unsigned level, size_t start, size_t first, size_t last) {
+        const size_t span = static_cast<size_t>(1) << (level + kBits);
+        if (first <= start && start + span <= last) return node->summary;
+
+        Summary result = Measure::identity();
+        if (level == 0) {
+            for (size_t i = 0; i < node->values.size(); ++i) {
+                if (start + i >= first && start + i < last) {
+                    result = Measure::combine(result, Measure::measure(node->values[i]));
+                }
+            }
+            return result;
+        }
+        const size_t child_span = static_cast<size_t>(1) << level;
+        for (size_t i = 0; i < node->children.size(); ++i) {
+            size_t child_start = start + i * child_span;
+            if (child_start >= last) break;
+            if (child_start + child_span <= first) continue;
+            result = Measure::combine(result,
+                summarize_node(node->children[i].get(), level - kBits, child_start, first, last));
+        }
+        return result;
+    }
+};
@@ -2,31 +2,104 @@
 #define PLAYLIST_H
 
 #include "AudioTrack.h"
+#include "PersistentMap.h"
+#include "PersistentVector.h"
+#include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
 /**
- * ⚠️  WARNING: THIS CLASS HAS INTENTIONAL MEMORY LEAKS! ⚠️
- * 
- * This is Phase 1 of the assignment - students must identify and fix all memory leaks.
- * @todo Implement proper memory management to prevent leaks.
- * @note In phase 4, the library service should provide canonical ownership semantics
- * for tracks referenced by playlists. Fixes in earlier phases should ensure
- * clear ownership and safe iteration without leaks.
+ * Ordered view over tracks owned elsewhere (normally the library).
+ *
+ * Entries are non-owning handles kept in play order in a persistent vector, so a
+ * playlist that repeats a track (42,42) just stores the same handle twice. Copies
+ * share structure: copying a playlist is O(1) and editing a copy (append, remove,
+ * BPM override) costs O(log n) without disturbing the original, which keeps
+ * filtered / reordered / edited variants cheap.
+ *
+ * A title -> positions index, built on the first lookup, makes find_track() and
+ * remove_track() O(log n). It is persistent as well (a PersistentMap of title
+ * chains plus a PersistentVector of next-position links), so copies share it and
+ * an edit after a copy costs O(log n) instead of rebuilding or cloning it.
+ * Duplicate titles chain their positions in play order; lookup and removal act
+ * on the earliest one. Removal leaves a null tombstone that scans skip, and the
+ * entries are compacted (O(n), amortized over the removals) once tombstones
+ * outnumber live ones.
+ *
+ * Per-entry state that must not leak into the shared library track (such as the
+ * BPM a track was synced to) is stored in the entry itself.
+ *
+ * Aggregates (duration, BPM range, quality sum, MP3/WAV counts) are cached in the
+ * trie nodes and kept current by every edit, so get_stats() is O(1) and
+ * get_window_stats() answers any run of positions in O(log n). A BPM histogram
+ * over the whole playlist is maintained alongside; copies share it until one of
+ * them edits it.
+ * @note The playlist never deletes tracks; whoever owns them must outlive it.
  */
-
-struct PlaylistNode {
-    AudioTrack* track; 
-    PlaylistNode* next;
-
-    PlaylistNode(AudioTrack* t) : track(t), next(nullptr) {}
-};
-
 class Playlist {
+public:
+    /**
+     * @brief Aggregates over a run of playlist entries
+     */
+    struct Stats {
+        int track_count;
+        long long total_duration;  // seconds
+        int min_bpm;               // effective BPM (overrides applied); 0 when track_count == 0
+        int max_bpm;
+        double quality_sum;
+        int mp3_count;
+        int wav_count;
+
+        Stats();
+        double average_quality() const { return track_count ? quality_sum / track_count : 0.0; }
+    };
+
 private:
-    PlaylistNode* head;
+    enum Format { FORMAT_OTHER, FORMAT_MP3, FORMAT_WAV };
+
+    struct Entry {
+        AudioTrack* track;  // not owned; nullptr = removed
+        int bpm_override;   // 0 = use the track's own BPM
+        double quality;     // cached get_quality_score()
+        Format format;
+
+        int bpm() const { return bpm_override ? bpm_override : track->get_bpm(); }
+    };
+
+    struct EntryMeasure {
+        typedef Stats summary_type;
+        static Stats identity() { return Stats(); }
+        static Stats measure(const Entry& entry);
+        static Stats combine(const Stats& a, const Stats& b);
+    };
+
+    struct TitleChain {
+        size_t first;   // earliest live position with this title
+        size_t last;    // latest one, where the next duplicate gets linked
+    };
+
+    struct TitleIndex {
+        PersistentMap<std::string, TitleChain> chains;
+        PersistentVector<size_t> next_same_title;  // per position: next position with the same title, or npos
+
+        TitleIndex() : chains(), next_same_title() {}
+        void link(size_t position, const std::string& title);
+    };
+
+    PersistentVector<Entry, EntryMeasure> entries;  // play order
     std::string playlist_name;
-    int track_count;
+    size_t removed_count;
+    // Effective BPM -> live entries; shared with copies and cloned (O(distinct BPMs)) on the first edit
+    std::shared_ptr<std::map<int, int>> bpm_histogram;
+    // Built lazily so plain append/scan workloads never pay for it
+    mutable TitleIndex title_index;
+    mutable bool title_indexed;
+
+    const TitleIndex& index() const;
+    void compact();
+    size_t raw_position(size_t position) const;
+    void count_bpm(int bpm, int delta);
 
 public:
     /**
@@ -39,20 +112,20 @@ public:
      */
     ~Playlist();
 
-    //copy constructor 
-    Playlist(const Playlist& other);
+    //copy constructor (O(1): shares entries and index with other)
+    Playlist(const Playlist& other) = default;
 
-    //copy assignment operator
-    Playlist& operator=(const Playlist& other);
+    //copy assignment operator (O(1))
+    Playlist& operator=(const Playlist& other) = default;
 
     /**
-     * Add a track to the playlist
+     * Append a track to the end of the playlist (the caller keeps ownership)
      * @param track Pointer to AudioTrack to add
      */
     void add_track(AudioTrack* track);
 
     /**
-     * Remove a track by title
+     * Remove the earliest entry with the given title (the track itself is not deleted)
      * @param title Title of the track to remove
      */
     void remove_track(const std::string& title);
@@ -66,7 +139,7 @@ public:
      * Get playlist statistics
      * @return Number of tracks in the playlist
      */
-    int get_track_count() const { return track_count; }
+    int get_track_count() const { return entries.summary().track_count; }
     const std::string& get_name() const { return playlist_name; }
 
     /**
@@ -79,20 +152,53 @@ public:
     /**
      * Check if playlist is empty
      */
-    bool is_empty() const { return head == nullptr; }
+    bool is_empty() const { return get_track_count() == 0; }
 
     /**
-     * Calculate total duration of all tracks
+     * Calculate total duration of all tracks (O(1), maintained incrementally)
      */
     int get_total_duration() const;
 
     /**
-     * Get all tracks as a vector
+     * @brief Aggregates over the whole playlist, O(1)
+     */
+    Stats get_stats() const;
+
+    /**
+     * @brief Aggregates over play-order positions [first, first + count), O(log n)
+     */
+    Stats get_window_stats(size_t first, size_t count) const;
+
+    /**
+     * @brief Effective BPM -> number of entries at that BPM
+     */
+    const std::map<int, int>& get_bpm_histogram() const { return *bpm_histogram; }
+
+    /**
+     * Get all tracks as a vector, in play order
      */
     std::vector<AudioTrack*> getTracks() const;
 
+    /**
+     * Get all track titles, in play order
+     */
+    std::vector<std::string> getTitles() const;
+
+    /**
+     * @brief Override the BPM of one entry without touching the shared track
+     * @param position Play-order position (0-based, as in getTitles())
+     * @param bpm BPM to report for that entry
+     */
+    void set_bpm_override(size_t position, int bpm);
+
+    /**
+     * @brief BPM of an entry: its override if one is set, otherwise the track's own BPM
+     * @param position Play-order position (0-based, as in getTitles())
+     */
+    int get_entry_bpm(size_t position) const;
+
 };
 
 
 
-#endif // PLAYLIST_H
\ No newline at end of file
+#endif // PLAYLIST_H
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "TextScan.h"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Streaming reader for .playlist files
+ *
+ * The file is read into a fixed buffer (kReadBufferBytes) and each chunk's
+ * complete lines are split by one LineScanner pass (64-byte vector blocks); a
+ * line cut by the end of a chunk is carried to the front of the buffer for the
+ * next read, and the buffer only grows for a line longer than itself. Each
+ * track line is parsed into a caller-owned Record whose strings are reused
+ * between calls, so memory stays bounded by the buffer and the longest line no
+ * matter how large the file is. Blank lines and # comments are skipped (the first comment is kept as the
+ * playlist description); malformed lines are counted, reported and skipped.
+ *
+ * Line format (exactly seven fields, each trimmed):
+ *   MP3,title,artist,duration,bpm,bitrate,has_tags
+ *   WAV,title,artist,duration,bpm,sample_rate,bit_depth
+ *
+ * Usage:
+ *   PlaylistReader reader(path);
+ *   PlaylistReader::Record record;
+ *   while (reader.next(record)) { ... }
+ */
+class PlaylistReader {
+public:
+    struct Record {
+        std::string type;        // MP3 or WAV
+        std::string title;
+        std::string artist;
+        int duration_seconds;
+        int bpm;
+        int extra_param1;        // bitrate for MP3, sample_rate for WAV
+        int extra_param2;        // has_tags for MP3, bit_depth for WAV
+        size_t line_number;
+
+        Record() : type(), title(), artist(), duration_seconds(0), bpm(0),
+                   extra_param1(0), extra_param2(0), line_number(0) {}
+    };
+
+    static const size_t kReadBufferBytes = 64 * 1024;
+
+    explicit PlaylistReader(const std::string& playlist_path);
+    ~PlaylistReader();
+
+    PlaylistReader(const PlaylistReader&) = delete;
+    PlaylistReader& operator=(const PlaylistReader&) = delete;
+
+    bool is_open() const { return fd >= 0; }
+
+    /**
+     * @brief Read the next valid track line
+     * @param record Output; its buffers are reused
+     * @return false at end of file
+     */
+    bool next(Record& record);
+
+    /**
+     * @brief Parse a single track line (no comment/blank handling)
+     * @return true if the line is a well-formed MP3/WAV record
+     */
+    static bool parse_line(const std::string& line, Record& record);
+
+    /**
+     * @brief parse_line on a view whose commas are already known
+     */
+    static bool parse_line(const TextView& line, const LineDelimiters& delimiters, Record& record);
+
+    const std::string& get_comment() const { return comment; }
+    size_t get_lines_read() const { return lines_read; }
+    size_t get_malformed_count() const { return malformed_count; }
+
+    /**
+     * @brief Stream every record of a file into a callback
+     * @return Number of records delivered, or -1 if the file cannot be opened
+     */
+    template<typename F>
+    static long for_each(const std::string& playlist_path, F on_record) {
+        PlaylistReader reader(playlist_path);
+        if (!reader.is_open()) return -1;
+        Record record;
+        long delivered = 0;
+        while (reader.next(record)) {
+            on_record(record);
+            ++delivered;
+        }
+        return delivered;
+    }
+
+private:
+    int fd;
+    std::vector<char> buffer;
+    size_t filled;              // bytes of buffer holding file data
+    size_t scanned;             // bytes of buffer handed to lines (whole lines only)
+    bool at_end;                // the file has been read to its end
+    LineScanner lines;
+    LineDelimiters delimiters;  // commas of the current line
+    std::string comment;
+    size_t lines_read;
+    size_t malformed_count;
+
+    // Move the unscanned tail to the front and read until the buffer holds a whole line
+    bool refill();
+};
@@ -4,6 +4,10 @@
 #include <vector>
 #include <map>
 #include <fstream>
+#include <iosfwd>
+
+class TextView;
+struct LineDelimiters;
 
 /**
  * @brief Configuration data parsed from DJ session config files
@@ -70,9 +74,20 @@ struct PlaylistData {
         int bpm;
         int extra_param1;        // bitrate for MP3, sample_rate for WAV  
         int extra_param2;        // has_tags for MP3, bit_depth for WAV
+
+        PlaylistTrack()
+            : type(""),
+              title(""),
+              artist(""),
+              duration_seconds(0),
+              bpm(0),
+              extra_param1(0),
+              extra_param2(0) {}
     };
     
     std::vector<PlaylistTrack> tracks;
+
+    PlaylistData() : name(""), comment(""), tracks() {}
 };
 
 /**
@@ -81,7 +96,7 @@ struct PlaylistData {
  * This helper class handles parsing of the file formats.
  * Phase 4 note: Playlists are discovered under ./playlists (interactive selection).
  * The app uses bpm_tolerance and auto_sync settings; default_crossfade_time is ignored
- * for logging/behavior in the instant-transition model.
+ * by the instant-transition model and only shapes transitions in offline renders.
  */
 class SessionFileParser {
 public:
@@ -89,6 +104,7 @@ public:
      * @brief Parse a DJ session configuration file
      * @param config_path Path to the .txt configuration file
      * @param config Output structure for parsed data
+     * @param threads Worker threads (0 = std::thread::hardware_concurrency(), 1 = sequential)
      * @return true if parsing successful, false on error
      * 
      * Expected format:
@@ -98,14 +114,51 @@ public:
      * library_track_1=MP3,title,{artist1;artist2;},duration,bpm,bitrate,has_tags
      * library_track_2=WAV,title,{artist1;artist2;},duration,bpm,sample_rate,bit_depth
      * controller_cache_size=8
+     * default_crossfade_time=5
      * bpm_tolerance=10
      * auto_sync=true
      * playlistname=1,2,3
+     *
+     * The file is memory-mapped and walked in place: lines, keys and fields are
+     * TextViews into the mapping, and only values stored in config are copied.
+     * Files that cannot be mapped go through parse_config_stream instead; both
+     * accept the same input and print the same warnings.
+     *
+     * With several threads the mapping is cut at newlines into one chunk per
+     * worker (at least kMinChunkBytes each, so small files stay sequential).
+     * Workers parse their chunk into a partial config and log its warnings;
+     * chunks are then merged in file order, so library_tracks, playlists,
+     * settings and warning line numbers come out exactly as in a sequential parse.
+     */
+    static bool parse_config_file(const std::string& config_path, SessionConfig& config, unsigned threads = 1);
+
+    /**
+     * @brief parse_config_file with warnings and the summary written to log instead of std::cout
+     *
+     * For parses of a file that may be edited meanwhile (the config watcher, the
+     * polling reload). The file is read into an owned buffer instead of mapped:
+     * a save that truncates the file mid-parse would make reads of a mapping
+     * raise SIGBUS. There is no stream fallback: a file that cannot be read is
+     * reported to log and false is returned.
+     */
+    static bool parse_config_file(const std::string& config_path, SessionConfig& config, unsigned threads,
+                                  std::ostream& log);
+
+    /**
+     * @brief Check that a parsed config can replace the running one
+     * @param reason Set to the first problem found when false is returned
+     */
+    static bool validate_config(const SessionConfig& config, std::string& reason);
+
+    /**
+     * @brief Line-by-line std::ifstream parser for the same format
+     *
+     * Fallback for parse_config_file, and the baseline it is benchmarked against.
      */
-    static bool parse_config_file(const std::string& config_path, SessionConfig& config);
+    static bool parse_config_stream(const std::string& config_path, SessionConfig& config);
     
     /**
-     * @brief Parse a playlist file
+     * @brief Parse a playlist file into memory
      * @param playlist_path Path to the .playlist file
      * @param playlist_data Output structure for parsed data
      * @return true if parsing successful, false on error
@@ -114,6 +167,9 @@ public:
      * # Optional comment describing playlist
      * MP3,title,artist,duration,bpm,bitrate,has_tags
      * WAV,title,artist,duration,bpm,sample_rate,bit_depth
+     *
+     * Materializes every track; the session streams playlist files through
+     * PlaylistReader instead (DJLibraryService::importPlaylistFile).
      */
     static bool parse_playlist_file(const std::string& playlist_path, PlaylistData& playlist_data);
     
@@ -132,6 +188,8 @@ public:
     static bool validate_track_format(const std::string& line);
 
 private:
+    static const size_t kMinChunkBytes = 1 << 20;
+
     /**
      * @brief Split a string by delimiter
      * @param str String to split
@@ -201,4 +259,43 @@ private:
      * @return true if parsing successful
      */
     static bool parse_playlist_track(const std::string& line, PlaylistData::PlaylistTrack& track);
+
+    /**
+     * @brief Apply one trimmed, non-empty config line (view-based parse_config_file path)
+     * @param delimiters The line's '=', ',' and ';' positions from the scan of the file
+     * @param log Where warnings go
+     * @return true if the line set a session-wide setting (app_name, version, cache, mixing)
+     */
+    static bool apply_config_line(const TextView& line, const LineDelimiters& delimiters, int line_number,
+                                  SessionConfig& config, std::ostream& log);
+
+    /**
+     * @brief Body of parse_config_file once the file is mapped or read
+     */
+    static void parse_config_text(const TextView& text, SessionConfig& config, unsigned threads, std::ostream& log);
+
+    /**
+     * @brief Parallel body of parse_config_file: parse threads chunks of text and merge them into config
+     */
+    static void parse_config_chunks(const TextView& text, unsigned threads, SessionConfig& config, std::ostream& log);
+
+    /**
+     * @brief View-based parse_library_track; fields are split at the line's scanned commas
+     * and only the stored fields are copied
+     */
+    static bool parse_library_track(const TextView& value, const LineDelimiters& delimiters,
+                                    SessionConfig::TrackInfo& track_info);
+
+    /**
+     * @brief View-based parse_artist_list, split at the scanned semicolons and appending to artists
+     */
+    static void parse_artist_list(const TextView& artist_str, const LineDelimiters& delimiters,
+                                  std::vector<std::string>& artists);
+
+    /**
+     * @brief View-based playlist index list; warns about invalid entries like parse_playlist_line
+     */
+    static void parse_playlist_indices(const TextView& playlist_name, const TextView& value,
+                                       const LineDelimiters& delimiters, std::vector<int>& track_indices,
+                                       std::ostream& log);
 };
\ No newline at end of file
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+/**
+ * @brief Set-order planner for playlists
+ *
+ * Reorders a playlist so that consecutive tracks are as easy to mix as possible.
+ * The cost of a transition a -> b is:
+ *   bpm_weight * |bpm(a) - bpm(b)|
+ *   + over_tolerance_penalty   if the BPM gap exceeds bpm_tolerance (auto_sync would kick in)
+ *   + key_weight * wheel distance between keys (only when both keys are known)
+ *   + repeat_penalty           if a and b are the same library track
+ *
+ * Search: every worker thread seeds a nearest-neighbour tour from a different start
+ * track, then improves it with 2-opt (segment reversal) and Or-opt (moving runs of
+ * 1-3 tracks) until no move helps or the time budget runs out. The cheapest tour wins.
+ */
+class SetPlanner {
+public:
+    /**
+     * @brief One playlist position as seen by the planner
+     */
+    struct Stop {
+        std::string title;
+        int bpm;
+        int key;    // Camelot wheel position 1-12, or -1 when unknown
+
+        Stop(const std::string& title = "", int bpm = 0, int key = -1)
+            : title(title), bpm(bpm), key(key) {}
+    };
+
+    struct Options {
+        int bpm_tolerance;
+        double bpm_weight;
+        double over_tolerance_penalty;
+        double key_weight;
+        double repeat_penalty;
+        unsigned threads;          // 0 = std::thread::hardware_concurrency()
+        double time_budget_ms;     // per-thread improvement budget
+
+        Options()
+            : bpm_tolerance(10), bpm_weight(1.0), over_tolerance_penalty(25.0),
+              key_weight(2.0), repeat_penalty(200.0), threads(0), time_budget_ms(250.0) {}
+    };
+
+    struct Result {
+        std::vector<size_t> order;  // order[i] = index into the input stops
+        double cost_before;
+        double cost_after;
+        double elapsed_ms;
+        unsigned threads_used;
+
+        Result() : order(), cost_before(0), cost_after(0), elapsed_ms(0), threads_used(0) {}
+    };
+
+    explicit SetPlanner(const Options& options = Options());
+
+    /**
+     * @brief Compute a low-cost play order for the given stops
+     * @param stops Playlist positions in their current order
+     * @return Permutation of the stops plus the cost before/after planning
+     */
+    Result plan(const std::vector<Stop>& stops) const;
+
+    /**
+     * @brief Total transition cost of playing the stops in the given order
+     */
+    double path_cost(const std::vector<Stop>& stops, const std::vector<size_t>& order) const;
+
+private:
+    Options options;
+};
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "MappedColumn.h"
+
+class SnapshotWriter;
+class SnapshotReader;
+
+/**
+ * @brief Interned, append-only string storage
+ *
+ * Every distinct string is stored once, back to back in a single byte buffer,
+ * and is identified by a dense 32-bit id. intern() returns the existing id for a
+ * string that was seen before, so a name repeated across thousands of tracks
+ * costs 4 bytes per reference instead of a heap std::string each.
+ *
+ * Lookup is an open-addressing table of ids keyed by FNV-1a hashes (linear
+ * probing, load factor <= 1/2).
+ */
+class StringPool {
+public:
+    static const uint32_t npos = 0xFFFFFFFFu;
+
+    StringPool();
+
+    /**
+     * @brief Id of the string, adding it if it is new
+     */
+    uint32_t intern(const std::string& text);
+
+    /**
+     * @brief Id of the string, or npos if it was never interned
+     */
+    uint32_t find(const std::string& text) const;
+
+    std::string str(uint32_t id) const { return std::string(data(id), length(id)); }
+    const char* data(uint32_t id) const { return bytes.data() + offsets[id]; }
+    size_t length(uint32_t id) const { return offsets[id + 1] - offsets[id]; }
+
+    size_t size() const { return offsets.size() - 1; }
+
+    /**
+     * @brief Bytes held by the pool's buffers (capacity, not just size)
+     */
+    size_t memory_bytes() const;
+
+    /**
+     * @brief Write / restore the pool, including its hash table, for LibrarySnapshot
+     * @return load() returns false (leaving the pool unchanged) if the data is inconsistent
+     */
+    void save(SnapshotWriter& out) const;
+    bool load(SnapshotReader& in);
+
+private:
+    MappedColumn<char> bytes;
+    MappedColumn<uint32_t> offsets;  // string id spans bytes[offsets[id], offsets[id + 1])
+    MappedColumn<uint32_t> hashes;   // per id, so growing the table never rehashes bytes
+    MappedColumn<uint32_t> slots;    // id + 1, or 0 for an empty slot
+
+    static uint32_t hash(const char* text, size_t length);
+    bool equals(uint32_t id, const char* text, size_t length) const;
+    void grow();
+};
@@ -0,0 +1,266 @@
+#pragma once
+
+#include "TextView.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Vectorized search for a small set of delimiter bytes, shared by the text parsers
+ *
+ * masks() compares 64-byte blocks with every delimiter of a set at once and
+ * returns one bit per byte that matched. A block is two 32-byte AVX2 steps
+ * when the CPU has AVX2 (checked once, at first use), four 16-byte SSE2 steps
+ * on any other x86-64 CPU, and a byte loop elsewhere. Parsers walk the bits
+ * (LineScanner, DelimiterScanner) instead of calling find() once per line and field.
+ */
+class TextScan {
+public:
+    static const size_t kBlockBytes = 64;
+    static const size_t kMaxDelimiters = 6;
+    static const size_t kBatchBlocks = 16;     // blocks per masks() call in the scanners
+
+    enum class Level { Scalar, SSE2, AVX2 };
+
+    // Up to kMaxDelimiters bytes; an empty set matches nothing
+    struct Delimiters {
+        char bytes[kMaxDelimiters];
+        size_t count;
+
+        explicit Delimiters(const char* set);
+    };
+
+    /**
+     * @brief The fastest level this CPU supports
+     */
+    static Level best_level();
+    static const char* level_name(Level level);
+
+    /**
+     * @brief Masks of blocks consecutive 64-byte blocks for two sets, loading each block once:
+     * bit i of first_bits[b] is set if text[64 * b + i] is one of first, and so on
+     *
+     * blocks * kBlockBytes bytes must be readable.
+     */
+    static void masks(const char* text, size_t blocks, const Delimiters& first, const Delimiters& second,
+                      Level level, uint64_t* first_bits, uint64_t* second_bits);
+
+    /**
+     * @brief Mask of one block for one set
+     */
+    static uint64_t mask(const char* block, const Delimiters& delimiters, Level level);
+
+    /**
+     * @brief Occurrences of c in text
+     */
+    static size_t count(const TextView& text, char c, Level level = best_level());
+};
+
+/**
+ * @brief The masks of a text's blocks for two delimiter sets, computed kBatchBlocks at a time
+ *
+ * The last, partial block is scanned from a zero-padded copy, so nothing past
+ * the text is read.
+ */
+class BlockMasks {
+public:
+    BlockMasks(const TextView& text, const char* first, const char* second, TextScan::Level level);
+
+    /**
+     * @brief Masks of the block at offset base (a multiple of kBlockBytes inside the text)
+     */
+    void get(size_t base, uint64_t& first_bits, uint64_t& second_bits) {
+        if (base - batch_base >= batch_bytes) fill(base);
+        const size_t index = (base - batch_base) / TextScan::kBlockBytes;
+        first_bits = first_masks[index];
+        second_bits = second_masks[index];
+    }
+
+private:
+    TextView text;
+    TextScan::Delimiters first;
+    TextScan::Delimiters second;
+    TextScan::Level level;
+    size_t batch_base;      // offset of the first block in the buffers
+    size_t batch_bytes;     // bytes the buffers cover
+    uint64_t first_masks[TextScan::kBatchBlocks];
+    uint64_t second_masks[TextScan::kBatchBlocks];
+
+    void fill(size_t base);
+};
+
+/**
+ * @brief Every delimiter of a text, in order, from one pass of 64-byte blocks
+ *
+ * Usage:
+ *   DelimiterScanner scanner(text, "\n,");
+ *   for (size_t at = scanner.next(); at != TextView::npos; at = scanner.next()) { ... }
+ */
+class DelimiterScanner {
+public:
+    DelimiterScanner(const TextView& text, const char* delimiters, TextScan::Level level = TextScan::best_level())
+        : size(text.size()), blocks(text, delimiters, "", level), base(0), bits(0) {
+        load();
+    }
+
+    /**
+     * @brief Offset of the next delimiter, or TextView::npos past the last one
+     */
+    size_t next() {
+        while (bits == 0) {
+            base += TextScan::kBlockBytes;
+            if (base >= size) return TextView::npos;
+            load();
+        }
+        const size_t at = base + static_cast<size_t>(__builtin_ctzll(bits));
+        bits &= bits - 1;
+        return at;
+    }
+
+private:
+    size_t size;
+    BlockMasks blocks;
+    size_t base;        // offset of the current block
+    uint64_t bits;      // its delimiters not returned yet
+
+    void load() {
+        uint64_t none = 0;
+        if (base < size) blocks.get(base, bits, none);
+    }
+};
+
+/**
+ * @brief Where the delimiters of one line are, as bit masks over the 64-byte blocks it spans
+ *
+ * Bit i of words[k] stands for base[64 * k + i]. Only the bits inside the line
+ * are set; callers filter by character when a set has several delimiters.
+ */
+struct LineDelimiters {
+    const char* base;               // start of the block the line starts in
+    std::vector<uint64_t> words;
+
+    LineDelimiters() : base(nullptr), words() {}
+    LineDelimiters(const LineDelimiters&) = default;
+    LineDelimiters& operator=(const LineDelimiters&) = default;
+
+    /**
+     * @brief Scan all of text (newlines included) for delimiters, as one line
+     */
+    void assign(const TextView& text, const char* delimiters, TextScan::Level level = TextScan::best_level());
+
+    /**
+     * @brief First c within view, or nullptr
+     */
+    const char* find(const TextView& view, char c) const {
+        const char* found = nullptr;
+        visit(view, [&found, c](const char* at) {
+            if (*at != c) return true;
+            found = at;
+            return false;
+        });
+        return found;
+    }
+
+    /**
+     * @brief Call on_token for each c-separated token of view, the way TextView::next_token
+     * splits (no trailing empty token); stops early when on_token returns false
+     */
+    template <typename F>
+    void for_each_token(const TextView& view, char c, F on_token) const {
+        const char* start = view.data();
+        const char* end = start + view.size();
+        bool going = true;
+        visit(view, [&](const char* at) {
+            if (*at != c) return true;
+            going = on_token(TextView(start, static_cast<size_t>(at - start)));
+            start = at + 1;
+            return going;
+        });
+        if (going && start < end) on_token(TextView(start, static_cast<size_t>(end - start)));
+    }
+
+private:
+    // Call on_delimiter for each delimiter inside view, in order, until it returns false
+    template <typename F>
+    void visit(const TextView& view, F on_delimiter) const {
+        if (view.empty()) return;
+        const size_t first = static_cast<size_t>(view.data() - base);
+        const size_t last = first + view.size();
+        for (size_t word = first / TextScan::kBlockBytes; word < words.size(); ++word) {
+            const size_t block = word * TextScan::kBlockBytes;
+            if (block >= last) return;
+            uint64_t bits = words[word];
+            if (block < first) bits &= ~static_cast<uint64_t>(0) << (first - block);
+            if (last - block < TextScan::kBlockBytes) bits &= (static_cast<uint64_t>(1) << (last - block)) - 1;
+            while (bits) {
+                const char* at = base + block + static_cast<size_t>(__builtin_ctzll(bits));
+                bits &= bits - 1;
+                if (!on_delimiter(at)) return;
+            }
+        }
+    }
+};
+
+/**
+ * @brief Lines of a text, split the way TextView::next_token('\n') splits them, with the
+ * field delimiters of each line
+ *
+ * Every 64-byte block is scanned once, for newlines and for the field delimiters
+ * at the same time; a line's LineDelimiters are the field masks of its blocks.
+ */
+class LineScanner {
+public:
+    /**
+     * @param field_delimiters Delimiters to record inside each line (not '\n')
+     */
+    LineScanner(const TextView& text, const char* field_delimiters, TextScan::Level level = TextScan::best_level())
+        : text(text), blocks(text, "\n", field_delimiters, level), start(0), base(0), newlines(0), field_bits(0) {
+        load();
+    }
+
+    /**
+     * @return false when no line is left
+     */
+    bool next(TextView& line, LineDelimiters& delimiters) {
+        if (start >= text.size()) return false;
+        if (start - base >= TextScan::kBlockBytes) {
+            // The previous line ended on the last byte of its block
+            base += TextScan::kBlockBytes;
+            load();
+        }
+        delimiters.base = text.data() + base;
+        delimiters.words.clear();
+        uint64_t from_start = ~static_cast<uint64_t>(0) << (start - base);
+        for (;;) {
+            const uint64_t ends = newlines & from_start;
+            if (ends) {
+                const size_t end = static_cast<size_t>(__builtin_ctzll(ends));
+                delimiters.words.push_back(field_bits & from_start & ((static_cast<uint64_t>(1) << end) - 1));
+                line = text.sub(start, base + end - start);
+                start = base + end + 1;
+                return true;
+            }
+            delimiters.words.push_back(field_bits & from_start);
+            if (base + TextScan::kBlockBytes >= text.size()) {
+                line = text.sub(start);
+                start = text.size();
+                return true;
+            }
+            base += TextScan::kBlockBytes;
+            load();
+            from_start = ~static_cast<uint64_t>(0);
+        }
+    }
+
+private:
+    TextView text;
+    BlockMasks blocks;      // newlines, field delimiters
+    size_t start;           // offset of the next line
+    size_t base;            // offset of the current block
+    uint64_t newlines;      // the current block's masks
+    uint64_t field_bits;
+
+    void load() {
+        if (base < text.size()) blocks.get(base, newlines, field_bits);
+    }
+};
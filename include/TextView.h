@@ -0,0 +1,124 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+
+/**
+ * @brief Non-owning view of a run of characters (a C++11 stand-in for string_view)
+ *
+ * Used by the config parser to walk a mapped file without copying: lines, keys
+ * and fields are all views into the mapping, and only the values that end up in
+ * SessionConfig are copied into strings. The viewed bytes must outlive the view.
+ */
+class TextView {
+public:
+    static const size_t npos = static_cast<size_t>(-1);
+
+    TextView() : first(nullptr), length(0) {}
+    TextView(const char* text, size_t size) : first(text), length(size) {}
+    TextView(const char* text) : first(text), length(std::strlen(text)) {}
+
+    const char* data() const { return first; }
+    size_t size() const { return length; }
+    bool empty() const { return length == 0; }
+    char operator[](size_t i) const { return first[i]; }
+    char front() const { return first[0]; }
+    char back() const { return first[length - 1]; }
+    std::string str() const { return std::string(first, length); }
+
+    /**
+     * @brief Offset of the first c, or npos
+     */
+    size_t find(char c) const {
+        if (length == 0) return npos;
+        const void* hit = std::memchr(first, c, length);
+        return hit ? static_cast<size_t>(static_cast<const char*>(hit) - first) : npos;
+    }
+
+    /**
+     * @brief View of [pos, pos + count), clamped to the end
+     */
+    TextView sub(size_t pos, size_t count = npos) const {
+        if (pos > length) pos = length;
+        if (count > length - pos) count = length - pos;
+        return TextView(first + pos, count);
+    }
+
+    /**
+     * @brief Without leading and trailing spaces, tabs, CR and LF
+     */
+    TextView trim() const {
+        size_t start = 0;
+        size_t end = length;
+        while (start < end && is_space(first[start])) ++start;
+        while (end > start && is_space(first[end - 1])) --end;
+        return TextView(first + start, end - start);
+    }
+
+    bool starts_with(const TextView& prefix) const {
+        return prefix.length <= length && std::memcmp(first, prefix.first, prefix.length) == 0;
+    }
+
+    bool operator==(const TextView& other) const {
+        return length == other.length && (length == 0 || std::memcmp(first, other.first, length) == 0);
+    }
+    bool operator!=(const TextView& other) const { return !(*this == other); }
+
+    /**
+     * @brief Split off the next delimited token, the way std::getline does
+     *
+     * The token is everything up to the delimiter (or the end), and the view
+     * shrinks past it. A trailing empty token is not produced, so "a,b," yields
+     * two tokens and an empty view none.
+     * @return false when nothing is left
+     */
+    bool next_token(char delimiter, TextView& token) {
+        if (length == 0) return false;
+        size_t stop = find(delimiter);
+        if (stop == npos) {
+            token = *this;
+            first += length;
+            length = 0;
+        } else {
+            token = TextView(first, stop);
+            first += stop + 1;
+            length -= stop + 1;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Parse a decimal int with the same acceptance as std::stoi
+     *
+     * Leading whitespace and a sign are skipped, at least one digit is
+     * required, and parsing stops at the first non-digit ("12abc" is 12).
+     * @return false where std::stoi would throw (no digits, or out of int range)
+     */
+    bool to_int(int& value) const {
+        size_t i = 0;
+        while (i < length && (is_space(first[i]) || first[i] == '\v' || first[i] == '\f')) ++i;
+        bool negative = false;
+        if (i < length && (first[i] == '+' || first[i] == '-')) {
+            negative = first[i] == '-';
+            ++i;
+        }
+        if (i == length || first[i] < '0' || first[i] > '9') return false;
+        const long long limit = negative ? 2147483648LL : 2147483647LL;
+        long long result = 0;
+        for (; i < length && first[i] >= '0' && first[i] <= '9'; ++i) {
+            result = result * 10 + (first[i] - '0');
+            if (result > limit) return false;
+        }
+        value = static_cast<int>(negative ? -result : result);
+        return true;
+    }
+
+private:
+    const char* first;
+    size_t length;
+
+    static bool is_space(char c) {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+    }
+};
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Columnar metadata table mirroring the library, one row per library track
+ *
+ * Each attribute lives in its own dense array (bpm, duration, format, quality),
+ * so filters stream through exactly the bytes they test instead of chasing
+ * AudioTrack pointers and calling virtual getters. Artists are interned into ids
+ * and stored per row as a CSR list plus a 64-bit signature (bit id % 64) that
+ * rejects most rows before the exact id check.
+ *
+ * Queries are evaluated 64 rows at a time: every predicate turns its column slice
+ * into a bitmask, masks are ANDed, and later predicates are skipped for blocks
+ * that are already empty. The per-block loops are branch-free so the compiler
+ * can vectorize them.
+ */
+class TrackTable {
+public:
+    enum Format : uint8_t { FORMAT_MP3 = 1, FORMAT_WAV = 2 };
+
+    /**
+     * @brief Conjunction of column predicates; unset predicates match everything
+     *
+     * Example: Query().format(FORMAT_WAV).bpm_between(124, 130).min_quality(90)
+     *                 .artist_contains("Ferry Corsten")
+     */
+    class Query {
+    public:
+        Query();
+
+        Query& format(Format value);
+        Query& bpm_between(int low, int high);           // inclusive
+        Query& duration_between(int low, int high);      // seconds, inclusive
+        Query& min_quality(double score);
+        Query& artist_contains(const std::string& text); // case-insensitive substring
+
+    private:
+        friend class TrackTable;
+        bool has_format;
+        uint8_t format_value;
+        int bpm_low, bpm_high;
+        int duration_low, duration_high;
+        float quality_low;
+        std::string artist_text;
+    };
+
+    TrackTable();
+
+    /**
+     * @brief Append a row; rows are numbered in insertion order from 0
+     */
+    size_t add(const std::vector<std::string>& artists, int bpm, int duration_seconds,
+               Format format, double quality);
+
+    /**
+     * @brief Overwrite an existing row in place (the row keeps its number)
+     *
+     * A longer artist list moves to the end of the artist column; the column is
+     * repacked once more than half of it is unused.
+     */
+    void set(size_t row, const std::vector<std::string>& artists, int bpm, int duration_seconds,
+             Format format, double quality);
+
+    /**
+     * @brief Drop every row from rows on
+     */
+    void truncate(size_t rows);
+
+    /**
+     * @brief Rows matching every predicate of the query, ascending
+     * @param limit Stop after this many matches (0 = no limit)
+     */
+    std::vector<size_t> select(const Query& query, size_t limit = 0) const;
+
+    size_t size() const { return bpm.size(); }
+    size_t artist_count() const { return artist_names.size(); }
+    void clear();
+
+private:
+    std::vector<int32_t> bpm;
+    std::vector<int32_t> duration;
+    std::vector<uint8_t> format;
+    std::vector<float> quality;
+    std::vector<uint64_t> artist_signature;
+    std::vector<uint32_t> artist_begins;   // row r owns artist_ids[begins[r], ends[r])
+    std::vector<uint32_t> artist_ends;
+    std::vector<uint32_t> artist_ids;
+    size_t unused_artist_ids;              // artist_ids entries outside every row's span
+
+    std::unordered_map<std::string, uint32_t> artist_lookup;
+    std::vector<std::string> artist_names;        // lower-cased, indexed by id
+
+    uint32_t intern_artist(const std::string& name);
+
+    // Write the row's artist span (reusing its old span when the list fits) and signature
+    void store_artists(size_t row, const std::vector<std::string>& artists);
+
+    // Repack artist_ids in row order once more than half of it is unused (as LibraryCatalog does)
+    void reclaim_artist_ids();
+};
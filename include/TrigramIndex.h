@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Trigram index for fuzzy, search-as-you-type lookups over library text
+ *
+ * Text is normalized (lower-case ASCII letters and digits, everything else a
+ * word break) and each word " word " is cut into overlapping trigrams. Every
+ * trigram owns a posting list of the rows containing it, ascending.
+ *
+ * A single-character typo destroys at most three trigrams, so a query of q
+ * trigrams matches a row when they share t >= q - 3 * max_typos of them (and
+ * never fewer than half). Search is a count over the query's posting lists:
+ * by the prefix-filtering argument only the q - t + 1 rarest lists can
+ * introduce a candidate, and the remaining, usually huge, lists only bump
+ * counts of rows already seen.
+ * The last query word is treated as a prefix (no closing trigram), so partial
+ * words typed so far still match in full.
+ */
+class TrigramIndex {
+public:
+    struct Match {
+        size_t row;
+        double score;  // fraction of the query's trigrams found in the row
+    };
+
+    TrigramIndex();
+
+    /**
+     * @brief Index a row's text; cheapest when rows are added in increasing order
+     */
+    void add(size_t row, const std::string& text);
+
+    /**
+     * @brief Un-index a row; text must be what the row was added with
+     */
+    void remove(size_t row, const std::string& text);
+
+    /**
+     * @brief Re-index a row whose text changed, touching only the trigrams that differ
+     *
+     * Trigrams shared by both versions (often ones in nearly every row, with huge
+     * posting lists) are left alone.
+     */
+    void update(size_t row, const std::string& old_text, const std::string& new_text);
+
+    /**
+     * @brief Best-matching rows for a partial or misspelled query
+     * @param query Raw user input
+     * @param limit Maximum number of matches (top-k)
+     * @param max_typos Misspelled characters to tolerate
+     * @return Matches ordered by score, then by shorter text, then by row
+     */
+    std::vector<Match> search(const std::string& query, size_t limit, size_t max_typos = 2) const;
+
+    /**
+     * @brief Lower-case alphanumerics separated by single spaces
+     */
+    static std::string normalize(const std::string& text);
+
+    size_t size() const { return gram_counts.size(); }
+    size_t trigram_count() const { return postings.size(); }
+    size_t memory_bytes() const;
+    void clear();
+
+private:
+    typedef std::vector<uint32_t> Postings;
+
+    std::unordered_map<uint32_t, Postings> postings;  // packed trigram -> rows
+    std::vector<uint16_t> gram_counts;                // distinct trigrams per row
+
+    // Distinct packed trigrams of the text; the last word stays open when prefix is set
+    static std::vector<uint32_t> trigrams(const std::string& text, bool prefix);
+
+    // Drop row from one trigram's posting list
+    void unlink(uint32_t gram, size_t row);
+};
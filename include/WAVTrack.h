@@ -25,7 +25,8 @@ public:
      * Constructor for WAVTrack
      */
     WAVTrack(const std::string& title, const std::vector<std::string>& artists, 
-             int duration, int bpm, int sample_rate, int bit_depth);
+             int duration, int bpm, int sample_rate, int bit_depth,
+             size_t waveform_samples = kDefaultWaveformSamples);
 
     // ========== TODO: IMPLEMENT VIRTUAL FUNCTIONS ==========
 
@@ -47,6 +48,11 @@ public:
      */
     double get_quality_score() const override;
 
+    /**
+     * Quality score of a WAV with these properties (what get_quality_score() returns)
+     */
+    static double quality_for(int sample_rate, int bit_depth);
+
     /**
      * TODO: Implement clone function
      * HINT: Return a unique_ptr to a new WAVTrack with same properties
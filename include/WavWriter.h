@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+/**
+ * @brief Streaming writer for 16-bit PCM WAV files
+ *
+ * The header is written with placeholder sizes on open() and patched on close(),
+ * so callers can stream arbitrarily long renders in fixed-size chunks without
+ * holding the audio in memory. Files are capped at the 4 GiB RIFF limit.
+ */
+class WavWriter {
+public:
+    WavWriter();
+    ~WavWriter();
+
+    WavWriter(const WavWriter&) = delete;
+    WavWriter& operator=(const WavWriter&) = delete;
+
+    /**
+     * @brief Create (truncate) the output file and write a provisional header
+     * @return true if the file is ready for writing
+     */
+    bool open(const std::string& path, int sample_rate, int channels);
+
+    /**
+     * @brief Append interleaved samples
+     * @param samples Interleaved 16-bit samples (frames * channels values)
+     * @param sample_count Number of int16 values in samples
+     * @return false on I/O error or when the RIFF size limit would be exceeded
+     */
+    bool write(const int16_t* samples, size_t sample_count);
+
+    /**
+     * @brief Patch the header sizes and close the file
+     * @return true if the finished file is valid
+     */
+    bool close();
+
+    bool is_open() const { return file.is_open(); }
+    int get_sample_rate() const { return sample_rate; }
+    int get_channels() const { return channels; }
+    uint64_t frames_written() const { return channels ? data_bytes / (2u * channels) : 0; }
+
+private:
+    std::ofstream file;
+    std::string path;
+    uint64_t data_bytes;
+    int sample_rate;
+    int channels;
+
+    void write_header(uint32_t data_size);
+};
@@ -0,0 +1,92 @@
+#include "ArtistIndex.h"
+#include <algorithm>
+#include <functional>
+#include <queue>
+
+ArtistIndex::ArtistIndex() : lists(), none() {}
+
+void ArtistIndex::add(uint32_t artist_id, size_t row) {
+    if (artist_id >= lists.size()) lists.resize(artist_id + 1);
+    Postings& list = lists[artist_id];
+    // A track that credits the same artist twice gets one posting
+    if (list.empty() || list.back() < row) {
+        list.push_back(static_cast<uint32_t>(row));
+        return;
+    }
+    auto pos = std::lower_bound(list.begin(), list.end(), static_cast<uint32_t>(row));
+    if (*pos != row) list.insert(pos, static_cast<uint32_t>(row));
+}
+
+void ArtistIndex::remove(uint32_t artist_id, size_t row) {
+    if (artist_id >= lists.size()) return;
+    Postings& list = lists[artist_id];
+    auto pos = std::lower_bound(list.begin(), list.end(), static_cast<uint32_t>(row));
+    if (pos != list.end() && *pos == row) list.erase(pos);
+}
+
+const ArtistIndex::Postings& ArtistIndex::postings(uint32_t artist_id) const {
+    return artist_id < lists.size() ? lists[artist_id] : none;
+}
+
+void ArtistIndex::clear() {
+    lists.clear();
+}
+
+size_t ArtistIndex::gallop(const Postings& list, size_t from, uint32_t target) {
+    size_t low = from;
+    size_t high = from;
+    size_t step = 1;
+    while (high < list.size() && list[high] < target) {
+        low = high + 1;
+        high = from + step;
+        step *= 2;
+    }
+    high = std::min(high, list.size());
+    return static_cast<size_t>(std::lower_bound(list.begin() + low, list.begin() + high, target) - list.begin());
+}
+
+std::vector<size_t> ArtistIndex::match_all(const std::vector<uint32_t>& artist_ids) const {
+    std::vector<size_t> rows;
+    if (artist_ids.empty()) return rows;
+
+    std::vector<const Postings*> sorted;
+    for (uint32_t id : artist_ids) sorted.push_back(&postings(id));
+    std::sort(sorted.begin(), sorted.end(),
+              [](const Postings* a, const Postings* b) { return a->size() < b->size(); });
+
+    // Walk the shortest list; each candidate gallops forward in the others
+    std::vector<size_t> cursor(sorted.size(), 0);
+    for (uint32_t row : *sorted[0]) {
+        bool everywhere = true;
+        for (size_t k = 1; k < sorted.size() && everywhere; ++k) {
+            cursor[k] = gallop(*sorted[k], cursor[k], row);
+            if (cursor[k] == sorted[k]->size()) return rows;
+            everywhere = (*sorted[k])[cursor[k]] == row;
+        }
+        if (everywhere) rows.push_back(row);
+    }
+    return rows;
+}
+
+std::vector<size_t> ArtistIndex::match_any(const std::vector<uint32_t>& artist_ids) const {
+    typedef std::pair<uint32_t, size_t> Head;  // (row, list)
+    std::vector<size_t> rows;
+    std::vector<const Postings*> sources;
+    std::priority_queue<Head, std::vector<Head>, std::greater<Head>> heads;
+    for (uint32_t id : artist_ids) {
+        const Postings& list = postings(id);
+        if (list.empty()) continue;
+        heads.push(Head(list[0], sources.size()));
+        sources.push_back(&list);
+    }
+
+    std::vector<size_t> cursor(sources.size(), 0);
+    while (!heads.empty()) {
+        Head head = heads.top();
+        heads.pop();
+        if (rows.empty() || rows.back() != head.first) rows.push_back(head.first);
+        const Postings& list = *sources[head.second];
+        if (++cursor[head.second] < list.size()) heads.push(Head(list[cursor[head.second]], head.second));
+    }
+    return rows;
+}
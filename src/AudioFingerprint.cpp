@@ -0,0 +1,73 @@
+#include "AudioFingerprint.h"
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+const size_t AudioFingerprint::kBits;
+
+namespace {
+
+// Energy policies are functors rather than function pointers so the frame loop inlines them
+struct ScalarEnergy {
+    double operator()(const double* samples, size_t count) const {
+        double sum = 0.0;
+        for (size_t i = 0; i < count; ++i) sum += samples[i] * samples[i];
+        return sum;
+    }
+};
+
+#ifdef __SSE2__
+// Two samples per multiply-add; two accumulators so consecutive adds do not wait on each other
+struct SSE2Energy {
+    double operator()(const double* samples, size_t count) const {
+        __m128d even = _mm_setzero_pd();
+        __m128d odd = _mm_setzero_pd();
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            const __m128d a = _mm_loadu_pd(samples + i);
+            const __m128d b = _mm_loadu_pd(samples + i + 2);
+            even = _mm_add_pd(even, _mm_mul_pd(a, a));
+            odd = _mm_add_pd(odd, _mm_mul_pd(b, b));
+        }
+        if (i + 2 <= count) {
+            const __m128d a = _mm_loadu_pd(samples + i);
+            even = _mm_add_pd(even, _mm_mul_pd(a, a));
+            i += 2;
+        }
+        even = _mm_add_pd(even, odd);
+        const __m128d high = _mm_unpackhi_pd(even, even);
+        double sum = _mm_cvtsd_f64(_mm_add_sd(even, high));
+        if (i < count) sum += samples[i] * samples[i];
+        return sum;
+    }
+};
+#endif
+
+template <typename Energy>
+AudioFingerprint fingerprint(const double* samples, size_t count, Energy energy) {
+    AudioFingerprint print;
+    const size_t frame = count / (AudioFingerprint::kBits + 1);
+    if (frame < 2) return print;
+    double previous = energy(samples, frame);
+    for (size_t bit = 0; bit < AudioFingerprint::kBits; ++bit) {
+        const double current = energy(samples + (bit + 1) * frame, frame);
+        // Branch-free: the comparison is a coin flip on real audio
+        print.bits[bit / 64] |= static_cast<uint64_t>(current > previous) << (bit % 64);
+        previous = current;
+    }
+    return print;
+}
+
+}  // namespace
+
+AudioFingerprint AudioFingerprint::compute(const double* samples, size_t count) {
+#ifdef __SSE2__
+    return fingerprint(samples, count, SSE2Energy());
+#else
+    return fingerprint(samples, count, ScalarEnergy());
+#endif
+}
+
+AudioFingerprint AudioFingerprint::compute_scalar(const double* samples, size_t count) {
+    return fingerprint(samples, count, ScalarEnergy());
+}
@@ -2,21 +2,44 @@
 #include <iostream>
 #include <cstring>
 #include <random>
+#include <cctype>
+
+namespace {
+
+// splitmix64: seeding is a single store, unlike mt19937's 2.5 KB state, and tracks are built often
+struct WaveformGenerator {
+    typedef uint64_t result_type;
+    uint64_t state;
+
+    explicit WaveformGenerator(uint64_t seed) : state(seed) {}
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return ~uint64_t(0); }
+    result_type operator()() {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+};
+
+}  // namespace
+
+const size_t AudioTrack::kDefaultWaveformSamples;
 
 AudioTrack::AudioTrack(const std::string& title, const std::vector<std::string>& artists, 
                       int duration, int bpm, size_t waveform_samples)
+    : AudioTrack(title, artists, duration, bpm, waveform_samples, DeferFingerprint()) {
+    fingerprint = AudioFingerprint::compute(waveform_data, waveform_size);
+}
+
+AudioTrack::AudioTrack(const std::string& title, const std::vector<std::string>& artists,
+                      int duration, int bpm, size_t waveform_samples, DeferFingerprint)
     : title(title), artists(artists), duration_seconds(duration), bpm(bpm), waveform_data(nullptr),
-      waveform_size(waveform_samples) {
+      waveform_size(waveform_samples), fingerprint(), log_stream(&std::cout) {
 
     // Generate some dummy waveform data for testing
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_real_distribution<double> dis(-1.0, 1.0);
-
     waveform_data = new double[waveform_size];
-    for (size_t i = 0; i < waveform_size; ++i) {
-        waveform_data[i] = dis(gen);
-    }
+    render_waveform(title, artists, waveform_data, waveform_size);
     #ifdef DEBUG
     std::cout << "AudioTrack created: " << title << " by " << std::endl;
     for (const auto& artist : artists) {
@@ -37,7 +60,7 @@ AudioTrack::~AudioTrack() {
     delete [] waveform_data;
 }
 
-AudioTrack::AudioTrack(const AudioTrack& other): title(other.title),artists(other.artists),duration_seconds(other.duration_seconds),bpm(other.bpm),waveform_data(new double[other.waveform_size]), waveform_size(other.waveform_size){
+AudioTrack::AudioTrack(const AudioTrack& other): title(other.title),artists(other.artists),duration_seconds(other.duration_seconds),bpm(other.bpm),waveform_data(new double[other.waveform_size]), waveform_size(other.waveform_size), fingerprint(other.fingerprint), log_stream(&std::cout){
     // TODO: Implement the copy constructor
     #ifdef DEBUG
     std::cout << "AudioTrack copy constructor called for: " << other.title << std::endl;
@@ -61,6 +84,7 @@ AudioTrack& AudioTrack::operator=(const AudioTrack& other) {
         duration_seconds = other.duration_seconds;
         bpm = other.bpm;
         waveform_size = other.waveform_size;
+        fingerprint = other.fingerprint;
         waveform_data = new double[waveform_size];
         for(size_t i=0;i<waveform_size;i++){
             waveform_data[i]=other.waveform_data[i];  
@@ -69,7 +93,7 @@ AudioTrack& AudioTrack::operator=(const AudioTrack& other) {
     return *this;
 }
 
-AudioTrack::AudioTrack(AudioTrack&& other) noexcept : title(other.title), artists(other.artists),duration_seconds(other.duration_seconds), bpm(other.bpm), waveform_data(other.waveform_data),waveform_size(other.waveform_size) {
+AudioTrack::AudioTrack(AudioTrack&& other) noexcept : title(other.title), artists(other.artists),duration_seconds(other.duration_seconds), bpm(other.bpm), waveform_data(other.waveform_data),waveform_size(other.waveform_size), fingerprint(other.fingerprint), log_stream(&std::cout) {
     // TODO: Implement the move constructor
     #ifdef DEBUG
     std::cout << "AudioTrack move constructor called for: " << other.title << std::endl;
@@ -94,6 +118,7 @@ AudioTrack& AudioTrack::operator=(AudioTrack&& other) noexcept {
         bpm=other.bpm;
         waveform_data=other.waveform_data;
         waveform_size=other.waveform_size;
+        fingerprint=other.fingerprint;
         other.waveform_data = nullptr;
     }
     
@@ -104,6 +129,38 @@ void AudioTrack::set_bpm(int newbpm){
     bpm=newbpm;
 }
 
+void AudioTrack::set_log_stream(std::ostream* out) {
+    log_stream = out ? out : &std::cout;
+}
+
+void AudioTrack::render_waveform(const std::string& title, const std::vector<std::string>& artists,
+                                 double* samples, size_t count) {
+    // Seed: 64-bit FNV-1a over the lower-cased letters and digits of the title outside
+    // brackets, then of the lead artist (bytes >= 0x80 are kept as they are)
+    uint64_t seed = 14695981039346656037ull;
+    auto mix = [&seed](const std::string& text, bool skip_brackets) {
+        int depth = 0;
+        for (unsigned char c : text) {
+            if (skip_brackets && (c == '(' || c == '[')) ++depth;
+            else if (skip_brackets && (c == ')' || c == ']') && depth > 0) --depth;
+            else if (depth == 0 && (std::isalnum(c) || c >= 0x80)) {
+                seed ^= static_cast<unsigned char>(std::tolower(c));
+                seed *= 1099511628211ull;
+            }
+        }
+    };
+    mix(title, true);
+    seed ^= '|';
+    seed *= 1099511628211ull;
+    if (!artists.empty()) mix(artists[0], false);
+
+    WaveformGenerator gen(seed);
+    std::uniform_real_distribution<double> dis(-1.0, 1.0);
+    for (size_t i = 0; i < count; ++i) {
+        samples[i] = dis(gen);
+    }
+}
+
 void AudioTrack::get_waveform_copy(double* buffer, size_t buffer_size) const {
     if (buffer && waveform_data && buffer_size <= waveform_size) {
         std::memcpy(buffer, waveform_data, buffer_size * sizeof(double));
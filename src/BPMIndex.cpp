@@ -0,0 +1,60 @@
+#include "BPMIndex.h"
+#include <queue>
+
+BPMIndex::BPMIndex() : buckets(), entry_count(0) {}
+
+bool BPMIndex::Better::operator()(const Entry& a, const Entry& b) const {
+    if (a.first != b.first) return a.first > b.first;
+    return a.second < b.second;
+}
+
+void BPMIndex::add(size_t row, int bpm, double quality) {
+    if (buckets[bpm].insert(Entry(quality, row)).second) ++entry_count;
+}
+
+bool BPMIndex::remove(size_t row, int bpm, double quality) {
+    auto bucket = buckets.find(bpm);
+    if (bucket == buckets.end() || bucket->second.erase(Entry(quality, row)) == 0) return false;
+    if (bucket->second.empty()) buckets.erase(bucket);
+    --entry_count;
+    return true;
+}
+
+std::vector<size_t> BPMIndex::query(int bpm, int tolerance, size_t limit) const {
+    std::vector<size_t> rows;
+    if (tolerance < 0) return rows;
+
+    // Cursor into one bucket; the heap always yields the best remaining entry across buckets
+    struct Cursor {
+        Bucket::const_iterator pos;
+        Bucket::const_iterator end;
+    };
+    auto worse = [](const Cursor& a, const Cursor& b) {
+        if (a.pos->first != b.pos->first) return a.pos->first < b.pos->first;
+        return a.pos->second > b.pos->second;
+    };
+    std::priority_queue<Cursor, std::vector<Cursor>, decltype(worse)> heap(worse);
+
+    auto last = buckets.upper_bound(bpm + tolerance);
+    for (auto it = buckets.lower_bound(bpm - tolerance); it != last; ++it) {
+        if (!it->second.empty()) {
+            Cursor cursor = {it->second.begin(), it->second.end()};
+            heap.push(cursor);
+        }
+    }
+
+    while (!heap.empty() && (limit == 0 || rows.size() < limit)) {
+        Cursor top = heap.top();
+        heap.pop();
+        rows.push_back(top.pos->second);
+        if (++top.pos != top.end) {
+            heap.push(top);
+        }
+    }
+    return rows;
+}
+
+void BPMIndex::clear() {
+    buckets.clear();
+    entry_count = 0;
+}
@@ -0,0 +1,1526 @@
+#include "BenchmarkRunner.h"
+#include "SetPlanner.h"
+#include "BPMIndex.h"
+#include "Playlist.h"
+#include "DJLibraryService.h"
+#include "PlaylistReader.h"
+#include "SessionFileParser.h"
+#include "ConfigKeys.h"
+#include "ConfigWatcher.h"
+#include "TextScan.h"
+#include "TrackTable.h"
+#include "LibraryCatalog.h"
+#include "ArtistIndex.h"
+#include "TrigramIndex.h"
+#include "PagedCatalog.h"
+#include "FingerprintIndex.h"
+#include "MP3Track.h"
+#include "WAVTrack.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <mutex>
+#include <thread>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+double ms_since(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// glibc malloc chunk for a request: 8-byte header, 16-byte alignment, 32-byte minimum
+size_t heap_bytes(size_t request) {
+    size_t chunk = (request + 8 + 15) & ~static_cast<size_t>(15);
+    return chunk < 32 ? 32 : chunk;
+}
+
+// Heap owned by a std::string beyond the object itself (nothing while it fits the SSO buffer)
+size_t string_heap_bytes(const std::string& text) {
+    return text.size() < sizeof(std::string) / 2 ? 0 : heap_bytes(text.size() + 1);
+}
+
+// Time-stamp counter (constant-rate reference cycles), or 0 where there is none
+uint64_t tsc_now() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+size_t arg_or(const std::vector<std::string>& args, size_t pos, size_t fallback) {
+    if (pos >= args.size()) return fallback;
+    try {
+        return static_cast<size_t>(std::stoull(args[pos]));
+    } catch (const std::exception&) {
+        return fallback;
+    }
+}
+
+} // namespace
+
+int BenchmarkRunner::run(const std::vector<std::string>& args) {
+    const std::string name = args.empty() ? "all" : args[0];
+    const std::vector<std::string> rest(args.empty() ? args.begin() : args.begin() + 1, args.end());
+
+    bool known = false;
+    if (name == "planner" || name == "all") { bench_set_planner(rest); known = true; }
+    if (name == "bpm_index" || name == "all") { bench_bpm_index(rest); known = true; }
+    if (name == "playlist" || name == "all") { bench_playlist(rest); known = true; }
+    if (name == "playlist_import" || name == "all") { bench_playlist_import(rest); known = true; }
+    if (name == "track_table" || name == "all") { bench_track_table(rest); known = true; }
+    if (name == "catalog" || name == "all") { bench_catalog(rest); known = true; }
+    if (name == "artist_index" || name == "all") { bench_artist_index(rest); known = true; }
+    if (name == "fuzzy_search" || name == "all") { bench_fuzzy_search(rest); known = true; }
+    if (name == "snapshot" || name == "all") { bench_snapshot(rest); known = true; }
+    if (name == "reload" || name == "all") { bench_reload(rest); known = true; }
+    if (name == "paged_catalog" || name == "all") { bench_paged_catalog(rest); known = true; }
+    if (name == "fingerprint" || name == "all") { bench_fingerprint(rest); known = true; }
+    if (name == "versions" || name == "all") { bench_versions(rest); known = true; }
+    if (name == "config_parse" || name == "all") { bench_config_parse(rest); known = true; }
+    if (name == "config_keys" || name == "all") { bench_config_keys(rest); known = true; }
+    if (name == "config_watch" || name == "all") { bench_config_watch(rest); known = true; }
+    if (name == "text_scan" || name == "all") { bench_text_scan(rest); known = true; }
+    if (!known) {
+        std::cout << "[ERROR] Unknown benchmark: " << name << std::endl;
+        std::cout << "Available: planner, bpm_index, playlist, playlist_import, track_table, catalog, artist_index, fuzzy_search, snapshot, reload, paged_catalog, fingerprint, versions, config_parse, config_keys, config_watch, text_scan, all" << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+void BenchmarkRunner::bench_set_planner(const std::vector<std::string>& args) {
+    const size_t crate_size = arg_or(args, 0, 1000);
+    std::cout << "\n=== Benchmark: SetPlanner (" << crate_size << " tracks) ===" << std::endl;
+
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> bpm(118, 142);
+    std::uniform_int_distribution<size_t> pick(0, crate_size - 1);
+    std::vector<SetPlanner::Stop> stops;
+    stops.reserve(crate_size);
+    for (size_t i = 0; i < crate_size; ++i) {
+        // Roughly one in twenty positions repeats an earlier track, like 42,42 in real playlists
+        if (i > 0 && pick(gen) % 20 == 0) {
+            stops.push_back(stops[pick(gen) % i]);
+            continue;
+        }
+        std::ostringstream title;
+        title << "Track " << i;
+        stops.push_back(SetPlanner::Stop(title.str(), bpm(gen)));
+    }
+
+    SetPlanner::Result result = SetPlanner().plan(stops);
+    std::cout << "Threads: " << result.threads_used << std::endl;
+    std::cout << "Cost before: " << result.cost_before << std::endl;
+    std::cout << "Cost after: " << result.cost_after << std::endl;
+    std::cout << "Planning time: " << result.elapsed_ms << " ms" << std::endl;
+}
+
+void BenchmarkRunner::bench_bpm_index(const std::vector<std::string>& args) {
+    const size_t track_count = arg_or(args, 0, 1000000);
+    const size_t query_count = arg_or(args, 1, 10000);
+    const int tolerance = 6;
+    const size_t limit = 20;
+    std::cout << "\n=== Benchmark: BPMIndex (" << track_count << " tracks, "
+              << query_count << " queries) ===" << std::endl;
+
+    std::mt19937 gen(7);
+    std::uniform_int_distribution<int> bpm(90, 180);
+    std::uniform_real_distribution<double> quality(40.0, 100.0);
+    std::vector<int> bpms(track_count);
+    std::vector<double> scores(track_count);
+    for (size_t i = 0; i < track_count; ++i) {
+        bpms[i] = bpm(gen);
+        scores[i] = quality(gen);
+    }
+
+    Clock::time_point start = Clock::now();
+    BPMIndex index;
+    for (size_t i = 0; i < track_count; ++i) index.add(i, bpms[i], scores[i]);
+    std::cout << "Incremental build: " << ms_since(start) << " ms" << std::endl;
+
+    std::vector<int> targets(query_count);
+    for (size_t q = 0; q < query_count; ++q) targets[q] = bpm(gen);
+
+    size_t checksum = 0;
+    start = Clock::now();
+    for (size_t q = 0; q < query_count; ++q) {
+        checksum += index.query(targets[q], tolerance, limit).size();
+    }
+    double indexed_ms = ms_since(start);
+
+    // Baseline: walk every track, keep the in-tolerance ones, sort by quality
+    const size_t scan_queries = std::min<size_t>(query_count, 100);
+    start = Clock::now();
+    for (size_t q = 0; q < scan_queries; ++q) {
+        std::vector<std::pair<double, size_t>> hits;
+        for (size_t i = 0; i < track_count; ++i) {
+            if (std::abs(bpms[i] - targets[q]) <= tolerance) hits.push_back(std::make_pair(-scores[i], i));
+        }
+        size_t keep = std::min(limit, hits.size());
+        std::partial_sort(hits.begin(), hits.begin() + keep, hits.end());
+        checksum += keep;
+    }
+    double scan_ms = ms_since(start);
+
+    std::cout << "Indexed query (top " << limit << ", +/-" << tolerance << " BPM): "
+              << (indexed_ms * 1000.0 / query_count) << " us/query" << std::endl;
+    std::cout << "Linear scan query: " << (scan_ms * 1000.0 / scan_queries) << " us/query" << std::endl;
+    std::cout << "(checksum " << checksum << ")" << std::endl;
+}
+
+void BenchmarkRunner::bench_playlist(const std::vector<std::string>& args) {
+    const size_t track_count = arg_or(args, 0, 1000000);
+    std::cout << "\n=== Benchmark: Playlist (" << track_count << " tracks) ===" << std::endl;
+
+    // Tracks carry a single waveform sample so a million of them fit comfortably in memory
+    std::vector<AudioTrack*> tracks;
+    tracks.reserve(track_count);
+    std::cout.setstate(std::ios::badbit);
+    for (size_t i = 0; i < track_count; ++i) {
+        std::ostringstream title;
+        title << "Track " << i;
+        if (i % 2 == 0) {
+            tracks.push_back(new MP3Track(title.str(), {"Artist"}, 180 + static_cast<int>(i % 120), 124, 320, true, 1));
+        } else {
+            tracks.push_back(new WAVTrack(title.str(), {"Artist"}, 180 + static_cast<int>(i % 120), 126, 44100, 16, 1));
+        }
+    }
+    std::cout.clear();
+
+    // Baseline: the old prepend-only singly linked list, reversed to recover play order
+    struct Node {
+        AudioTrack* track;
+        Node* next;
+    };
+    Clock::time_point start = Clock::now();
+    Node* head = nullptr;
+    for (AudioTrack* track : tracks) head = new Node{track, head};
+    double list_append_ms = ms_since(start);
+
+    start = Clock::now();
+    long long list_duration = 0;
+    for (Node* node = head; node; node = node->next) list_duration += node->track->get_duration();
+    double list_duration_ms = ms_since(start);
+
+    start = Clock::now();
+    std::vector<AudioTrack*> walked;
+    for (Node* node = head; node; node = node->next) walked.push_back(node->track);
+    std::vector<std::string> list_titles;
+    list_titles.reserve(walked.size());
+    for (auto it = walked.rbegin(); it != walked.rend(); ++it) list_titles.push_back((*it)->get_title());
+    double list_titles_ms = ms_since(start);
+
+    while (head) {
+        Node* next = head->next;
+        delete head;
+        head = next;
+    }
+
+    size_t checksum = list_titles.size() + static_cast<size_t>(list_duration);
+    std::cout.setstate(std::ios::badbit);
+    double append_ms = 0;
+    double display_ms = 0;
+    {
+        Playlist playlist("Benchmark");
+        start = Clock::now();
+        for (AudioTrack* track : tracks) playlist.add_track(track);
+        append_ms = ms_since(start);
+        std::cout.clear();
+
+        start = Clock::now();
+        checksum += static_cast<size_t>(playlist.get_total_duration());
+        double duration_ms = ms_since(start);
+
+        start = Clock::now();
+        checksum += playlist.getTitles().size();
+        double titles_ms = ms_since(start);
+
+        // Derived playlists: copy, then edit the copy; the original must stay untouched
+        start = Clock::now();
+        Playlist derived(playlist);
+        double copy_us = ms_since(start) * 1000.0;
+        start = Clock::now();
+        derived.set_bpm_override(track_count / 2, 128);
+        double edit_us = ms_since(start) * 1000.0;
+        checksum += static_cast<size_t>(derived.get_entry_bpm(track_count / 2) - playlist.get_entry_bpm(track_count / 2));
+        start = Clock::now();
+        std::vector<AudioTrack*> flat_copy(tracks);
+        double flat_copy_ms = ms_since(start);
+        checksum += flat_copy.size();
+
+        std::cout.setstate(std::ios::badbit);
+        start = Clock::now();
+        playlist.display();
+        display_ms = ms_since(start);
+        std::cout.clear();
+
+        // Random windows: cached node aggregates vs. walking the entries
+        std::mt19937 gen(11);
+        std::uniform_int_distribution<size_t> pick(0, track_count - 1);
+        const size_t window_queries = 10000;
+        start = Clock::now();
+        for (size_t q = 0; q < window_queries; ++q) {
+            size_t first = pick(gen);
+            Playlist::Stats window = playlist.get_window_stats(first, track_count - first);
+            checksum += static_cast<size_t>(window.max_bpm - window.min_bpm + window.mp3_count);
+        }
+        double window_us = ms_since(start) * 1000.0 / window_queries;
+
+        const size_t scan_windows = 20;
+        std::vector<AudioTrack*> flat = playlist.getTracks();
+        start = Clock::now();
+        for (size_t q = 0; q < scan_windows; ++q) {
+            size_t first = pick(gen);
+            long long duration = 0;
+            double quality = 0;
+            for (size_t i = first; i < flat.size(); ++i) {
+                duration += flat[i]->get_duration();
+                quality += flat[i]->get_quality_score();
+            }
+            checksum += static_cast<size_t>(duration) + static_cast<size_t>(quality > 0);
+        }
+        double window_scan_us = ms_since(start) * 1000.0 / scan_windows;
+
+        // The title index is built by the first lookup
+        start = Clock::now();
+        checksum += playlist.find_track("Track 0") ? 1 : 0;
+        double index_ms = ms_since(start);
+
+        // Look up and then remove every 10th title, the way a play-through walks the playlist
+        const size_t lookups = (track_count + 9) / 10;
+        start = Clock::now();
+        for (size_t i = 0; i < track_count; i += 10) {
+            std::ostringstream title;
+            title << "Track " << i;
+            checksum += playlist.find_track(title.str()) ? 1 : 0;
+        }
+        double lookup_ms = ms_since(start);
+
+        // Edits of a copy once the index exists: the copy shares the index and edits its own path
+        const size_t copy_edits = 100;
+        std::cout.setstate(std::ios::badbit);
+        start = Clock::now();
+        for (size_t i = 0; i < copy_edits; ++i) {
+            Playlist edited(playlist);
+            edited.remove_track("Track " + std::to_string(2 * i + 1));
+            edited.add_track(tracks[2 * i + 1]);
+            checksum += edited.find_track("Track " + std::to_string(2 * i + 1)) ? 1 : 0;
+        }
+        double copy_edit_us = ms_since(start) * 1000.0 / copy_edits;
+        std::cout.clear();
+
+        std::cout.setstate(std::ios::badbit);
+        start = Clock::now();
+        for (size_t i = 0; i < track_count; i += 10) {
+            std::ostringstream title;
+            title << "Track " << i;
+            playlist.remove_track(title.str());
+        }
+        double remove_ms = ms_since(start);
+        std::cout.clear();
+
+        std::cout << "Append: " << append_ms << " ms (linked list " << list_append_ms << " ms)" << std::endl;
+        std::cout << "Total duration scan: " << duration_ms << " ms (linked list " << list_duration_ms << " ms)" << std::endl;
+        std::cout << "Title extraction: " << titles_ms << " ms (linked list + reverse " << list_titles_ms << " ms)" << std::endl;
+        std::cout << "Display (output discarded): " << display_ms << " ms" << std::endl;
+        std::cout << "Copy: " << copy_us << " us (flat vector copy " << flat_copy_ms << " ms)" << std::endl;
+        std::cout << "Edit one entry of the copy: " << edit_us << " us" << std::endl;
+        std::cout << "Window stats: " << window_us << " us/query (linear scan " << window_scan_us << " us/query)" << std::endl;
+        std::cout << "Title index build (first lookup): " << index_ms << " ms" << std::endl;
+        std::cout << "find_track: " << (lookup_ms * 1000.0 / lookups) << " us/lookup" << std::endl;
+        std::cout << "remove_track: " << (remove_ms * 1000.0 / lookups) << " us/removal" << std::endl;
+        std::cout << "Copy, then remove + append + find_track on the copy: " << copy_edit_us << " us" << std::endl;
+        std::cout.setstate(std::ios::badbit);
+    }
+    // Playlists only reference tracks; the benchmark owns them
+    for (AudioTrack* track : tracks) delete track;
+    tracks.clear();
+
+    // A 10K-entry playlist over a 1K-track library, every index repeated like 42,42
+    std::vector<SessionConfig::TrackInfo> infos(1000);
+    for (size_t i = 0; i < infos.size(); ++i) {
+        infos[i].type = (i % 2 == 0) ? "MP3" : "WAV";
+        infos[i].title = "Library " + std::to_string(i);
+        infos[i].artists.push_back("Artist");
+        infos[i].duration_seconds = 200;
+        infos[i].bpm = 124;
+        infos[i].extra_param1 = (i % 2 == 0) ? 320 : 44100;
+        infos[i].extra_param2 = (i % 2 == 0) ? 1 : 16;
+    }
+    std::vector<int> indices;
+    for (int i = 0; i < 10000; ++i) indices.push_back(1 + (i / 2) % 1000);
+
+    std::cout.setstate(std::ios::badbit);
+    double playlist_load_ms = 0;
+    {
+        DJLibraryService library;
+        library.buildLibrary(infos);
+        start = Clock::now();
+        library.loadPlaylistFromIndices("Benchmark", indices);
+        playlist_load_ms = ms_since(start);
+        checksum += static_cast<size_t>(library.getPlaylist().get_track_count());
+    }
+    std::cout.clear();
+    std::cout << "loadPlaylistFromIndices (10K entries over 1K tracks): " << playlist_load_ms << " ms" << std::endl;
+    std::cout << "(checksum " << checksum << ")" << std::endl;
+}
+
+void BenchmarkRunner::bench_playlist_import(const std::vector<std::string>& args) {
+    const size_t line_count = arg_or(args, 0, 500000);
+    const std::string path = "bench_import.playlist";
+    std::cout << "\n=== Benchmark: Playlist import (" << line_count << " lines) ===" << std::endl;
+
+    // One line in four introduces a new track; the rest repeat earlier ones, like real exports
+    {
+        std::ofstream out(path);
+        out << "# Generated import benchmark\n";
+        for (size_t i = 0; i < line_count; ++i) {
+            size_t id = (i % 4 == 0) ? i : (i * 7919) % (i - i % 4 + 1);
+            if (id % 2 == 0) {
+                out << "MP3,Track " << id << ",Artist " << id % 500 << "," << 180 + id % 120 << ","
+                    << 110 + id % 40 << ",320,1\n";
+            } else {
+                out << "WAV,Track " << id << ",Artist " << id % 500 << "," << 180 + id % 120 << ","
+                    << 110 + id % 40 << ",44100,16\n";
+            }
+        }
+    }
+
+    Clock::time_point start = Clock::now();
+    size_t checksum = 0;
+    long streamed = PlaylistReader::for_each(path, [&checksum](const PlaylistReader::Record& record) {
+        checksum += static_cast<size_t>(record.bpm) + record.title.size();
+    });
+    double stream_ms = ms_since(start);
+
+    std::cout.setstate(std::ios::badbit);
+    start = Clock::now();
+    PlaylistData data;
+    SessionFileParser::parse_playlist_file(path, data);
+    double materialize_ms = ms_since(start);
+    checksum += data.tracks.size();
+    data.tracks.clear();
+    data.tracks.shrink_to_fit();
+
+    double import_ms = 0;
+    long imported = 0;
+    {
+        DJLibraryService library;
+        start = Clock::now();
+        imported = library.importPlaylistFile(path);
+        import_ms = ms_since(start);
+        checksum += static_cast<size_t>(library.getPlaylist().get_total_duration());
+    }
+    std::cout.clear();
+    std::remove(path.c_str());
+
+    std::cout << "PlaylistReader stream: " << stream_ms << " ms (" << (streamed / (stream_ms / 1000.0)) << " lines/s)" << std::endl;
+    std::cout << "parse_playlist_file (materialized): " << materialize_ms << " ms ("
+              << (line_count / (materialize_ms / 1000.0)) << " lines/s)" << std::endl;
+    std::cout << "importPlaylistFile into library + playlist: " << import_ms << " ms ("
+              << (imported / (import_ms / 1000.0)) << " lines/s)" << std::endl;
+    std::cout << "(checksum " << checksum << ")" << std::endl;
+}
+
+void BenchmarkRunner::bench_track_table(const std::vector<std::string>& args) {
+    const size_t track_count = arg_or(args, 0, 1000000);
+    std::cout << "\n=== Benchmark: TrackTable (" << track_count << " tracks) ===" << std::endl;
+
+    std::mt19937 gen(5);
+    std::uniform_int_distribution<int> bpm(90, 180);
+    std::uniform_int_distribution<int> duration(150, 600);
+    std::uniform_int_distribution<int> artist(0, 4999);
+    std::uniform_int_distribution<int> coin(0, 3);
+    const int bitrates[] = {128, 192, 256, 320};
+    const int bit_depths[] = {16, 16, 24, 24};
+
+    std::vector<AudioTrack*> tracks;
+    tracks.reserve(track_count);
+    TrackTable table;
+    std::cout.setstate(std::ios::badbit);
+    Clock::time_point start = Clock::now();
+    double table_build_ms = 0;
+    for (size_t i = 0; i < track_count; ++i) {
+        std::vector<std::string> artists;
+        int a = artist(gen);
+        artists.push_back(a == 0 ? "Ferry Corsten" : "Artist " + std::to_string(a));
+        if (coin(gen) == 0) artists.push_back("Artist " + std::to_string(artist(gen)));
+        AudioTrack* track = nullptr;
+        if (coin(gen) < 2) {
+            track = new MP3Track("Track", artists, duration(gen), bpm(gen), bitrates[coin(gen)], true, 1);
+        } else {
+            track = new WAVTrack("Track", artists, duration(gen), bpm(gen), 44100, bit_depths[coin(gen)], 1);
+        }
+        tracks.push_back(track);
+
+        Clock::time_point row_start = Clock::now();
+        table.add(artists, track->get_bpm(), track->get_duration(),
+                  dynamic_cast<WAVTrack*>(track) ? TrackTable::FORMAT_WAV : TrackTable::FORMAT_MP3,
+                  track->get_quality_score());
+        table_build_ms += ms_since(row_start);
+    }
+    std::cout.clear();
+    std::cout << "Built " << tracks.size() << " tracks in " << ms_since(start) << " ms (table rows "
+              << table_build_ms << " ms, " << table.artist_count() << " artists)" << std::endl;
+
+    struct Case {
+        const char* label;
+        TrackTable::Query query;
+        bool wav;
+        int bpm_low, bpm_high;
+        double quality;
+        const char* artist;
+    };
+    std::vector<Case> cases;
+    cases.push_back(Case{"WAV, 124-130 BPM, quality >= 90",
+                         TrackTable::Query().format(TrackTable::FORMAT_WAV).bpm_between(124, 130).min_quality(90),
+                         true, 124, 130, 90, ""});
+    cases.push_back(Case{"... and artist contains Ferry Corsten",
+                         TrackTable::Query().format(TrackTable::FORMAT_WAV).bpm_between(124, 130).min_quality(90)
+                             .artist_contains("Ferry Corsten"),
+                         true, 124, 130, 90, "Ferry Corsten"});
+
+    for (const Case& c : cases) {
+        start = Clock::now();
+        std::vector<size_t> rows = table.select(c.query);
+        double columnar_ms = ms_since(start);
+
+        // Baseline: the loop a smart playlist would otherwise run over the library
+        start = Clock::now();
+        size_t loop_hits = 0;
+        for (AudioTrack* track : tracks) {
+            if ((dynamic_cast<WAVTrack*>(track) != nullptr) != c.wav) continue;
+            if (track->get_bpm() < c.bpm_low || track->get_bpm() > c.bpm_high) continue;
+            if (track->get_quality_score() < c.quality) continue;
+            if (c.artist[0]) {
+                std::vector<std::string> artists = track->get_artists();
+                if (std::find(artists.begin(), artists.end(), c.artist) == artists.end()) continue;
+            }
+            ++loop_hits;
+        }
+        double loop_ms = ms_since(start);
+
+        std::cout << c.label << ": " << rows.size() << " tracks in " << columnar_ms << " ms (AudioTrack loop "
+                  << loop_hits << " tracks in " << loop_ms << " ms)" << std::endl;
+    }
+
+    std::cout.setstate(std::ios::badbit);
+    std::vector<AudioTrack*> selected;
+    start = Clock::now();
+    {
+        Playlist smart("Smart");
+        for (size_t row : table.select(cases[0].query)) smart.add_track(tracks[row]);
+        selected = smart.getTracks();
+    }
+    double materialize_ms = ms_since(start);
+    std::cout.clear();
+    std::cout << "Materialize smart playlist (" << selected.size() << " tracks): " << materialize_ms << " ms" << std::endl;
+
+    for (AudioTrack* track : tracks) delete track;
+}
+
+void BenchmarkRunner::bench_catalog(const std::vector<std::string>& args) {
+    const size_t track_count = arg_or(args, 0, 1000000);
+    std::cout << "\n=== Benchmark: LibraryCatalog (" << track_count << " tracks) ===" << std::endl;
+
+    std::mt19937 gen(11);
+    std::uniform_int_distribution<int> bpm(90, 180);
+    std::uniform_int_distribution<int> duration(150, 600);
+    std::uniform_int_distribution<int> artist(0, 4999);
+    std::uniform_int_distribution<int> coin(0, 3);
+    const int bitrates[] = {128, 192, 256, 320};
+    const int bit_depths[] = {16, 16, 24, 24};
+    const char* mixes[] = {"Original Mix", "Extended Mix", "Radio Edit", "Club Mix"};
+
+    // Footprint of the same rows held as one AudioTrack* per track, as the library used to.
+    // Counted analytically: a million live AudioTracks would need ~8 GB of waveforms alone.
+    size_t object_bytes = track_count * sizeof(AudioTrack*);
+    size_t waveform_bytes = 0;
+    const size_t waveform_chunk = heap_bytes(1000 * sizeof(double));
+
+    LibraryCatalog catalog;
+    Clock::time_point start = Clock::now();
+    for (size_t i = 0; i < track_count; ++i) {
+        std::vector<std::string> artists;
+        artists.push_back("Artist " + std::to_string(artist(gen)));
+        if (coin(gen) == 0) artists.push_back("Artist " + std::to_string(artist(gen)));
+        std::string title = "Track " + std::to_string(i) + " (" + mixes[coin(gen)] + ")";
+        const bool mp3 = coin(gen) < 2;
+        const int track_bpm = bpm(gen);
+        const int track_duration = duration(gen);
+        if (mp3) {
+            catalog.add("MP3", title, artists, track_duration, track_bpm, bitrates[coin(gen)], 1);
+        } else {
+            catalog.add("WAV", title, artists, track_duration, track_bpm, 44100, bit_depths[coin(gen)]);
+        }
+
+        object_bytes += heap_bytes(mp3 ? sizeof(MP3Track) : sizeof(WAVTrack));
+        object_bytes += string_heap_bytes(title) + heap_bytes(artists.size() * sizeof(std::string));
+        for (const std::string& name : artists) object_bytes += string_heap_bytes(name);
+        waveform_bytes += waveform_chunk;
+    }
+    double build_ms = ms_since(start);
+
+    const double mb = 1024.0 * 1024.0;
+    const size_t catalog_bytes = catalog.memory_bytes();
+    std::cout << "Catalog build: " << build_ms << " ms (" << catalog.title_pool().size() << " titles, "
+              << catalog.artist_pool().size() << " artists)" << std::endl;
+    std::cout << "AudioTrack library: " << object_bytes / mb << " MB metadata + " << waveform_bytes / mb
+              << " MB waveforms = " << (object_bytes + waveform_bytes) / mb << " MB" << std::endl;
+    std::cout << "Catalog: " << catalog_bytes / mb << " MB (" << static_cast<double>(catalog_bytes) / track_count
+              << " bytes/track; " << static_cast<double>(object_bytes) / catalog_bytes
+              << "x smaller without waveforms, " << static_cast<double>(object_bytes + waveform_bytes) / catalog_bytes
+              << "x with)" << std::endl;
+
+    // Title lookups, as importPlaylistFile does for every line
+    const size_t lookups = std::min<size_t>(track_count, 100000);
+    std::uniform_int_distribution<size_t> pick(0, track_count - 1);
+    std::vector<std::string> wanted;
+    wanted.reserve(lookups);
+    for (size_t q = 0; q < lookups; ++q) wanted.push_back(catalog.title(pick(gen)));
+    size_t found = 0;
+    start = Clock::now();
+    for (const std::string& title : wanted) found += catalog.find_title(title) != LibraryCatalog::npos;
+    std::cout << "find_title x" << lookups << ": " << ms_since(start) << " ms (" << found << " found)" << std::endl;
+
+    // Only the tracks a session actually touches become AudioTracks
+    const size_t used = std::min<size_t>(track_count, 1000);
+    std::cout.setstate(std::ios::badbit);
+    start = Clock::now();
+    std::vector<AudioTrack*> live;
+    for (size_t i = 0; i < used; ++i) live.push_back(catalog.materialize(pick(gen)));
+    double materialize_ms = ms_since(start);
+    std::cout.clear();
+    std::cout << "Materialize " << used << " tracks on demand: " << materialize_ms << " ms" << std::endl;
+    for (AudioTrack* track : live) delete track;
+}
+
+void BenchmarkRunner::bench_artist_index(const std::vector<std::string>& args) {
+    const size_t track_count = arg_or(args, 0, 1000000);
+    const size_t query_count = arg_or(args, 1, 1000);
+    std::cout << "\n=== Benchmark: ArtistIndex (" << track_count << " tracks, " << query_count
+              << " queries) ===" << std::endl;
+
+    // A few headliners appear on many tracks, the long tail on a handful each
+    std::mt19937 gen(13);
+    std::uniform_int_distribution<int> headliner(0, 19);
+    std::uniform_int_distribution<int> tail(20, 19999);
+    std::uniform_int_distribution<int> coin(0, 3);
+    LibraryCatalog catalog;
+    for (size_t i = 0; i < track_count; ++i) {
+        std::vector<std::string> artists;
+        artists.push_back("Artist " + std::to_string(coin(gen) == 0 ? headliner(gen) : tail(gen)));
+        if (coin(gen) == 0) artists.push_back("Artist " + std::to_string(coin(gen) < 2 ? headliner(gen) : tail(gen)));
+        catalog.add("MP3", "Track " + std::to_string(i), artists, 300, 128, 320, 1);
+    }
+
+    Clock::time_point start = Clock::now();
+    ArtistIndex index;
+    for (size_t row = 0; row < catalog.size(); ++row) {
+        for (const uint32_t* id = catalog.artist_ids_begin(row); id != catalog.artist_ids_end(row); ++id) {
+            index.add(*id, row);
+        }
+    }
+    std::cout << "Incremental build: " << ms_since(start) << " ms (" << index.artist_count() << " artists)" << std::endl;
+
+    struct Case {
+        const char* label;
+        size_t arity;
+        bool all;
+        bool headliners;
+    };
+    const Case cases[] = {
+        {"Single artist", 1, false, false},
+        {"AND headliner + tail artist", 2, true, false},
+        {"AND two headliners", 2, true, true},
+        {"OR three artists", 3, false, false},
+    };
+    for (const Case& c : cases) {
+        std::vector<std::vector<std::string>> queries(query_count);
+        std::vector<std::vector<uint32_t>> ids(query_count);
+        for (size_t q = 0; q < query_count; ++q) {
+            for (size_t k = 0; k < c.arity; ++k) {
+                bool popular = c.headliners || (c.all && k == 0);
+                queries[q].push_back("Artist " + std::to_string(popular ? headliner(gen) : tail(gen)));
+                ids[q].push_back(catalog.artist_pool().find(queries[q].back()));
+            }
+        }
+
+        size_t indexed_hits = 0;
+        start = Clock::now();
+        for (size_t q = 0; q < query_count; ++q) {
+            indexed_hits += (c.all ? index.match_all(ids[q]) : index.match_any(ids[q])).size();
+        }
+        double indexed_ms = ms_since(start);
+
+        // Baseline: copy every track's artist list and test it, as get_artists() forces
+        const size_t scan_queries = std::min<size_t>(query_count, 10);
+        size_t scan_hits = 0;
+        start = Clock::now();
+        for (size_t q = 0; q < scan_queries; ++q) {
+            for (size_t row = 0; row < catalog.size(); ++row) {
+                std::vector<std::string> artists = catalog.artists(row);
+                size_t matched = 0;
+                for (const std::string& name : queries[q]) {
+                    matched += std::find(artists.begin(), artists.end(), name) != artists.end();
+                }
+                scan_hits += c.all ? matched == queries[q].size() : matched > 0;
+            }
+        }
+        double scan_ms = ms_since(start);
+
+        std::cout << c.label << ": " << indexed_ms * 1000.0 / query_count << " us/query ("
+                  << static_cast<double>(indexed_hits) / query_count << " hits avg); scan "
+                  << scan_ms / scan_queries << " ms/query" << std::endl;
+    }
+}
+
+void BenchmarkRunner::bench_fuzzy_search(const std::vector<std::string>& args) {
+    const size_t track_count = arg_or(args, 0, 1000000);
+    const std::string log_path = args.size() > 1 ? args[1] : "";
+    const size_t top_k = 10;
+    std::cout << "\n=== Benchmark: TrigramIndex (" << track_count << " tracks) ===" << std::endl;
+
+    // Made-up words drawn with English letter frequencies and picked with a skew, so trigram
+    // frequencies are long-tailed like real titles rather than uniform like "Track N"
+    std::mt19937 gen(17);
+    const std::string letters = "etaoinshrdlcumwfgypbvkjxqz";
+    std::discrete_distribution<size_t> letter_pick({127, 91, 82, 75, 70, 67, 63, 61, 60, 43, 40, 28, 28,
+                                                    24, 24, 22, 20, 20, 19, 15, 10, 8, 2, 2, 1, 1});
+    std::uniform_int_distribution<int> word_length(3, 9);
+    auto make_words = [&](size_t count) {
+        std::vector<std::string> words(count);
+        for (std::string& word : words) {
+            for (int n = word_length(gen); n > 0; --n) word += letters[letter_pick(gen)];
+        }
+        return words;
+    };
+    const std::vector<std::string> title_words = make_words(50000);
+    const std::vector<std::string> name_words = make_words(20000);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    auto skewed = [&](const std::vector<std::string>& words) -> const std::string& {
+        double u = unit(gen);
+        return words[static_cast<size_t>(u * u * (words.size() - 1))];
+    };
+    std::uniform_int_distribution<int> coin(0, 3);
+
+    std::vector<std::string> texts;
+    texts.reserve(track_count);
+    TrigramIndex index;
+    double build_ms = 0;
+    for (size_t i = 0; i < track_count; ++i) {
+        std::string text = skewed(title_words);
+        for (int w = coin(gen) % 3; w > 0; --w) text += " " + skewed(title_words);
+        text += " " + skewed(name_words) + " " + skewed(name_words);
+        texts.push_back(text);
+        Clock::time_point start = Clock::now();
+        index.add(i, text);
+        build_ms += ms_since(start);
+    }
+    std::cout << "Build: " << build_ms << " ms (" << index.trigram_count() << " trigrams, "
+              << index.memory_bytes() / (1024.0 * 1024.0) << " MB)" << std::endl;
+
+    // Replay a recorded query log when given one; otherwise synthesize what a user types:
+    // a prefix of a real title, misspelled half of the time
+    std::vector<std::string> queries;
+    std::vector<size_t> targets;
+    if (!log_path.empty()) {
+        std::ifstream log(log_path);
+        std::string line;
+        while (std::getline(log, line)) {
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            if (!line.empty()) queries.push_back(line);
+        }
+        std::cout << "Query log: " << log_path << " (" << queries.size() << " queries)" << std::endl;
+    } else {
+        std::uniform_int_distribution<size_t> pick(0, track_count - 1);
+        std::uniform_int_distribution<int> letter('a', 'z');
+        for (size_t q = 0; q < 10000; ++q) {
+            const size_t row = pick(gen);
+            const std::string& text = texts[row];
+            std::uniform_int_distribution<size_t> cut(std::min<size_t>(5, text.size()), text.size());
+            std::string query = text.substr(0, cut(gen));
+            if (coin(gen) < 2 && query.size() > 3) {
+                std::uniform_int_distribution<size_t> at(1, query.size() - 1);
+                query[at(gen)] = static_cast<char>(letter(gen));
+            }
+            queries.push_back(query);
+            targets.push_back(row);
+        }
+        std::cout << "Synthetic query log: " << queries.size() << " typed prefixes, ~half with a typo" << std::endl;
+    }
+    if (queries.empty()) return;
+
+    std::vector<double> latencies;
+    latencies.reserve(queries.size());
+    size_t found = 0;
+    size_t results = 0;
+    for (size_t q = 0; q < queries.size(); ++q) {
+        Clock::time_point start = Clock::now();
+        std::vector<TrigramIndex::Match> matches = index.search(queries[q], top_k);
+        latencies.push_back(ms_since(start) * 1000.0);
+        results += matches.size();
+        if (targets.empty()) continue;
+        // A hit is the intended track or any track with the same text
+        for (const TrigramIndex::Match& match : matches) {
+            if (match.row == targets[q] || texts[match.row] == texts[targets[q]]) { ++found; break; }
+        }
+    }
+    std::sort(latencies.begin(), latencies.end());
+    std::cout << "Latency (us): p50 " << latencies[latencies.size() / 2]
+              << ", p99 " << latencies[latencies.size() * 99 / 100]
+              << ", max " << latencies.back() << " (" << static_cast<double>(results) / queries.size()
+              << " results avg)" << std::endl;
+    if (!targets.empty()) {
+        std::cout << "Intended track in top " << top_k << ": " << 100.0 * found / queries.size() << "%" << std::endl;
+    }
+}
+
+void BenchmarkRunner::bench_snapshot(const std::vector<std::string>& args) {
+    const size_t track_count = arg_or(args, 0, 1000000);
+    const std::string config_path = "bench_snapshot_config.txt";
+    const std::string snapshot_path = config_path + ".snap";
+    std::cout << "\n=== Benchmark: Library snapshot (" << track_count << " tracks) ===" << std::endl;
+
+    {
+        std::ofstream out(config_path);
+        out << "# Generated snapshot benchmark\napp_name=Benchmark\nversion=1.0\n";
+        for (size_t i = 0; i < track_count; ++i) {
+            out << "library_track_" << i + 1 << "=" << (i % 2 ? "WAV" : "MP3") << ",Track " << i
+                << ",{Artist " << i % 5000 << ";Artist " << (i * 7) % 20000 << ";}," << 180 + i % 240 << ","
+                << 100 + i % 60 << "," << (i % 2 ? "44100,24" : "320,1") << "\n";
+        }
+        out << "bpm_tolerance=6\nauto_sync=true\n";
+        for (int p = 0; p < 4; ++p) {
+            out << "playlist_" << p << "=";
+            for (size_t i = 0; i < 200; ++i) out << (i ? "," : "") << 1 + (i * 4999 + p) % track_count;
+            out << "\n";
+        }
+    }
+
+    std::cout.setstate(std::ios::badbit);
+    Clock::time_point start = Clock::now();
+    SessionConfig parsed;
+    SessionFileParser::parse_config_file(config_path, parsed);
+    double parse_ms = ms_since(start);
+    start = Clock::now();
+    DJLibraryService built;
+    built.buildLibrary(parsed.library_tracks);
+    double build_ms = ms_since(start);
+    start = Clock::now();
+    bool saved = built.saveSnapshot(snapshot_path, config_path, parsed);
+    double save_ms = ms_since(start);
+    std::cout.clear();
+    std::ifstream snapshot_file(snapshot_path, std::ios::binary | std::ios::ate);
+    std::cout << "Text config: parse " << parse_ms << " ms + buildLibrary " << build_ms << " ms" << std::endl;
+    std::cout << "Snapshot write: " << save_ms << " ms (" << (saved ? "ok" : "FAILED") << ", "
+              << static_cast<double>(snapshot_file.tellg()) / (1024.0 * 1024.0) << " MB)" << std::endl;
+
+    std::cout.setstate(std::ios::badbit);
+    start = Clock::now();
+    SessionConfig restored;
+    DJLibraryService library;
+    bool loaded = library.loadSnapshot(snapshot_path, config_path, restored);
+    double load_ms = ms_since(start);
+    // Secondary indexes are built by the first query that needs them
+    start = Clock::now();
+    size_t candidates = library.findMixCandidates(128, 4, 10).size();
+    double first_query_ms = ms_since(start);
+    std::cout.clear();
+    std::cout << "Snapshot startup: " << load_ms << " ms (" << (loaded ? "ok" : "FAILED") << ", "
+              << restored.playlists.size() << " playlists)" << std::endl;
+    std::cout << "First mix query (builds the BPM index): " << first_query_ms << " ms (" << candidates
+              << " candidates)" << std::endl;
+
+    // Any edit to the text config makes the snapshot stale
+    { std::ofstream touch(config_path, std::ios::app); touch << "# edited\n"; }
+    std::cout.setstate(std::ios::badbit);
+    start = Clock::now();
+    SessionConfig stale_config;
+    DJLibraryService stale;
+    bool stale_loaded = stale.loadSnapshot(snapshot_path, config_path, stale_config);
+    double stale_ms = ms_since(start);
+    std::cout.clear();
+    std::cout << "Stale check after editing the config: " << stale_ms << " ms ("
+              << (stale_loaded ? "WRONGLY LOADED" : "rejected, falls back to text") << ")" << std::endl;
+
+    std::remove(config_path.c_str());
+    std::remove(snapshot_path.c_str());
+}
+
+void BenchmarkRunner::bench_reload(const std::vector<std::string>& args) {
+    const size_t track_count = std::max<size_t>(arg_or(args, 0, 1000000), 8);
+    const size_t changed = std::min(arg_or(args, 1, 100), track_count / 2);
+    std::cout << "\n=== Benchmark: Incremental library reload (" << track_count << " tracks, " << changed
+              << " changed) ===" << std::endl;
+
+    std::vector<SessionConfig::TrackInfo> tracks(track_count);
+    for (size_t i = 0; i < track_count; ++i) {
+        SessionConfig::TrackInfo& info = tracks[i];
+        info.type = i % 2 ? "WAV" : "MP3";
+        info.title = "Track " + std::to_string(i);
+        info.artists.push_back("Artist " + std::to_string(i % 5000));
+        info.artists.push_back("Artist " + std::to_string((i * 7) % 20000));
+        info.duration_seconds = 180 + static_cast<int>(i % 240);
+        info.bpm = 100 + static_cast<int>(i % 60);
+        info.extra_param1 = i % 2 ? 44100 : 320;
+        info.extra_param2 = i % 2 ? 24 : 1;
+    }
+
+    // The edited config: retitled, re-credited and re-tempoed tracks, and a shorter tail
+    std::vector<SessionConfig::TrackInfo> edited(tracks);
+    std::mt19937 gen(17);
+    std::uniform_int_distribution<size_t> pick(0, track_count - 1);
+    for (size_t k = 0; k < changed; ++k) {
+        SessionConfig::TrackInfo& info = edited[pick(gen)];
+        switch (k % 3) {
+        case 0: info.bpm += 3; break;
+        case 1: info.title += " (Extended Mix)"; break;
+        default: info.artists.push_back("Artist " + std::to_string(k)); break;
+        }
+    }
+    edited.resize(track_count - changed / 4);
+
+    // Every secondary index is built, as in a session that has been queried
+    TrackTable::Query query = TrackTable::Query().bpm_between(124, 130).artist_contains("Artist 12");
+    std::vector<std::string> artists;
+    artists.push_back("Artist 1");
+    auto run_queries = [&](const DJLibraryService& library) {
+        std::vector<std::string> seen;
+        std::vector<std::vector<AudioTrack*>> results;
+        results.push_back(library.findMixCandidates(128, 2, 50));
+        results.push_back(library.queryLibrary(query, 50));
+        results.push_back(library.findTracksByArtists(artists, false));
+        results.push_back(library.searchLibrary("track 12 extended", 10));
+        for (const std::vector<AudioTrack*>& result : results) {
+            for (AudioTrack* track : result) seen.push_back(track->get_title() + "@" + std::to_string(track->get_bpm()));
+            seen.push_back("|");
+        }
+        return seen;
+    };
+
+    std::cout.setstate(std::ios::badbit);
+    DJLibraryService live;
+    live.buildLibrary(tracks);
+    run_queries(live);
+
+    Clock::time_point start = Clock::now();
+    size_t stale = live.reloadLibrary(edited).size();
+    double reload_ms = ms_since(start);
+    start = Clock::now();
+    std::vector<std::string> incremental = run_queries(live);
+    double reload_query_ms = ms_since(start);
+
+    start = Clock::now();
+    DJLibraryService rebuilt;
+    rebuilt.buildLibrary(edited);
+    std::vector<std::string> fresh = run_queries(rebuilt);
+    double rebuild_ms = ms_since(start);
+    std::cout.clear();
+
+    std::cout << "Incremental reload: " << reload_ms << " ms (" << stale << " stale titles), queries after it "
+              << reload_query_ms << " ms" << std::endl;
+    std::cout << "Full rebuild + index warm-up: " << rebuild_ms << " ms" << std::endl;
+    std::cout << "Query results match a fresh build: " << (incremental == fresh ? "yes" : "NO") << std::endl;
+}
+
+void BenchmarkRunner::bench_paged_catalog(const std::vector<std::string>& args) {
+    const size_t track_count = std::max<size_t>(arg_or(args, 0, 1000000), 1);
+    const size_t pool_pages = arg_or(args, 1, 256);
+    const std::string path = "bench_paged_catalog.pages";
+    std::cout << "\n=== Benchmark: PagedCatalog (" << track_count << " tracks, " << pool_pages
+              << " pool pages) ===" << std::endl;
+
+    // Streamed straight to disk: the writer holds one page plus 16 bytes of index per track
+    Clock::time_point start = Clock::now();
+    bool written = false;
+    {
+        PagedCatalog::Writer writer;
+        SessionConfig::TrackInfo track;
+        track.artists.resize(2);
+        written = writer.open(path, 0, 0);
+        for (size_t i = 0; i < track_count && written; ++i) {
+            track.type = i % 2 ? "WAV" : "MP3";
+            track.title = "Track " + std::to_string(i);
+            track.artists[0] = "Artist " + std::to_string(i % 5000);
+            track.artists[1] = "Artist " + std::to_string((i * 7) % 20000);
+            track.duration_seconds = 180 + static_cast<int>(i % 240);
+            track.bpm = 100 + static_cast<int>(i % 60);
+            track.extra_param1 = i % 2 ? 44100 : 320;
+            track.extra_param2 = i % 2 ? 24 : 1;
+            written = writer.add(track);
+        }
+        written = written && writer.finish();
+    }
+    const double write_ms = ms_since(start);
+
+    PagedCatalog catalog;
+    std::string reason;
+    if (!written || !catalog.open(path, pool_pages, reason)) {
+        std::cout << "[ERROR] Cannot build paged catalog: " << reason << std::endl;
+        std::remove(path.c_str());
+        return;
+    }
+    std::cout << "Write: " << write_ms << " ms (" << catalog.page_count() << " pages, "
+              << catalog.page_count() * PagedCatalog::kPageSize / (1024.0 * 1024.0) << " MB on disk)" << std::endl;
+    std::cout << "Resident: " << catalog.memory_bytes() / 1024.0 << " KiB (pool "
+              << pool_pages * PagedCatalog::kPageSize / 1024 << " KiB + directories)" << std::endl;
+
+    // Title lookups: uniform over the library, and skewed (90% of lookups on 0.1% of titles)
+    const size_t lookups = 20000;
+    std::mt19937 gen(19);
+    std::uniform_int_distribution<size_t> any(0, track_count - 1);
+    std::uniform_int_distribution<size_t> hot(0, std::max<size_t>(track_count / 1000, 1) - 1);
+    std::uniform_int_distribution<int> percent(0, 99);
+    for (int skewed = 0; skewed < 2; ++skewed) {
+        std::vector<size_t> rows(lookups);
+        for (size_t& row : rows) row = (skewed && percent(gen) < 90) ? hot(gen) * 997 % track_count : any(gen);
+        catalog.reset_pool_stats();
+        size_t found = 0;
+        start = Clock::now();
+        for (size_t row : rows) found += catalog.find_title("Track " + std::to_string(row)) == row;
+        const double lookup_ms = ms_since(start);
+        const BufferPool::Stats& stats = catalog.pool_stats();
+        std::cout << (skewed ? "findTrack, skewed: " : "findTrack, uniform: ") << lookup_ms * 1000.0 / lookups
+                  << " us/lookup (" << found << "/" << lookups << " found, pool hit rate "
+                  << 100.0 * stats.hits / std::max<size_t>(stats.hits + stats.misses, 1) << "%)" << std::endl;
+    }
+    start = Clock::now();
+    size_t unknown = 0;
+    for (size_t i = 0; i < 1000; ++i) unknown += catalog.find_title("No Such Track " + std::to_string(i)) == PagedCatalog::npos;
+    std::cout << "findTrack, unknown titles: " << ms_since(start) << " us/lookup (" << unknown << "/1000 absent)" << std::endl;
+
+    // Playlist resolution: 1-based indices to materialized tracks, as loadPlaylistFromIndices does
+    std::cout.setstate(std::ios::badbit);
+    std::vector<AudioTrack*> resolved;
+    catalog.reset_pool_stats();
+    start = Clock::now();
+    for (size_t i = 0; i < 1000; ++i) resolved.push_back(catalog.materialize(any(gen)));
+    const double resolve_ms = ms_since(start);
+    std::cout.clear();
+    std::cout << "Resolve a 1000-track playlist: " << resolve_ms << " ms (" << catalog.pool_stats().misses
+              << " page reads)" << std::endl;
+    for (AudioTrack* track : resolved) delete track;
+
+    catalog.close();
+    std::remove(path.c_str());
+}
+
+void BenchmarkRunner::bench_fingerprint(const std::vector<std::string>& args) {
+    const size_t track_count = std::max<size_t>(arg_or(args, 0, 100000), 2);
+    std::cout << "\n=== Benchmark: Audio fingerprints (" << track_count << " tracks) ===" << std::endl;
+
+    // Every tenth track is another copy of the track before it: retagged, and in another format
+    // or at another bitrate, so its waveform is the same recording with different coding loss
+    std::mt19937 gen(44);
+    std::uniform_int_distribution<int> bitrate_pick(0, 4);
+    const int bitrates[] = {96, 128, 192, 256, 320};
+    std::vector<int> bitrate(track_count, 0);  // 0 = WAV
+    std::vector<size_t> original(track_count);
+    std::vector<double> samples(AudioTrack::kDefaultWaveformSamples);
+    std::vector<AudioFingerprint> prints(track_count);
+    size_t agree = 0;
+    double render_ms = 0, scalar_ms = 0, simd_ms = 0;
+    for (size_t row = 0; row < track_count; ++row) {
+        const bool copy = row % 10 == 9;
+        original[row] = copy ? row - 1 : row;
+        bitrate[row] = (row % 3 == 0) ? 0 : bitrates[bitrate_pick(gen)];
+        const size_t base = original[row];
+        const std::string title = "Track " + std::to_string(base) + (copy ? " (Extended Mix)" : "");
+        const std::vector<std::string> artists(1, "Artist " + std::to_string(base % 5000));
+
+        Clock::time_point start = Clock::now();
+        AudioTrack::render_waveform(title, artists, samples.data(), samples.size());
+        if (bitrate[row]) MP3Track::encode_lossy(samples.data(), samples.size(), bitrate[row]);
+        render_ms += ms_since(start);
+        start = Clock::now();
+        const AudioFingerprint scalar = AudioFingerprint::compute_scalar(samples.data(), samples.size());
+        scalar_ms += ms_since(start);
+        start = Clock::now();
+        prints[row] = AudioFingerprint::compute(samples.data(), samples.size());
+        simd_ms += ms_since(start);
+        agree += prints[row] == scalar;
+    }
+    const double bytes = static_cast<double>(track_count) * samples.size() * sizeof(double);
+    std::cout << "Waveform synthesis: " << render_ms << " ms" << std::endl;
+    std::cout << "Fingerprint, scalar: " << scalar_ms << " ms (" << bytes / (scalar_ms * 1e6) << " GB/s)" << std::endl;
+    std::cout << "Fingerprint, SIMD: " << simd_ms << " ms (" << bytes / (simd_ms * 1e6) << " GB/s, "
+              << scalar_ms / simd_ms << "x; " << agree << "/" << track_count << " identical to scalar)" << std::endl;
+
+    FingerprintIndex index;
+    Clock::time_point start = Clock::now();
+    for (size_t row = 0; row < track_count; ++row) index.add(row, prints[row]);
+    std::cout << "LSH index build: " << ms_since(start) << " ms (" << index.memory_bytes() / (1024.0 * 1024.0)
+              << " MB)" << std::endl;
+
+    start = Clock::now();
+    const std::vector<std::vector<size_t>> groups = index.groups();
+    const double group_ms = ms_since(start);
+    size_t found = 0, wrong = 0, expected = 0;
+    for (size_t row = 0; row < track_count; ++row) expected += original[row] != row;
+    for (const std::vector<size_t>& group : groups) {
+        for (size_t row : group) {
+            if (original[row] != row) ++found;
+            if (original[row] != original[group[0]]) ++wrong;
+        }
+    }
+    std::cout << "Duplicate groups: " << group_ms << " ms (" << groups.size() << " groups, " << found << "/" << expected
+              << " copies found, " << wrong << " tracks grouped with another recording)" << std::endl;
+
+    const size_t queries = std::min<size_t>(track_count, 10000);
+    std::uniform_int_distribution<size_t> any(0, track_count - 1);
+    size_t hits = 0;
+    start = Clock::now();
+    for (size_t q = 0; q < queries; ++q) hits += index.near(prints[any(gen)]).size();
+    const double query_ms = ms_since(start);
+    std::cout << "Near-duplicate lookup: " << query_ms * 1000.0 / queries << " us/query (" << hits / static_cast<double>(queries)
+              << " rows per result)" << std::endl;
+}
+
+void BenchmarkRunner::bench_versions(const std::vector<std::string>& args) {
+    const size_t track_count = std::max<size_t>(arg_or(args, 0, 100000), 64);
+    const size_t reader_count = std::min<size_t>(std::max<size_t>(arg_or(args, 1, 3), 1), EpochDomain::kMaxReaders);
+    const size_t changed = 16;  // rows every reload retunes to one common BPM
+    const std::chrono::milliseconds phase(1000);
+    std::cout << "\n=== Benchmark: Library versions (" << track_count << " tracks, " << reader_count
+              << " reader threads) ===" << std::endl;
+
+    std::vector<SessionConfig::TrackInfo> tracks(track_count);
+    for (size_t i = 0; i < track_count; ++i) {
+        SessionConfig::TrackInfo& info = tracks[i];
+        info.type = i % 2 ? "WAV" : "MP3";
+        info.title = "Track " + std::to_string(i);
+        info.artists.push_back("Artist " + std::to_string(i % 5000));
+        info.duration_seconds = 180 + static_cast<int>(i % 240);
+        info.bpm = i < changed ? 100 : 100 + static_cast<int>(i % 60);
+        info.extra_param1 = i % 2 ? 44100 : 320;
+        info.extra_param2 = i % 2 ? 24 : 1;
+    }
+    std::cout.setstate(std::ios::badbit);
+    DJLibraryService service;
+    service.buildLibrary(tracks);
+    std::cout.clear();
+    Clock::time_point start = Clock::now();
+    const EpochPublished<LibraryVersion>& versions = *service.versions();  // in-memory library: never null
+    std::cout << "First version: " << ms_since(start) << " ms" << std::endl;
+
+    // Writer: reloads that retune the first rows together. Inside one version they always agree,
+    // so a reader that sees them disagree has read a half-applied reload.
+    std::mutex library_mutex;  // baseline only: in-place mutation under a lock
+    size_t reloads = 0;
+    double reload_ms = 0;
+    auto reload = [&](bool locked) {
+        for (size_t i = 0; i < changed; ++i) tracks[i].bpm = 100 + static_cast<int>(reloads % 50);
+        Clock::time_point begin = Clock::now();
+        std::cout.setstate(std::ios::badbit);
+        if (locked) {
+            std::lock_guard<std::mutex> lock(library_mutex);
+            service.reloadLibrary(tracks);
+        } else {
+            service.reloadLibrary(tracks);
+        }
+        std::cout.clear();
+        reload_ms += ms_since(begin);
+        ++reloads;
+    };
+
+    // mode 0: epoch pins, no writer; 1: epoch pins during reloads; 2: mutex during locked reloads
+    const char* labels[] = {"Pinned reads, idle library: ", "Pinned reads, reloading: ", "Mutex reads, reloading: "};
+    for (int mode = 0; mode < 3; ++mode) {
+        std::atomic<bool> stop(false);
+        std::vector<size_t> reads(reader_count, 0);
+        std::vector<size_t> torn(reader_count, 0);
+        std::vector<double> cpu_ms(reader_count, 0);
+        std::vector<std::thread> readers;
+        for (size_t t = 0; t < reader_count; ++t) {
+            readers.push_back(std::thread([&, t]() {
+                EpochDomain::Reader reader(service.versionDomain());
+                std::mt19937 rng(static_cast<unsigned>(t));
+                // CPU time, so the per-read cost shows even when readers share cores with the writer
+                timespec cpu_start, cpu_end;
+                clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpu_start);
+                size_t checksum = 0;
+                while (!stop.load(std::memory_order_relaxed)) {
+                    if (mode < 2) {
+                        EpochPublished<LibraryVersion>::Pin pin(versions, reader);
+                        const SessionConfig::TrackInfo& info = pin->tracks[rng() % pin->tracks.size()];
+                        checksum += info.bpm + info.title.size();
+                        torn[t] += pin->tracks[0].bpm != pin->tracks[changed - 1].bpm;
+                    } else {
+                        std::lock_guard<std::mutex> lock(library_mutex);
+                        const LibraryVersion* latest = versions.latest();
+                        const SessionConfig::TrackInfo& info = latest->tracks[rng() % latest->tracks.size()];
+                        checksum += info.bpm + info.title.size();
+                    }
+                    ++reads[t];
+                }
+                reads[t] += checksum & 0;  // keeps the reads from being optimized away
+                clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpu_end);
+                cpu_ms[t] = (cpu_end.tv_sec - cpu_start.tv_sec) * 1e3 + (cpu_end.tv_nsec - cpu_start.tv_nsec) / 1e6;
+            }));
+        }
+        const size_t reloads_before = reloads;
+        const double reload_ms_before = reload_ms;
+        start = Clock::now();
+        if (mode == 0) {
+            std::this_thread::sleep_for(phase);
+        } else {
+            while (Clock::now() - start < phase) reload(mode == 2);
+        }
+        stop.store(true);
+        const double elapsed_ms = ms_since(start);
+        for (std::thread& reader : readers) reader.join();
+
+        size_t total = 0, torn_total = 0;
+        double reader_cpu_ms = 0;
+        for (size_t t = 0; t < reader_count; ++t) {
+            total += reads[t];
+            torn_total += torn[t];
+            reader_cpu_ms += cpu_ms[t];
+        }
+        std::cout << labels[mode] << total / (elapsed_ms * 1000.0) << " M reads/s, "
+                  << total / (std::max(reader_cpu_ms, 1e-3) * 1000.0) << " M per reader CPU second";
+        if (mode > 0) {
+            const size_t done = reloads - reloads_before;
+            std::cout << " (" << done << " reloads, " << (reload_ms - reload_ms_before) / std::max<size_t>(done, 1)
+                      << " ms each";
+            if (mode == 1) std::cout << ", " << torn_total << " torn reads";
+            std::cout << ")";
+        }
+        std::cout << std::endl;
+    }
+    std::cout << "Versions published: " << versions.latest()->number << ", still retired: "
+              << service.versionDomain().pending() << std::endl;
+}
+
+void BenchmarkRunner::bench_config_parse(const std::vector<std::string>& args) {
+    const size_t max_lines = std::max<size_t>(arg_or(args, 0, 1000000), 10000);
+    const unsigned threads = static_cast<unsigned>(std::max<size_t>(arg_or(args, 1, 4), 2));
+    const std::string path = "bench_parse_config.txt";
+    std::cout << "\n=== Benchmark: Config parse (10000 to " << max_lines << " lines, " << threads
+              << " threads, " << std::thread::hardware_concurrency() << " cores) ===" << std::endl;
+
+    for (size_t line_count = 10000; line_count <= max_lines; line_count *= 10) {
+        const size_t track_count = line_count - 8;
+        {
+            std::ofstream out(path);
+            out << "# Generated parse benchmark\napp_name=Benchmark\nversion=1.0\n";
+            for (size_t i = 0; i < track_count; ++i) {
+                out << "library_track_" << i + 1 << "=" << (i % 2 ? "WAV" : "MP3") << ", Track " << i
+                    << " ,{Artist " << i % 5000 << "; Artist " << (i * 7) % 20000 << ";}," << 180 + i % 240 << ","
+                    << 100 + i % 60 << "," << (i % 2 ? "44100,24" : "320,1") << "\n";
+            }
+            out << "bpm_tolerance=6\nauto_sync=true\n";
+            for (int p = 0; p < 3; ++p) {
+                out << "playlist_" << p << "=";
+                for (size_t i = 0; i < 200; ++i) out << (i ? "," : "") << 1 + (i * 4999 + p) % track_count;
+                out << "\n";
+            }
+        }
+        std::ifstream sized(path, std::ios::binary | std::ios::ate);
+        const double megabytes = static_cast<double>(sized.tellg()) / (1024.0 * 1024.0);
+
+        std::cout.setstate(std::ios::badbit);
+        double stream_ms = 0;
+        size_t stream_sum = 0;
+        {
+            SessionConfig config;
+            Clock::time_point start = Clock::now();
+            SessionFileParser::parse_config_stream(path, config);
+            stream_ms = ms_since(start);
+            for (const auto& track : config.library_tracks) stream_sum += track.title.size() + track.artists.size() + track.bpm;
+            stream_sum += config.playlists.size();
+        }
+        double mapped_ms = 0;
+        size_t mapped_sum = 0;
+        {
+            SessionConfig config;
+            Clock::time_point start = Clock::now();
+            SessionFileParser::parse_config_file(path, config);
+            mapped_ms = ms_since(start);
+            for (const auto& track : config.library_tracks) mapped_sum += track.title.size() + track.artists.size() + track.bpm;
+            mapped_sum += config.playlists.size();
+        }
+        // Files under 1 MiB per thread are parsed sequentially anyway
+        double parallel_ms = 0;
+        size_t parallel_sum = 0;
+        {
+            SessionConfig config;
+            Clock::time_point start = Clock::now();
+            SessionFileParser::parse_config_file(path, config, threads);
+            parallel_ms = ms_since(start);
+            for (const auto& track : config.library_tracks) parallel_sum += track.title.size() + track.artists.size() + track.bpm;
+            parallel_sum += config.playlists.size();
+        }
+        std::cout.clear();
+
+        std::cout << line_count << " lines (" << megabytes << " MB): ifstream " << stream_ms << " ms, mapped "
+                  << mapped_ms << " ms (" << megabytes / (mapped_ms / 1000.0) << " MB/s, "
+                  << stream_ms / mapped_ms << "x), parallel " << parallel_ms << " ms ("
+                  << megabytes / (parallel_ms / 1000.0) << " MB/s, " << stream_ms / parallel_ms << "x), "
+                  << (stream_sum == mapped_sum && stream_sum == parallel_sum ? "same result" : "RESULTS DIFFER")
+                  << std::endl;
+    }
+    std::remove(path.c_str());
+}
+
+void BenchmarkRunner::bench_config_keys(const std::vector<std::string>& args) {
+    const size_t lookups = arg_or(args, 0, 10000000);
+    std::cout << "\n=== Benchmark: Config key dispatch (" << lookups << " lookups per key set) ===" << std::endl;
+
+    std::vector<std::string> track_keys;
+    for (int i = 0; i < 32; ++i) track_keys.push_back("library_track_" + std::to_string(i * 7919 + 1));
+    const std::vector<std::string> other_keys = {"app_name", "version", "controller_cache_size", "default_crossfade_time",
+                                                 "bpm_tolerance", "auto_sync", "armin", "fresh_summer_vibes"};
+
+    for (int set = 0; set < 2; ++set) {
+        const std::vector<std::string>& keys = set == 0 ? track_keys : other_keys;
+        std::vector<TextView> views;
+        for (const std::string& key : keys) views.push_back(TextView(key.data(), key.size()));
+
+        // The dispatch parse_config_file used before ConfigKeys
+        Clock::time_point start = Clock::now();
+        size_t chain_sum = 0;
+        for (size_t i = 0, next = 0; i < lookups; ++i, next = next + 1 == views.size() ? 0 : next + 1) {
+            const TextView& key = views[next];
+            size_t id = 8;
+            if (key == "app_name") id = 0;
+            else if (key == "version") id = 1;
+            else if (key.starts_with("library_track_")) id = 7;
+            else if (key == "controller_cache_size") id = 2;
+            else if (key == "bpm_tolerance") id = 5;
+            else if (key == "auto_sync") id = 6;
+            else if (key == "default_crossfade_time") id = 4;
+            chain_sum += id;
+        }
+        const double chain_ms = ms_since(start);
+
+        start = Clock::now();
+        size_t hash_sum = 0;
+        for (size_t i = 0, next = 0; i < lookups; ++i, next = next + 1 == views.size() ? 0 : next + 1) {
+            hash_sum += static_cast<size_t>(ConfigKeys::lookup(views[next]));
+        }
+        const double hash_ms = ms_since(start);
+
+        std::cout << (set == 0 ? "Track keys: " : "Setting and playlist keys: ") << "comparison chain "
+                  << chain_ms * 1e6 / lookups << " ns/key, length switch " << hash_ms * 1e6 / lookups << " ns/key ("
+                  << chain_ms / hash_ms << "x, " << (chain_sum == hash_sum ? "same keys" : "KEYS DIFFER") << ")"
+                  << std::endl;
+    }
+}
+
+void BenchmarkRunner::bench_config_watch(const std::vector<std::string>& args) {
+    const size_t track_count = std::max<size_t>(arg_or(args, 0, 20000), 1);
+    const size_t updates = std::max<size_t>(arg_or(args, 1, 20), 2);
+    const std::string path = "bench_watch_config.txt";
+    std::cout << "\n=== Benchmark: Live config (" << track_count << " tracks, " << updates
+              << " edits, 1 ms tracks) ===" << std::endl;
+
+    // Odd edits are written in place, even ones the way editors save: a temp file renamed over it
+    auto write_config = [&](size_t edit, int bpm_tolerance) {
+        const std::string target = edit % 2 ? path : path + ".tmp";
+        {
+            std::ofstream out(target);
+            out << "app_name=Benchmark\nversion=1.0\ncontroller_cache_size=16\nauto_sync=true\n";
+            for (size_t i = 0; i < track_count; ++i) {
+                out << "library_track_" << i + 1 << "=MP3, Track " << i << " ,{Artist " << i % 500 << ";},"
+                    << 180 + i % 240 << "," << 100 + i % 60 << ",320,1\n";
+            }
+            out << "bpm_tolerance=" << bpm_tolerance << "\nplaylist_main=1,2,3\n";
+        }
+        if (target != path) std::rename(target.c_str(), path.c_str());
+    };
+    write_config(1, 0);
+
+    ConfigWatcher watcher;
+    std::string reason;
+    if (!watcher.start(path, reason)) {
+        std::cout << "ConfigWatcher unavailable: " << reason << std::endl;
+        std::remove(path.c_str());
+        return;
+    }
+
+    // The session thread: a 1 ms track, then a take() at the boundary, until the edit shows up
+    double total_latency_ms = 0, max_latency_ms = 0, total_parse_ms = 0, max_take_us = 0;
+    size_t applied = 0, rejected = 0, boundaries = 0;
+    for (size_t edit = 1; edit <= updates; ++edit) {
+        // The last edit is invalid and must be rejected without touching the settings
+        const int bpm_tolerance = edit == updates ? -1 : static_cast<int>(edit);
+        const Clock::time_point written = Clock::now();
+        write_config(edit, bpm_tolerance);
+        for (;;) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            ++boundaries;
+            ConfigWatcher::Update update;
+            const Clock::time_point boundary = Clock::now();
+            const bool taken = watcher.take(update);
+            max_take_us = std::max(max_take_us, ms_since(boundary) * 1000.0);
+            if (taken && update.config && update.config->bpm_tolerance == bpm_tolerance) {
+                ++applied;
+            } else if (taken && !update.config) {
+                ++rejected;
+            } else if (ms_since(written) < 2000) {
+                continue;
+            }
+            const double latency_ms = ms_since(written);
+            total_latency_ms += latency_ms;
+            max_latency_ms = std::max(max_latency_ms, latency_ms);
+            total_parse_ms += update.parse_ms;
+            break;
+        }
+    }
+    watcher.stop();
+    std::remove(path.c_str());
+
+    std::cout << applied << " edits applied, " << rejected << " rejected (expected " << updates - 1 << " and 1)"
+              << std::endl;
+    std::cout << "Write started -> taken at a track boundary: avg " << total_latency_ms / updates << " ms, max "
+              << max_latency_ms << " ms (includes the " << ConfigWatcher::kSettleMs << " ms settle)" << std::endl;
+    std::cout << "Background parse + validate: avg " << total_parse_ms / updates << " ms per edit" << std::endl;
+    std::cout << "Boundary check (take): max " << max_take_us << " us over " << boundaries << " track boundaries"
+              << std::endl;
+}
+
+void BenchmarkRunner::bench_text_scan(const std::vector<std::string>& args) {
+    const size_t megabytes = std::max<size_t>(arg_or(args, 0, 64), 1);
+    const TextScan::Level best = TextScan::best_level();
+    std::cout << "\n=== Benchmark: Text scanning (" << megabytes << " MB of config lines, best level "
+              << TextScan::level_name(best) << ") ===" << std::endl;
+
+    std::string text;
+    text.reserve(megabytes << 20);
+    for (size_t i = 0; text.size() < (megabytes << 20); ++i) {
+        text += "library_track_" + std::to_string(i + 1) + "=" + (i % 2 ? "WAV" : "MP3") + ", Track "
+              + std::to_string(i) + " ,{Artist " + std::to_string(i % 5000) + "; Artist "
+              + std::to_string((i * 7) % 20000) + ";}," + std::to_string(180 + i % 240) + ","
+              + std::to_string(100 + i % 60) + "," + (i % 2 ? "44100,24" : "320,1") + "\n";
+    }
+    const TextView view(text.data(), text.size());
+    const double bytes = static_cast<double>(text.size());
+    auto report = [bytes](const char* label, double ms, uint64_t cycles) {
+        std::cout << label << ms << " ms, " << bytes / (ms * 1e6) << " GB/s";
+        if (cycles) std::cout << ", " << bytes / static_cast<double>(cycles) << " bytes/cycle";
+    };
+
+    // One pass over every newline, '=', ',' and ';' at each level; all levels must agree
+    std::vector<TextScan::Level> levels(1, TextScan::Level::Scalar);
+    if (best != TextScan::Level::Scalar) levels.push_back(TextScan::Level::SSE2);
+    if (best == TextScan::Level::AVX2) levels.push_back(TextScan::Level::AVX2);
+    size_t reference_found = 0;
+    uint64_t reference_sum = 0;
+    bool agree = true;
+    for (TextScan::Level level : levels) {
+        Clock::time_point start = Clock::now();
+        const uint64_t first_cycle = tsc_now();
+        DelimiterScanner scanner(view, "\n=,;", level);
+        size_t found = 0;
+        uint64_t sum = 0;
+        for (size_t at = scanner.next(); at != TextView::npos; at = scanner.next()) {
+            ++found;
+            sum += at;
+        }
+        const uint64_t cycles = tsc_now() - first_cycle;
+        const double ms = ms_since(start);
+        if (level == levels.front()) {
+            reference_found = found;
+            reference_sum = sum;
+        }
+        agree = agree && found == reference_found && sum == reference_sum;
+        const std::string label = std::string("DelimiterScanner ") + TextScan::level_name(level) + ": ";
+        report(label.c_str(), ms, cycles);
+        std::cout << " (" << found << " delimiters)" << std::endl;
+    }
+
+    // What the parsers did before: find() for each line, its '=', then each ',' and ';' separately
+    {
+        Clock::time_point start = Clock::now();
+        const uint64_t first_cycle = tsc_now();
+        TextView rest = view;
+        TextView line;
+        size_t found = 0;
+        while (rest.next_token('\n', line)) {
+            ++found;
+            const size_t equals = line.find('=');
+            if (equals == TextView::npos) continue;
+            ++found;
+            TextView value = line.sub(equals + 1);
+            TextView field;
+            while (value.next_token(',', field)) {
+                TextView artists = field;
+                TextView artist;
+                while (artists.next_token(';', artist)) ++found;
+            }
+        }
+        const uint64_t cycles = tsc_now() - first_cycle;
+        report("find() per line and field: ", ms_since(start), cycles);
+        std::cout << " (" << found << " tokens)" << std::endl;
+    }
+
+    // Newline counting for chunk line numbers
+    {
+        Clock::time_point start = Clock::now();
+        uint64_t first_cycle = tsc_now();
+        const size_t lines_std = static_cast<size_t>(std::count(text.begin(), text.end(), '\n'));
+        uint64_t cycles = tsc_now() - first_cycle;
+        report("std::count newlines: ", ms_since(start), cycles);
+        std::cout << std::endl;
+        start = Clock::now();
+        first_cycle = tsc_now();
+        const size_t lines_scan = TextScan::count(view, '\n');
+        cycles = tsc_now() - first_cycle;
+        report("TextScan::count newlines: ", ms_since(start), cycles);
+        std::cout << (lines_std == lines_scan ? " (same count)" : " (COUNTS DIFFER)") << std::endl;
+    }
+
+    // End to end: the mapped config parse and the .playlist reader, both on the scanner
+    const std::string config_path = "bench_text_scan_config.txt";
+    const std::string playlist_path = "bench_text_scan.playlist";
+    {
+        std::ofstream config(config_path, std::ios::binary);
+        config << text;
+        std::ofstream playlist(playlist_path, std::ios::binary);
+        for (size_t i = 0; playlist.tellp() < static_cast<std::streamoff>(text.size()); ++i) {
+            playlist << (i % 2 ? "WAV" : "MP3") << ",Track " << i << ",Artist " << i % 500 << "," << 180 + i % 120
+                     << "," << 110 + i % 40 << "," << (i % 2 ? "44100,16" : "320,1") << "\n";
+        }
+    }
+    {
+        SessionConfig config;
+        std::cout.setstate(std::ios::badbit);
+        Clock::time_point start = Clock::now();
+        const uint64_t first_cycle = tsc_now();
+        SessionFileParser::parse_config_file(config_path, config);
+        const uint64_t cycles = tsc_now() - first_cycle;
+        const double ms = ms_since(start);
+        std::cout.clear();
+        report("parse_config_file: ", ms, cycles);
+        std::cout << " (" << config.library_tracks.size() << " tracks)" << std::endl;
+    }
+    {
+        size_t checksum = 0;
+        Clock::time_point start = Clock::now();
+        const uint64_t first_cycle = tsc_now();
+        const long records = PlaylistReader::for_each(playlist_path, [&checksum](const PlaylistReader::Record& record) {
+            checksum += static_cast<size_t>(record.bpm) + record.title.size();
+        });
+        const uint64_t cycles = tsc_now() - first_cycle;
+        report("PlaylistReader: ", ms_since(start), cycles);
+        std::cout << " (" << records << " records)" << std::endl;
+    }
+    std::remove(config_path.c_str());
+    std::remove(playlist_path.c_str());
+    std::cout << (agree ? "All levels found the same delimiters" : "LEVELS DISAGREE") << std::endl;
+}
@@ -0,0 +1,80 @@
+#include "BufferPool.h"
+#include <fcntl.h>
+#include <unistd.h>
+
+BufferPool::BufferPool()
+    : fd(-1), page_bytes(0), memory(), frames(), resident(), hand(0), counters() {}
+
+BufferPool::~BufferPool() {
+    close();
+}
+
+bool BufferPool::open(const std::string& path, size_t page_size, size_t capacity) {
+    close();
+    fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    if (capacity == 0) capacity = 1;
+    page_bytes = page_size;
+    memory.assign(page_size * capacity, 0);
+    Frame empty = {0, false, false};
+    frames.assign(capacity, empty);
+    resident.reserve(capacity);
+    hand = 0;
+    counters = Stats();
+    return true;
+}
+
+void BufferPool::close() {
+    if (fd >= 0) ::close(fd);
+    fd = -1;
+    std::vector<char>().swap(memory);
+    frames.clear();
+    resident.clear();
+}
+
+const char* BufferPool::fetch(uint64_t page_no) {
+    auto found = resident.find(page_no);
+    if (found != resident.end()) {
+        ++counters.hits;
+        frames[found->second].referenced = true;
+        return &memory[found->second * page_bytes];
+    }
+
+    ++counters.misses;
+    const size_t victim = pick_victim();
+    Frame& frame = frames[victim];
+    if (frame.used) {
+        resident.erase(frame.page_no);
+        ++counters.evictions;
+        frame.used = false;
+    }
+    char* bytes = &memory[victim * page_bytes];
+    const off_t offset = static_cast<off_t>(page_no * page_bytes);
+    size_t done = 0;
+    while (done < page_bytes) {
+        ssize_t got = ::pread(fd, bytes + done, page_bytes - done, offset + static_cast<off_t>(done));
+        if (got <= 0) return nullptr;
+        done += static_cast<size_t>(got);
+    }
+    frame.page_no = page_no;
+    frame.used = true;
+    frame.referenced = true;
+    resident[page_no] = victim;
+    return bytes;
+}
+
+size_t BufferPool::pick_victim() {
+    // At most two sweeps: the first clears every reference bit it passes
+    for (;;) {
+        Frame& frame = frames[hand];
+        const size_t candidate = hand;
+        hand = (hand + 1) % frames.size();
+        if (!frame.used || !frame.referenced) return candidate;
+        frame.referenced = false;
+    }
+}
+
+size_t BufferPool::memory_bytes() const {
+    return memory.capacity() + frames.capacity() * sizeof(Frame)
+         + resident.bucket_count() * sizeof(void*) + resident.size() * (sizeof(uint64_t) + sizeof(size_t) + sizeof(void*));
+}
@@ -0,0 +1,4 @@
+#include "ConfigKeys.h"
+
+constexpr const char* ConfigKeyHash::kNames[ConfigKeyHash::kCount];
+constexpr size_t ConfigKeyHash::kCount;
@@ -0,0 +1,153 @@
+#include "ConfigWatcher.h"
+#include "MappedFile.h"
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+#include <poll.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/inotify.h>
+#endif
+
+const int ConfigWatcher::kSettleMs;
+
+ConfigWatcher::ConfigWatcher()
+    : config_path(), file_name(), inotify_fd(-1), wake_pipe(), worker(), pending_mutex(), pending(),
+      published_count(0) {
+    wake_pipe[0] = -1;
+    wake_pipe[1] = -1;
+}
+
+ConfigWatcher::~ConfigWatcher() {
+    stop();
+}
+
+bool ConfigWatcher::start(const std::string& path, std::string& reason) {
+    stop();
+#ifdef __linux__
+    const size_t slash = path.find_last_of('/');
+    const std::string directory = slash == std::string::npos ? "." : path.substr(0, slash == 0 ? 1 : slash);
+    config_path = path;
+    file_name = slash == std::string::npos ? path : path.substr(slash + 1);
+
+    inotify_fd = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotify_fd < 0) {
+        reason = std::string("inotify_init1: ") + std::strerror(errno);
+        return false;
+    }
+    if (::inotify_add_watch(inotify_fd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+        reason = "cannot watch " + directory + ": " + std::strerror(errno);
+        ::close(inotify_fd);
+        inotify_fd = -1;
+        return false;
+    }
+    if (::pipe(wake_pipe) != 0) {
+        reason = std::string("pipe: ") + std::strerror(errno);
+        ::close(inotify_fd);
+        inotify_fd = -1;
+        return false;
+    }
+    worker = std::thread(&ConfigWatcher::run, this);
+    return true;
+#else
+    (void)path;
+    reason = "inotify is not available on this platform";
+    return false;
+#endif
+}
+
+void ConfigWatcher::stop() {
+    if (worker.joinable()) {
+        const char wake = 1;
+        while (::write(wake_pipe[1], &wake, 1) < 0 && errno == EINTR) {}
+        worker.join();
+    }
+    for (int* fd : {&inotify_fd, &wake_pipe[0], &wake_pipe[1]}) {
+        if (*fd >= 0) ::close(*fd);
+        *fd = -1;
+    }
+}
+
+bool ConfigWatcher::take(Update& update) {
+    std::unique_ptr<Update> newest;
+    {
+        std::lock_guard<std::mutex> lock(pending_mutex);
+        newest.swap(pending);
+    }
+    if (!newest) return false;
+    update = std::move(*newest);
+    return true;
+}
+
+size_t ConfigWatcher::published() const {
+    std::lock_guard<std::mutex> lock(pending_mutex);
+    return published_count;
+}
+
+void ConfigWatcher::run() {
+    pollfd fds[2] = {{inotify_fd, POLLIN, 0}, {wake_pipe[0], POLLIN, 0}};
+    for (;;) {
+        if (::poll(fds, 2, -1) < 0) {
+            if (errno == EINTR) continue;
+            return;
+        }
+        if (fds[1].revents != 0) return;
+        if (!drain_events()) continue;
+
+        // Editors often save in several steps; parse once they are done
+        const Clock::time_point changed = Clock::now();
+        int ready = 0;
+        while ((ready = ::poll(fds, 2, kSettleMs)) != 0) {
+            if (ready < 0 && errno != EINTR) return;
+            if (fds[1].revents != 0) return;
+            if (ready > 0) drain_events();
+        }
+        reparse(changed);
+    }
+}
+
+bool ConfigWatcher::drain_events() {
+    bool relevant = false;
+#ifdef __linux__
+    alignas(inotify_event) char buffer[4096];
+    for (;;) {
+        const ssize_t got = ::read(inotify_fd, buffer, sizeof(buffer));
+        if (got <= 0) break;
+        for (ssize_t offset = 0; offset < got;) {
+            const inotify_event* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+            if (event->len > 0 && file_name == event->name) relevant = true;
+            offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+        }
+    }
+#endif
+    return relevant;
+}
+
+void ConfigWatcher::reparse(Clock::time_point changed) {
+    std::unique_ptr<Update> update(new Update());
+    update->changed = changed;
+    // Stamp first: an edit made while parsing raises another event and another update
+    MappedFile::stat(config_path, update->size, update->mtime_ns);
+
+    const Clock::time_point start = Clock::now();
+    std::unique_ptr<SessionConfig> fresh(new SessionConfig());
+    std::ostringstream log;
+    std::string reason;
+    // This overload reads the file into a buffer; a mapping could SIGBUS if the editor truncates it now
+    if (!SessionFileParser::parse_config_file(config_path, *fresh, 0, log)) {
+        update->rejected = "cannot read " + config_path;
+    } else if (!SessionFileParser::validate_config(*fresh, reason)) {
+        update->rejected = reason;
+    } else {
+        update->config.swap(fresh);
+    }
+    update->parse_ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    update->log = log.str();
+
+    {
+        std::lock_guard<std::mutex> lock(pending_mutex);
+        pending.swap(update);
+        ++published_count;
+    }
+    // update now holds the replaced update, if it was never taken; freed outside the lock
+}
@@ -1,12 +1,31 @@
 #include "ConfigurationManager.h"
+#include "ConfigKeys.h"
+#include "TextView.h"
 #include <fstream>
 #include <sstream>
 #include <iostream>
 
+namespace {
+
+typedef ConfigurationManager::Settings Settings;
+
+// Typed setter for each named key, in ConfigKey order; invalid values are reported with the key and value
+constexpr SettingBinding<Settings> kSettingBindings[ConfigKeyHash::kCount] = {
+    {ConfigKey::AppName, &ConfigKeys::set_text<Settings, &Settings::app_name>, ""},
+    {ConfigKey::Version, &ConfigKeys::set_text<Settings, &Settings::version>, ""},
+    {ConfigKey::ControllerCacheSize, &ConfigKeys::set_int<Settings, &Settings::cache_size>, ""},
+    {ConfigKey::CacheSize, &ConfigKeys::set_int<Settings, &Settings::cache_size>, ""},
+    {ConfigKey::DefaultCrossfadeTime, &ConfigKeys::set_int<Settings, &Settings::default_crossfade_time>, ""},
+    {ConfigKey::BpmTolerance, &ConfigKeys::set_int<Settings, &Settings::bpm_tolerance>, ""},
+    {ConfigKey::AutoSync, &ConfigKeys::set_flag<Settings, &Settings::auto_sync>, ""},
+};
+
+static_assert(bindings_in_order(kSettingBindings), "kSettingBindings must list the named keys in ConfigKey order");
+
+} // namespace
+
 ConfigurationManager::ConfigurationManager() :
-    cache_size(8),
-    bpm_tolerance(10),
-    auto_sync(true), additional_settings() {
+    settings(), additional_settings() {
 }
 
 bool ConfigurationManager::loadFromFile(const std::string& config_path) {
@@ -15,36 +34,38 @@ bool ConfigurationManager::loadFromFile(const std::string& config_path) {
         std::cerr << "[ERROR] Could not open config file: " << config_path << std::endl;
         return false;
     }
-    
+
     std::string line;
     while (std::getline(file, line)) {
         // Skip comments and empty lines
         if (line.empty() || line[0] == '#') {
             continue;
         }
-        
+
         // Parse key=value pairs
         size_t pos = line.find('=');
         if (pos == std::string::npos) {
             continue;
         }
-        
-        std::string key = line.substr(0, pos);
-        std::string value = line.substr(pos + 1);
-        
-        // Parse known configuration keys
-        if (key == "cache_size") {
-            cache_size = std::stoi(value);
-        } else if (key == "bpm_tolerance") {
-            bpm_tolerance = std::stoi(value);
-        } else if (key == "auto_sync") {
-            auto_sync = (value == "true");
+
+        TextView key(line.data(), pos);
+        TextView value(line.data() + pos + 1, line.size() - pos - 1);
+
+        // Parse known configuration keys straight into their typed field
+        const ConfigKey id = ConfigKeys::lookup(key);
+        if (id == ConfigKey::LibraryTrack) {
+            continue;
+        }
+        if (id != ConfigKey::Unknown) {
+            if (!kSettingBindings[static_cast<size_t>(id)].set(settings, value)) {
+                std::cerr << "[WARNING] Invalid value for " << key.str() << ": " << value.str() << std::endl;
+            }
         } else {
             // Store unknown settings for extensibility
-            additional_settings[key] = value;
+            additional_settings[key.str()] = value.str();
         }
     }
-    
+
     return true;
 }
 
@@ -55,10 +76,10 @@ std::string ConfigurationManager::getSetting(const std::string& key) const {
 
 void ConfigurationManager::displayConfiguration() const {
     std::cout << "=== DJ System Configuration ===" << std::endl;
-    std::cout << "Cache Size: " << cache_size << " slots" << std::endl;
-    std::cout << "BPM Tolerance: " << bpm_tolerance << " BPM" << std::endl;
-    std::cout << "Auto Sync: " << (auto_sync ? "enabled" : "disabled") << std::endl;
-    
+    std::cout << "Cache Size: " << settings.cache_size << " slots" << std::endl;
+    std::cout << "BPM Tolerance: " << settings.bpm_tolerance << " BPM" << std::endl;
+    std::cout << "Auto Sync: " << (settings.auto_sync ? "enabled" : "disabled") << std::endl;
+
     if (!additional_settings.empty()) {
         std::cout << "Additional Settings:" << std::endl;
         for (const auto& setting : additional_settings) {
@@ -5,7 +5,7 @@
 #include <memory>
 
 DJControllerService::DJControllerService(size_t cache_size)
-    : cache(cache_size) {}
+    : cache(cache_size), tracer(nullptr) {}
 /**
  * TODO: Implement loadTrackToCache method
  */
@@ -17,7 +17,11 @@ int DJControllerService::loadTrackToCache(AudioTrack& track) {
     }
 
     //MISS
-    PointerWrapper<AudioTrack> clone = track.clone();
+    PointerWrapper<AudioTrack> clone;
+    {
+        LatencyTracer::Scope timer(tracer, LatencyTracer::CACHE_CLONE);
+        clone = track.clone();
+    }
     //Clone failure 
     if (!clone) {
         std::cout << "[ERROR] Track: " <<track.get_title() <<" failed to clone"<<std::endl;
@@ -28,10 +32,20 @@ int DJControllerService::loadTrackToCache(AudioTrack& track) {
     if(clone_unwrapped==nullptr){
         throw std::runtime_error("Null pointer!");
     }
-    clone_unwrapped->load();
-    clone_unwrapped->analyze_beatgrid();
+    {
+        LatencyTracer::Scope timer(tracer, LatencyTracer::CACHE_LOAD);
+        clone_unwrapped->load();
+    }
+    {
+        LatencyTracer::Scope timer(tracer, LatencyTracer::CACHE_ANALYZE);
+        clone_unwrapped->analyze_beatgrid();
+    }
     PointerWrapper <AudioTrack> clone2(clone_unwrapped);
-    bool is_evicted=cache.put(std::move(clone2));
+    bool is_evicted;
+    {
+        LatencyTracer::Scope timer(tracer, LatencyTracer::CACHE_FILL);
+        is_evicted=cache.put(std::move(clone2));
+    }
     if(is_evicted){
         return -1;
     }
@@ -54,3 +68,7 @@ void DJControllerService::displayCacheStatus() const {
 AudioTrack* DJControllerService::getTrackFromCache(const std::string& track_title) {
     return cache.get(track_title);
 }
+
+bool DJControllerService::removeTrackFromCache(const std::string& track_title) {
+    return cache.remove(track_title);
+}
@@ -1,19 +1,27 @@
 #include "DJLibraryService.h"
 #include "SessionFileParser.h"
-#include "MP3Track.h"
-#include "WAVTrack.h"
+#include "PlaylistReader.h"
+#include "LibrarySnapshot.h"
+#include <algorithm>
 #include <iostream>
 #include <memory>
 #include <filesystem>
+#include <map>
+#include <utility>
 
 
 DJLibraryService::DJLibraryService(const Playlist& playlist) 
-    : playlist(playlist), library() {}
+    : playlist(playlist), catalog(), library(), bpm_index(), track_table(), artist_index(), title_search(),
+      fingerprint_index(), bpm_indexed(0), table_indexed(0), artist_indexed(0), search_indexed(0),
+      fingerprint_indexed(0), recordings(), collapse_duplicates(false), paged(), paged_tracks(),
+      version_epochs(), published(version_epochs), versioning(false), version_tracks(), dirty_rows(),
+      playlist_rows(), version_number(0) {}
 
 DJLibraryService::~DJLibraryService(){
     for(size_t i=0;i<library.size();i++){
         delete library[i];
     }
+    release_paged_tracks(paged_tracks);
 }
 
 /**
@@ -22,20 +30,351 @@ DJLibraryService::~DJLibraryService(){
  */
 void DJLibraryService::buildLibrary(const std::vector<SessionConfig::TrackInfo>& library_tracks) {
     for(const SessionConfig::TrackInfo& info : library_tracks){
-        AudioTrack* track=nullptr;
-        if(info.type== "MP3"){
-            track = new MP3Track(info.title, info.artists, info.duration_seconds, info.bpm, info.extra_param1, info.extra_param2); 
+        add_library_track(info.type, info.title, info.artists, info.duration_seconds, info.bpm,
+                          info.extra_param1, info.extra_param2);
+    }
+     std::cout<< "[INFO] Track library built: " << library_tracks.size() << " tracks loaded"<<std::endl;
+    publish_version();
+}
+
+
+size_t DJLibraryService::add_library_track(const std::string& type, const std::string& title,
+                                           const std::vector<std::string>& artists, int duration,
+                                           int bpm, int extra_param1, int extra_param2) {
+    return catalog.add(type, title, artists, duration, bpm, extra_param1, extra_param2);
+}
+
+void DJLibraryService::sync_bpm_index() const {
+    for (; bpm_indexed < catalog.size(); ++bpm_indexed) {
+        bpm_index.add(bpm_indexed, catalog.bpm(bpm_indexed), catalog.quality(bpm_indexed));
+    }
+}
+
+void DJLibraryService::sync_track_table() const {
+    for (; table_indexed < catalog.size(); ++table_indexed) {
+        const size_t row = table_indexed;
+        track_table.add(catalog.artists(row), catalog.bpm(row), catalog.duration(row),
+                        catalog.is_mp3(row) ? TrackTable::FORMAT_MP3 : TrackTable::FORMAT_WAV, catalog.quality(row));
+    }
+}
+
+void DJLibraryService::sync_artist_index() const {
+    for (; artist_indexed < catalog.size(); ++artist_indexed) {
+        const size_t row = artist_indexed;
+        for (const uint32_t* id = catalog.artist_ids_begin(row); id != catalog.artist_ids_end(row); ++id) {
+            artist_index.add(*id, row);
         }
-        //else- WAV track
-        else{
-            track = new WAVTrack(info.title, info.artists, info.duration_seconds, info.bpm, info.extra_param1, info.extra_param2); 
+    }
+}
+
+void DJLibraryService::sync_title_search() const {
+    for (; search_indexed < catalog.size(); ++search_indexed) {
+        title_search.add(search_indexed, search_text(search_indexed));
+    }
+}
+
+void DJLibraryService::sync_fingerprint_index() const {
+    for (; fingerprint_indexed < catalog.size(); ++fingerprint_indexed) {
+        const size_t row = fingerprint_indexed;
+        // A track that is already materialized carries its fingerprint; others are computed without one
+        const bool built = row < library.size() && library[row] != nullptr;
+        fingerprint_index.add(row, built ? library[row]->get_fingerprint() : catalog.fingerprint(row));
+    }
+}
+
+const std::vector<uint32_t>& DJLibraryService::recording_rows() const {
+    if (recordings.size() == catalog.size()) return recordings;
+    sync_fingerprint_index();
+    recordings.resize(catalog.size());
+    for (size_t row = 0; row < recordings.size(); ++row) recordings[row] = static_cast<uint32_t>(row);
+    // The fingerprint only reflects the title (bracketed tags dropped) and the lead artist, so
+    // "X (Radio Edit)" and "X (Extended Mix)" share a group; only copies that also agree on the
+    // configured bpm and duration play as one, or the set would use the wrong tempo and length
+    for (const std::vector<size_t>& group : fingerprint_index.groups()) {
+        std::map<std::pair<int, int>, size_t> kept_by_timing;
+        for (size_t row : group) {
+            const std::pair<int, int> timing(catalog.bpm(row), catalog.duration(row));
+            std::map<std::pair<int, int>, size_t>::iterator kept = kept_by_timing.insert(std::make_pair(timing, row)).first;
+            if (catalog.quality(row) > catalog.quality(kept->second)) kept->second = row;
+        }
+        for (size_t row : group) {
+            recordings[row] = static_cast<uint32_t>(kept_by_timing[std::make_pair(catalog.bpm(row), catalog.duration(row))]);
         }
-            library.push_back(track);
-            
     }
-     std::cout<< "[INFO] Track library built: " << library_tracks.size() << " tracks loaded"<<std::endl;
+    return recordings;
+}
+
+std::string DJLibraryService::search_text(size_t row) const {
+    std::string text = catalog.title(row);
+    for (const uint32_t* id = catalog.artist_ids_begin(row); id != catalog.artist_ids_end(row); ++id) {
+        text += ' ';
+        text.append(catalog.artist_pool().data(*id), catalog.artist_pool().length(*id));
+    }
+    return text;
+}
+
+std::vector<std::string> DJLibraryService::reloadLibrary(const std::vector<SessionConfig::TrackInfo>& library_tracks) {
+    std::vector<std::string> stale_titles;
+    bool dropped_track = false;
+    size_t updated = 0;
+
+    const size_t kept = std::min(library_tracks.size(), catalog.size());
+    for (size_t row = 0; row < kept; ++row) {
+        const SessionConfig::TrackInfo& info = library_tracks[row];
+        if (catalog.matches(row, info.type, info.title, info.artists, info.duration_seconds, info.bpm,
+                            info.extra_param1, info.extra_param2)) {
+            continue;
+        }
+        stale_titles.push_back(catalog.title(row));
+        update_row(row, info);
+        dropped_track |= forget_track(row);
+        ++updated;
+    }
+
+    const size_t retired = catalog.size() - kept;
+    for (size_t row = catalog.size(); row-- > kept;) {
+        stale_titles.push_back(catalog.title(row));
+        retire_row(row);
+        dropped_track |= forget_track(row);
+    }
+    if (retired > 0) {
+        catalog.truncate(kept);
+        if (library.size() > kept) library.resize(kept);
+        if (table_indexed > kept) track_table.truncate(kept);
+        bpm_indexed = std::min(bpm_indexed, kept);
+        table_indexed = std::min(table_indexed, kept);
+        artist_indexed = std::min(artist_indexed, kept);
+        search_indexed = std::min(search_indexed, kept);
+        fingerprint_indexed = std::min(fingerprint_indexed, kept);
+    }
+
+    // New rows are indexed lazily, like any freshly built library
+    for (size_t i = kept; i < library_tracks.size(); ++i) {
+        const SessionConfig::TrackInfo& info = library_tracks[i];
+        add_library_track(info.type, info.title, info.artists, info.duration_seconds, info.bpm,
+                          info.extra_param1, info.extra_param2);
+    }
+
+    // The playlist may point at tracks that were just deleted; it is rebuilt on the next load
+    if (dropped_track && !playlist.is_empty()) {
+        playlist = Playlist(playlist.get_name());
+        playlist_rows.clear();
+    }
+    publish_version();
+
+    std::cout << "[INFO] Track library reloaded: " << (library_tracks.size() - kept) << " added, " << updated
+              << " updated, " << retired << " retired, " << (kept - updated) << " unchanged" << std::endl;
+    return stale_titles;
+}
+
+void DJLibraryService::update_row(size_t row, const SessionConfig::TrackInfo& info) {
+    const int old_bpm = catalog.bpm(row);
+    const double old_quality = catalog.quality(row);
+    std::vector<uint32_t> old_artists(catalog.artist_ids_begin(row), catalog.artist_ids_end(row));
+    const std::string old_text = row < search_indexed ? search_text(row) : std::string();
+
+    catalog.set(row, info.type, info.title, info.artists, info.duration_seconds, info.bpm,
+                info.extra_param1, info.extra_param2);
+
+    if (row < bpm_indexed && (catalog.bpm(row) != old_bpm || catalog.quality(row) != old_quality)) {
+        bpm_index.remove(row, old_bpm, old_quality);
+        bpm_index.add(row, catalog.bpm(row), catalog.quality(row));
+    }
+    if (row < table_indexed) {
+        track_table.set(row, catalog.artists(row), catalog.bpm(row), catalog.duration(row),
+                        catalog.is_mp3(row) ? TrackTable::FORMAT_MP3 : TrackTable::FORMAT_WAV, catalog.quality(row));
+    }
+    if (row < artist_indexed) {
+        std::vector<uint32_t> new_artists(catalog.artist_ids_begin(row), catalog.artist_ids_end(row));
+        for (uint32_t id : old_artists) {
+            if (std::find(new_artists.begin(), new_artists.end(), id) == new_artists.end()) artist_index.remove(id, row);
+        }
+        for (uint32_t id : new_artists) artist_index.add(id, row);  // no-op for artists already credited
+    }
+    if (row < search_indexed) title_search.update(row, old_text, search_text(row));
+    if (row < fingerprint_indexed) fingerprint_index.add(row, catalog.fingerprint(row));
+    recordings.clear();
+    if (versioning) dirty_rows.push_back(static_cast<uint32_t>(row));
+}
+
+void DJLibraryService::retire_row(size_t row) {
+    if (row < bpm_indexed) bpm_index.remove(row, catalog.bpm(row), catalog.quality(row));
+    if (row < artist_indexed) {
+        for (const uint32_t* id = catalog.artist_ids_begin(row); id != catalog.artist_ids_end(row); ++id) {
+            artist_index.remove(*id, row);
+        }
+    }
+    if (row < search_indexed) title_search.remove(row, search_text(row));
+    if (row < fingerprint_indexed) fingerprint_index.remove(row);
+    recordings.clear();
+    // track_table is truncated by the caller
+}
+
+bool DJLibraryService::forget_track(size_t row) {
+    if (row >= library.size() || library[row] == nullptr) return false;
+    delete library[row];
+    library[row] = nullptr;
+    return true;
+}
+
+void DJLibraryService::reset_derived_state() {
+    // The playlist points at tracks that are about to be deleted
+    if (!playlist.is_empty()) playlist = Playlist(playlist.get_name());
+    playlist_rows.clear();
+    for (AudioTrack* track : library) delete track;
+    library.clear();
+    bpm_index.clear();
+    track_table.clear();
+    artist_index.clear();
+    title_search.clear();
+    fingerprint_index.clear();
+    recordings.clear();
+    bpm_indexed = table_indexed = artist_indexed = search_indexed = fingerprint_indexed = 0;
+    // Every row may differ: the next version is drafted from scratch
+    version_tracks = PersistentVector<SessionConfig::TrackInfo>();
+    dirty_rows.clear();
+}
+
+const EpochPublished<LibraryVersion>* DJLibraryService::versions() {
+    if (paged.is_open()) {
+        std::cout << "[ERROR] Library versions are not available with a paged catalog" << std::endl;
+        return nullptr;
+    }
+    if (!versioning) {
+        versioning = true;
+        publish_version();
+    }
+    return &published;
+}
+
+void DJLibraryService::publish_version() {
+    if (!versioning || paged.is_open()) return;
+    if (version_tracks.size() > catalog.size()) {
+        // Rows were retired and a PersistentVector cannot shrink: draft the rows again
+        version_tracks = PersistentVector<SessionConfig::TrackInfo>();
+    }
+    for (uint32_t row : dirty_rows) {
+        if (row < version_tracks.size()) version_tracks.set(row, catalog.info(row));
+    }
+    dirty_rows.clear();
+    while (version_tracks.size() < catalog.size()) version_tracks.push_back(catalog.info(version_tracks.size()));
+
+    // The draft is copied in O(1); its next edits clone the nodes this version now shares
+    LibraryVersion* next = new LibraryVersion();
+    next->number = ++version_number;
+    next->tracks = version_tracks;
+    next->playlist_name = playlist.get_name();
+    next->playlist_rows = playlist_rows;
+    published.publish(next);
+}
+
+bool DJLibraryService::saveSnapshot(const std::string& snapshot_path, const std::string& config_path,
+                                    const SessionConfig& config) const {
+    return LibrarySnapshot::save(snapshot_path, config_path, config, catalog);
+}
+
+bool DJLibraryService::loadSnapshot(const std::string& snapshot_path, const std::string& config_path,
+                                    SessionConfig& config) {
+    std::string reason;
+    if (!LibrarySnapshot::load(snapshot_path, config_path, config, catalog, reason)) {
+        std::cout << "[INFO] Library snapshot not used (" << reason << ")" << std::endl;
+        return false;
+    }
+    reset_derived_state();
+    std::cout << "[INFO] Track library restored from snapshot: " << catalog.size() << " tracks" << std::endl;
+    publish_version();
+    return true;
+}
+
+bool DJLibraryService::openPagedCatalog(const std::string& path, size_t pool_pages, std::string& reason) {
+    // Playlist entries may point at tracks of the catalog being replaced
+    if (!playlist.is_empty()) playlist = Playlist(playlist.get_name());
+    playlist_rows.clear();
+    release_paged_tracks(paged_tracks);
+    if (!paged.open(path, pool_pages, reason)) {
+        return false;
+    }
+    std::cout << "[INFO] Paged catalog opened: " << paged.size() << " tracks in " << paged.page_count()
+              << " pages, " << paged.memory_bytes() / 1024 << " KiB resident" << std::endl;
+    // Paged rows are not versioned (see versions())
+    versioning = false;
+    version_tracks = PersistentVector<SessionConfig::TrackInfo>();
+    dirty_rows.clear();
+    return true;
+}
+
+bool DJLibraryService::reloadPagedCatalog(const std::string& path, const std::string& config_path,
+                                          const std::vector<SessionConfig::TrackInfo>& library_tracks,
+                                          std::vector<std::string>& stale_titles) {
+    stale_titles.clear();
+    size_t updated = 0;
+    SessionConfig::TrackInfo stored;
+    const size_t kept = std::min(library_tracks.size(), paged.size());
+    for (size_t row = 0; row < paged.size(); ++row) {
+        if (!paged.read(row, stored)) {
+            // Without the stored row its cached copy cannot be judged; nothing has been changed yet
+            std::cout << "[ERROR] Cannot read paged catalog row " << row << ": " << path << std::endl;
+            stale_titles.clear();
+            return false;
+        }
+        if (row < kept) {
+            const SessionConfig::TrackInfo& info = library_tracks[row];
+            if ((stored.type == "MP3") == (info.type == "MP3") && stored.title == info.title
+                && stored.artists == info.artists && stored.duration_seconds == info.duration_seconds
+                && stored.bpm == info.bpm && stored.extra_param1 == info.extra_param1
+                && stored.extra_param2 == info.extra_param2) {
+                continue;
+            }
+            ++updated;
+        }
+        stale_titles.push_back(stored.title);
+    }
+    const size_t retired = paged.size() - kept;
+
+    // Pages are immutable: write the new file next to the open one, then swap
+    std::string reason;
+    // build() only renames the new file over the old one once it is complete
+    if (!PagedCatalog::build(path, config_path, library_tracks)) {
+        std::cout << "[ERROR] Cannot rebuild paged catalog: " << path << std::endl;
+        stale_titles.clear();
+        return false;
+    }
+    if (!openPagedCatalog(path, paged.capacity_pages(), reason)) {
+        std::cout << "[ERROR] Cannot reopen paged catalog: " << path << " (" << reason << ")" << std::endl;
+        return false;
+    }
+    std::cout << "[INFO] Paged catalog reloaded: " << (library_tracks.size() - kept) << " added, " << updated
+              << " updated, " << retired << " retired, " << (kept - updated) << " unchanged" << std::endl;
+    return true;
+}
+
+AudioTrack* DJLibraryService::paged_track_at(size_t row, std::unordered_map<size_t, AudioTrack*>& previous) {
+    auto found = paged_tracks.find(row);
+    if (found != paged_tracks.end()) return found->second;
+    AudioTrack* track = nullptr;
+    auto kept = previous.find(row);
+    if (kept != previous.end()) {
+        track = kept->second;
+        previous.erase(kept);
+    } else {
+        track = paged.materialize(row);
+    }
+    if (track) paged_tracks[row] = track;
+    return track;
+}
+
+void DJLibraryService::release_paged_tracks(std::unordered_map<size_t, AudioTrack*>& tracks) {
+    for (auto& entry : tracks) delete entry.second;
+    tracks.clear();
 }
 
+AudioTrack* DJLibraryService::track_at(size_t row) const {
+    if (row >= library.size()) library.resize(catalog.size(), nullptr);
+    if (!library[row]) {
+        library[row] = catalog.materialize(row);
+    }
+    return library[row];
+}
 
 /**
  * @brief Display the current state of the DJ library playlist
@@ -72,26 +411,42 @@ Playlist& DJLibraryService::getPlaylist() {
  * HINT: Leverage Playlist's find_track method
  */
 AudioTrack* DJLibraryService::findTrack(const std::string& track_title) {
-    return playlist.find_track(track_title);
+    AudioTrack* track = playlist.find_track(track_title);
+    if (track == nullptr && paged.is_open()) {
+        size_t row = paged.find_title(track_title);
+        std::unordered_map<size_t, AudioTrack*> none;
+        if (row != PagedCatalog::npos) track = paged_track_at(row, none);
+    }
+    return track;
 }
 
 void DJLibraryService::loadPlaylistFromIndices(const std::string& playlist_name, 
                                                const std::vector<int>& track_indices) {
     std::cout<< "[INFO] Loading playlist: " << playlist_name<<std::endl;
     playlist=Playlist(playlist_name);
+    playlist_rows.clear();
+    // Paged mode keeps only the tracks this playlist uses; the rest are freed below
+    std::unordered_map<size_t, AudioTrack*> previous;
+    previous.swap(paged_tracks);
+    const size_t rows = paged.is_open() ? paged.size() : catalog.size();
+    const bool collapse = collapse_duplicates && !paged.is_open();
     int counter=0;
+    size_t collapsed = 0;
     for(size_t index : track_indices){
-        if(index<= library.size() && index>=1){
-            AudioTrack* track=library[index-1];
-            PointerWrapper <AudioTrack> clone = track->clone();
-            if(!clone){
-                std:: cout << "[ERROR] Track:" <<track->get_title() << "failed to clone"<<std::endl;
+        if(index<= rows && index>=1){
+            size_t row = index-1;
+            if (collapse && recording_rows()[row] != row) {
+                row = recording_rows()[row];
+                ++collapsed;
+            }
+            // Entries point at the canonical library track; decks clone and load on their own
+            AudioTrack* track = paged.is_open() ? paged_track_at(row, previous) : track_at(row);
+            if (track == nullptr) {
+                std::cout << "[WARNING] Cannot read track: " << index << std::endl;
                 continue;
             }
-            clone.get()->load();
-            clone.get()->analyze_beatgrid();
-            std::string loaded_title = clone.get()->get_title();
-            playlist.add_track(clone.release());
+            playlist.add_track(track);
+            if (!paged.is_open()) playlist_rows.push_back(static_cast<uint32_t>(row));
             counter++;
         }
         else{
@@ -99,19 +454,113 @@ void DJLibraryService::loadPlaylistFromIndices(const std::string& playlist_name,
             continue;
         }
     }
+    release_paged_tracks(previous);
+    if (collapsed > 0) {
+        std::cout << "[INFO] Duplicate recordings collapsed: " << collapsed << " entries play the kept copy" << std::endl;
+    }
     std::cout << "[INFO] Playlist loaded: " << playlist_name << " (" << counter << " tracks)" << std::endl;
+    publish_version();
     
 }
 
+long DJLibraryService::importPlaylistFile(const std::string& playlist_path) {
+    std::string playlist_name = SessionFileParser::extract_playlist_name(playlist_path);
+    std::cout << "[INFO] Importing playlist: " << playlist_name << std::endl;
+
+    Playlist imported(playlist_name);
+    std::vector<uint32_t> imported_rows;
+    std::vector<std::string> artists(1);
+    long added = PlaylistReader::for_each(playlist_path, [&](const PlaylistReader::Record& record) {
+        size_t row = catalog.find_title(record.title);
+        if (row == LibraryCatalog::npos) {
+            artists[0] = record.artist;
+            row = add_library_track(record.type, record.title, artists, record.duration_seconds,
+                                    record.bpm, record.extra_param1, record.extra_param2);
+        }
+        imported.add_track(track_at(row));
+        imported_rows.push_back(static_cast<uint32_t>(row));
+    });
+    if (added < 0) {
+        std::cout << "[ERROR] Cannot open playlist file: " << playlist_path << std::endl;
+        return -1;
+    }
+
+    playlist = imported;
+    playlist_rows.swap(imported_rows);
+    std::cout << "[INFO] Playlist imported: " << playlist_name << " (" << added << " tracks)" << std::endl;
+    publish_version();
+    return added;
+}
+
 /**
  * TODO: Implement getTrackTitles method
  * @return Vector of track titles in the playlist
  */
 std::vector<std::string> DJLibraryService::getTrackTitles() const {
-    std::vector<std::string> titles;
-    std::vector<AudioTrack*> playlist_arr= playlist.getTracks();
-    for (auto it = playlist_arr.rbegin(); it != playlist_arr.rend(); ++it) {
-        titles.push_back((*it)->get_title());
+    return playlist.getTitles();
+}
+
+
+std::vector<AudioTrack*> DJLibraryService::findMixCandidates(int bpm, int tolerance, size_t limit) const {
+    std::vector<AudioTrack*> candidates;
+    sync_bpm_index();
+    for (size_t row : bpm_index.query(bpm, tolerance, limit)) {
+        candidates.push_back(track_at(row));
+    }
+    return candidates;
+}
+
+std::vector<AudioTrack*> DJLibraryService::queryLibrary(const TrackTable::Query& query, size_t limit) const {
+    std::vector<AudioTrack*> matches;
+    sync_track_table();
+    for (size_t row : track_table.select(query, limit)) {
+        matches.push_back(track_at(row));
+    }
+    return matches;
+}
+
+std::vector<AudioTrack*> DJLibraryService::findTracksByArtists(const std::vector<std::string>& artists,
+                                                               bool match_all) const {
+    std::vector<AudioTrack*> tracks;
+    std::vector<uint32_t> ids;
+    for (const std::string& name : artists) {
+        uint32_t id = catalog.artist_pool().find(name);
+        if (id != StringPool::npos) {
+            ids.push_back(id);
+        } else if (match_all) {
+            return tracks;  // nobody is credited to an artist the library has never seen
+        }
+    }
+    sync_artist_index();
+    for (size_t row : match_all ? artist_index.match_all(ids) : artist_index.match_any(ids)) {
+        tracks.push_back(track_at(row));
+    }
+    return tracks;
+}
+
+std::vector<std::vector<AudioTrack*>> DJLibraryService::findDuplicates() const {
+    std::vector<std::vector<AudioTrack*>> groups;
+    const std::vector<uint32_t>& kept = recording_rows();
+    for (const std::vector<size_t>& group : fingerprint_index.groups()) {
+        // A fingerprint group splits into one recording per kept row (see recording_rows)
+        std::map<uint32_t, std::vector<AudioTrack*>> copies;
+        for (size_t row : group) {
+            if (row != kept[row]) copies[kept[row]].push_back(track_at(row));
+        }
+        for (std::map<uint32_t, std::vector<AudioTrack*>>::value_type& recording : copies) {
+            std::vector<AudioTrack*> tracks(1, track_at(recording.first));
+            tracks.insert(tracks.end(), recording.second.begin(), recording.second.end());
+            groups.push_back(tracks);
+        }
+    }
+    return groups;
+}
+
+std::vector<AudioTrack*> DJLibraryService::searchLibrary(const std::string& query, size_t limit) const {
+    std::vector<AudioTrack*> tracks;
+    sync_title_search();
+    for (const TrigramIndex::Match& match : title_search.search(query, limit)) {
+        tracks.push_back(track_at(match.row));
     }
-    return titles;
+    return tracks;
 }
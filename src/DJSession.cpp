@@ -1,15 +1,45 @@
 
 #include "DJSession.h"
+#include "MappedFile.h"
+#include "TextView.h"
 #include <iostream>
 #include <algorithm>
 #include <sstream>
+#include <cstring>
 #include <dirent.h>
 
+namespace {
+const int kRenderSampleRate = 44100;
+const size_t kRenderChunkFrames = 1 << 16;  // 256 KiB of 16-bit stereo per write
+const char* const kConfigPath = "bin/dj_config.txt";
+const char* const kSnapshotSuffix = ".snap";
+const char* const kPagedSuffix = ".pages";
+const char* const kPlaylistDir = "playlists";
+const char* const kPlaylistSuffix = ".playlist";
+const size_t kPagedPoolPages = 256;  // 1 MiB of 4 KiB frames
+const size_t kLibraryResults = 10;   // tracks listed per menu library query
+const char* const kLibraryCommands = "/search <text>, /artist <name> [| or & <name>...], /bpm <low>-<high>, /mix";
+
+double ms_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+bool is_playlist_file(const std::string& name) {
+    const size_t suffix = std::strlen(kPlaylistSuffix);
+    return name.size() > suffix && name.compare(name.size() - suffix, suffix, kPlaylistSuffix) == 0;
+}
+}
+
 // ========== CONSTRUCTORS & RULE OF 5 ==========
 
 
 DJSession::DJSession(const std::string& name, bool play_all)
-    : session_name(name), library_service(),controller_service(),mixing_service(),config_manager(),session_config(),track_titles(),play_all(play_all),stats() {
+    : session_name(name), library_service(),controller_service(),mixing_service(),config_manager(),session_config(),track_titles(),track_positions(),play_all(play_all),plan_set_order(false),preload_next(false),
+      use_snapshot(false), library_restored(false), paged_catalog(false), collapse_duplicates(false),
+      config_size(0), config_mtime_ns(0),
+      watch_config(false), config_watcher(), watched_config(), watched_parse_ms(0), live_config(),
+      trace_latency(false), latency_json_path(), tracer(),
+      render_path(), render_writer(), render_buffer(), render_audio_seconds(0), render_started(), stats() {
     std::cout << "DJ Session System initialized: " << session_name << std::endl;
 }
 
@@ -25,6 +55,9 @@ bool DJSession::load_playlist(const std::string& playlist_name)  {
     // Find the playlist in the session config
     auto it = session_config.playlists.find(playlist_name);
     if (it == session_config.playlists.end()) {
+        if (is_playlist_file(playlist_name)) {
+            return load_playlist_file(playlist_name);
+        }
         std::cerr << "[ERROR] Playlist '" << playlist_name << "' not found in configuration.\n";
         return false;
     }
@@ -36,10 +69,78 @@ bool DJSession::load_playlist(const std::string& playlist_name)  {
         return false;
     }
     
-    track_titles = library_service.getTrackTitles();
+    use_loaded_playlist();
     return true;
 }
 
+bool DJSession::load_playlist_file(const std::string& playlist_path) {
+    if (library_service.isPaged()) {
+        std::cout << "[WARNING] .playlist files need the in-memory library; skipped with -C: " << playlist_path << std::endl;
+        return false;
+    }
+    if (library_service.importPlaylistFile(playlist_path) <= 0) {
+        return false;
+    }
+    use_loaded_playlist();
+    return true;
+}
+
+std::vector<std::string> DJSession::find_playlist_files() const {
+    std::vector<std::string> paths;
+    DIR* dir = opendir(kPlaylistDir);
+    if (dir == nullptr) {
+        return paths;
+    }
+    while (const dirent* entry = readdir(dir)) {
+        const std::string name = entry->d_name;
+        if (is_playlist_file(name)) {
+            paths.push_back(std::string(kPlaylistDir) + "/" + name);
+        }
+    }
+    closedir(dir);
+    std::sort(paths.begin(), paths.end());
+    return paths;
+}
+
+void DJSession::use_loaded_playlist() {
+    track_titles = library_service.getTrackTitles();
+    track_positions.resize(track_titles.size());
+    for (size_t i = 0; i < track_positions.size(); ++i) {
+        track_positions[i] = i;
+    }
+    if (plan_set_order) {
+        plan_track_order();
+    }
+}
+
+void DJSession::plan_track_order() {
+    std::vector<SetPlanner::Stop> stops;
+    stops.reserve(track_titles.size());
+    for (const std::string& title : track_titles) {
+        AudioTrack* track = library_service.findTrack(title);
+        stops.push_back(SetPlanner::Stop(title, track ? track->get_bpm() : 0));
+    }
+
+    SetPlanner::Options options;
+    options.bpm_tolerance = session_config.bpm_tolerance;
+    SetPlanner::Result plan = SetPlanner(options).plan(stops);
+
+    std::vector<std::string> planned;
+    std::vector<size_t> planned_positions;
+    planned.reserve(plan.order.size());
+    planned_positions.reserve(plan.order.size());
+    for (size_t idx : plan.order) {
+        planned.push_back(track_titles[idx]);
+        planned_positions.push_back(track_positions[idx]);
+    }
+    track_titles.swap(planned);
+    track_positions.swap(planned_positions);
+
+    std::cout << "[Planner] Transition cost: " << plan.cost_before << " -> " << plan.cost_after
+              << " (" << track_titles.size() << " tracks, " << plan.threads_used << " threads, "
+              << plan.elapsed_ms << " ms)" << std::endl;
+}
+
 /**
  * TODO: Implement load_track_to_controller method
  * 
@@ -64,7 +165,11 @@ bool DJSession::load_playlist(const std::string& playlist_name)  {
  */
 int DJSession::load_track_to_controller(const std::string& track_name) {
     // Your implementation here
-    AudioTrack* track= library_service.findTrack(track_name);
+    AudioTrack* track = nullptr;
+    {
+        LatencyTracer::Scope timer(trace_latency ? &tracer : nullptr, LatencyTracer::LIBRARY_LOOKUP);
+        track = library_service.findTrack(track_name);
+    }
     if(track==nullptr){
         std::cout << "[ERROR] Track: " << track_name <<" not found in library"<<std::endl;
         stats.errors++;
@@ -122,6 +227,14 @@ bool DJSession::load_track_to_mixer_deck(const std::string& track_title) {
     }
 }
 
+std::vector<AudioTrack*> DJSession::get_mix_candidates(size_t limit) const {
+    const AudioTrack* active = mixing_service.getActiveTrack();
+    if (active == nullptr) {
+        return std::vector<AudioTrack*>();
+    }
+    return library_service.findMixCandidates(active->get_bpm(), mixing_service.get_bpm_tolerance(), limit);
+}
+
 /**
  * @brief Main simulation loop that orchestrates the DJ performance session.
  * @note Updates session statistics (stats) throughout processing
@@ -136,8 +249,36 @@ void DJSession::simulate_dj_performance() {
         return;
     }
     
-    // 2. Build track library from config
-    library_service.buildLibrary(session_config.library_tracks);
+    // 2. Build track library from config (unless the snapshot already provided it)
+    if (paged_catalog) {
+        if (!open_paged_catalog()) {
+            std::cerr << "[ERROR] Failed to open the paged catalog. Aborting session." << std::endl;
+            return;
+        }
+    } else if (!library_restored) {
+        library_service.buildLibrary(session_config.library_tracks);
+        if (use_snapshot) {
+            save_library_snapshot();
+        }
+    }
+    if (collapse_duplicates) {
+        if (paged_catalog) {
+            std::cout << "[WARNING] Duplicate collapsing needs the in-memory library; ignored with -C" << std::endl;
+        } else {
+            library_service.setCollapseDuplicates(true);
+            report_duplicates();
+        }
+    }
+    
+    if (watch_config) {
+        std::string reason;
+        if (config_watcher.start(kConfigPath, reason)) {
+            std::cout << "[INFO] Watching " << kConfigPath << " for changes (applied at track boundaries)" << std::endl;
+        } else {
+            std::cout << "[WARNING] Cannot watch " << kConfigPath << ": " << reason
+                      << " (edits are picked up between playlists)" << std::endl;
+        }
+    }
     
     // 3. Get available playlists from config
     if (session_config.playlists.empty()) {
@@ -150,6 +291,11 @@ void DJSession::simulate_dj_performance() {
     std::cout << "Cache Capacity: " << session_config.controller_cache_size << " slots (LRU policy)" << std::endl;
     std::cout << "\n--- Processing Tracks ---" << std::endl;
 
+    if (!render_path.empty() && !start_render()) {
+        std::cerr << "[ERROR] Failed to open render output. Aborting session." << std::endl;
+        return;
+    }
+
     // Your implementation here
     if(play_all){
         std::vector<std::string> playlist_names;
@@ -158,18 +304,16 @@ void DJSession::simulate_dj_performance() {
         }
         
         std::sort(playlist_names.begin(), playlist_names.end());
+        const std::vector<std::string> playlist_files = find_playlist_files();
+        playlist_names.insert(playlist_names.end(), playlist_files.begin(), playlist_files.end());
         for(const std::string& pl_name : playlist_names){
+            reload_configuration_if_changed();
             if(!load_playlist(pl_name)){
                 std::cout << "[ERROR] failed loading " << pl_name << std::endl;
                 continue;
             }
 
-            for(std::string title : track_titles){
-                std::cout << "\n--- Processing: " << title << " ---" << std::endl;
-                stats.tracks_processed++;
-                load_track_to_controller(title);
-                load_track_to_mixer_deck(title);
-            }
+            play_loaded_playlist();
             print_session_summary();
         }
     //interactive mode
@@ -182,26 +326,118 @@ void DJSession::simulate_dj_performance() {
                 play=false;
             }
             else{
+                // Pick up config edits made while the menu was waiting
+                reload_configuration_if_changed();
                 if(!load_playlist(input)){
                     std:: cout <<"[ERROR] faild loading"<<std::endl;
                 }
                 else{
-                    for(std::string title: track_titles){
-                        std::cout << "\n--- Processing: " << title << " ---" << std::endl;
-                        stats.tracks_processed++;
-
-                        load_track_to_controller(title);
-                        load_track_to_mixer_deck(title);
-
-                    }
+                    play_loaded_playlist();
                     print_session_summary();
                     stats=SessionStats();
+                    mixing_service.resetTransitionStats();
+                    tracer.reset();
                 }
             }
         }
     std::cout<< "Session cancelled by user or all playlistsplayed."<<std::endl;
     }
-    
+    if (render_writer.is_open()) {
+        finish_render();
+    }
+}
+
+void DJSession::set_latency_tracing(bool enabled, const std::string& json_path) {
+    trace_latency = enabled;
+    latency_json_path = json_path;
+    LatencyTracer* active = enabled ? &tracer : nullptr;
+    controller_service.set_tracer(active);
+    mixing_service.set_tracer(active);
+}
+
+void DJSession::play_loaded_playlist() {
+    for (size_t i = 0; i < track_titles.size(); ++i) {
+        if (config_watcher.is_running()) {
+            apply_watched_config();
+        }
+        play_track(i);
+    }
+}
+
+void DJSession::play_track(size_t position) {
+    const std::string& title = track_titles[position];
+    std::cout << "\n--- Processing: " << title << " ---" << std::endl;
+    stats.tracks_processed++;
+    load_track_to_controller(title);
+    bool live = load_track_to_mixer_deck(title);
+
+    // Auto-sync retunes the deck copy; remember it on this playlist entry, not the library track
+    const AudioTrack* active = mixing_service.getActiveTrack();
+    if (live && active != nullptr) {
+        Playlist& playlist = library_service.getPlaylist();
+        if (playlist.get_entry_bpm(track_positions[position]) != active->get_bpm()) {
+            playlist.set_bpm_override(track_positions[position], active->get_bpm());
+        }
+    }
+
+    // The next track gets prepared while this one plays (and renders, if enabled)
+    if (preload_next && position + 1 < track_titles.size()) {
+        AudioTrack* next = library_service.findTrack(track_titles[position + 1]);
+        if (next != nullptr) {
+            mixing_service.preloadTrack(*next);
+        }
+    }
+    if (live && render_writer.is_open()) {
+        render_active_deck();
+    }
+}
+
+bool DJSession::start_render() {
+    if (!render_writer.open(render_path, kRenderSampleRate, 2)) {
+        return false;
+    }
+    render_buffer.assign(kRenderChunkFrames * 2, 0);
+    render_audio_seconds = 0;
+    render_started = std::chrono::steady_clock::now();
+    if (session_config.default_crossfade_time < 0) {
+        std::cout << "[WARNING] default_crossfade_time must not be negative; rendering without crossfades" << std::endl;
+    }
+    mixing_service.enable_render(kRenderSampleRate, session_config.default_crossfade_time);
+    std::cout << "[Render] Streaming mix to " << render_path << " (" << kRenderSampleRate
+              << " Hz, 16-bit stereo)" << std::endl;
+    return true;
+}
+
+void DJSession::render_active_deck() {
+    const AudioTrack* track = mixing_service.getActiveTrack();
+    if (track == nullptr) {
+        return;
+    }
+    size_t frames_left = static_cast<size_t>(track->get_duration()) * kRenderSampleRate;
+    while (frames_left > 0) {
+        size_t frames = std::min(frames_left, kRenderChunkFrames);
+        mixing_service.render(render_buffer.data(), frames);
+        if (!render_writer.write(render_buffer.data(), frames * 2)) {
+            std::cout << "[ERROR] Render output failed; finishing early." << std::endl;
+            finish_render();
+            return;
+        }
+        frames_left -= frames;
+        render_audio_seconds += static_cast<double>(frames) / kRenderSampleRate;
+    }
+}
+
+void DJSession::finish_render() {
+    bool ok = render_writer.close();
+    double wall_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - render_started).count();
+    std::cout << "\n=== Offline Render ===" << std::endl;
+    std::cout << "Output: " << render_path << (ok ? "" : " (incomplete)") << std::endl;
+    std::cout << "Audio rendered: " << render_audio_seconds << " s" << std::endl;
+    std::cout << "Wall time: " << wall_seconds << " s" << std::endl;
+    if (render_audio_seconds > 0) {
+        std::cout << "Real-time factor: " << (wall_seconds / render_audio_seconds)
+                  << " (" << (render_audio_seconds / wall_seconds) << "x faster than real time)" << std::endl;
+    }
 }
 
 
@@ -211,11 +447,25 @@ void DJSession::simulate_dj_performance() {
  * @return: true if configuration loaded successfully; false on error
  */
 bool DJSession::load_configuration() {
-    const std::string config_path = "bin/dj_config.txt";
+    const std::string config_path = kConfigPath;
     
     std::cout << "Loading configuration from: " << config_path << std::endl;
+
+    // Stamp first: an edit made while parsing shows up as a change on the next check
+    if (!MappedFile::stat(config_path, config_size, config_mtime_ns)) {
+        config_size = 0;
+        config_mtime_ns = 0;
+    }
+    library_restored = false;
+    if (use_snapshot && !paged_catalog) {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        library_restored = library_service.loadSnapshot(config_path + kSnapshotSuffix, config_path, session_config);
+        if (library_restored) {
+            std::cout << "[INFO] Snapshot startup: " << ms_since(start) << " ms" << std::endl;
+        }
+    }
     
-    if (!SessionFileParser::parse_config_file(config_path, session_config)) {
+    if (!library_restored && !SessionFileParser::parse_config_file(config_path, session_config, 0)) {
         std::cerr << "[ERROR] Failed to parse configuration file: " << config_path << std::endl;
         return false;
     }
@@ -224,10 +474,256 @@ bool DJSession::load_configuration() {
     std::cout << "BPM Tolerance: " << session_config.bpm_tolerance << " BPM" << std::endl;
     std::cout << "Auto Sync: " << (session_config.auto_sync ? "enabled" : "disabled") << std::endl;
     std::cout << "Cache Size: " << session_config.controller_cache_size << " slots" << std::endl;
+    apply_settings();
+    return true;
+}
+
+void DJSession::apply_settings() {
     mixing_service.set_auto_sync(session_config.auto_sync);
     mixing_service.set_bpm_tolerance(session_config.bpm_tolerance);
+    mixing_service.set_crossfade(session_config.default_crossfade_time);
     //update cache size in LRUCache
     controller_service.set_cache_size(session_config.controller_cache_size);
+
+    ConfigurationManager::Settings settings;
+    settings.app_name = session_config.app_name;
+    settings.version = session_config.version;
+    settings.cache_size = session_config.controller_cache_size;
+    settings.default_crossfade_time = session_config.default_crossfade_time;
+    settings.bpm_tolerance = session_config.bpm_tolerance;
+    settings.auto_sync = session_config.auto_sync;
+    config_manager.setSettings(settings);
+}
+
+void DJSession::save_library_snapshot() {
+    const std::string snapshot_path = std::string(kConfigPath) + kSnapshotSuffix;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    if (library_service.saveSnapshot(snapshot_path, kConfigPath, session_config)) {
+        std::cout << "[INFO] Library snapshot written: " << snapshot_path << " (" << ms_since(start)
+                  << " ms)" << std::endl;
+    } else {
+        std::cout << "[WARNING] Could not write library snapshot: " << snapshot_path << std::endl;
+    }
+}
+
+bool DJSession::reload_configuration_if_changed() {
+    if (config_watcher.is_running()) {
+        // The watcher has already parsed (and validated) every edit
+        apply_watched_config();
+        if (!watched_config) {
+            return false;
+        }
+        std::unique_ptr<SessionConfig> fresh(std::move(watched_config));
+        std::cout << "\n[INFO] Applying library and playlist changes from: " << kConfigPath << std::endl;
+        return apply_reloaded_config(*fresh, watched_parse_ms);
+    }
+
+    uint64_t size = 0;
+    int64_t mtime_ns = 0;
+    if (!MappedFile::stat(kConfigPath, size, mtime_ns) || (size == config_size && mtime_ns == config_mtime_ns)) {
+        return false;
+    }
+    config_size = size;
+    config_mtime_ns = mtime_ns;
+
+    std::cout << "\n[INFO] Configuration changed on disk, reloading: " << kConfigPath << std::endl;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    SessionConfig fresh;
+    // Read rather than mapped: the file may be truncated by a save while it is parsed
+    if (!SessionFileParser::parse_config_file(kConfigPath, fresh, 0, std::cout)) {
+        std::cerr << "[ERROR] Failed to parse configuration file: " << kConfigPath
+                  << " (keeping the current session)" << std::endl;
+        return false;
+    }
+    // Same check as the -W watcher: a bad value or a config caught mid-save must not reach the session
+    std::string reason;
+    if (!SessionFileParser::validate_config(fresh, reason)) {
+        std::cout << "[WARNING] Configuration change rejected (" << reason << "); keeping the current session" << std::endl;
+        return false;
+    }
+    return apply_reloaded_config(fresh, ms_since(start));
+}
+
+bool DJSession::apply_reloaded_config(SessionConfig& fresh, double parse_ms) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    size_t dropped = 0;
+    std::vector<std::string> stale;
+    if (!paged_catalog) {
+        stale = library_service.reloadLibrary(fresh.library_tracks);
+    } else if (!library_service.reloadPagedCatalog(std::string(kConfigPath) + kPagedSuffix, kConfigPath,
+                                                   fresh.library_tracks, stale)) {
+        std::cerr << "[ERROR] Reload aborted (keeping the current session)" << std::endl;
+        return false;
+    }
+    for (const std::string& title : stale) {
+        if (controller_service.removeTrackFromCache(title)) ++dropped;
+    }
+    if (paged_catalog) {
+        std::vector<SessionConfig::TrackInfo>().swap(fresh.library_tracks);
+    }
+    // Playlists are only index lists, resolved against the library when one is loaded
+    session_config = std::move(fresh);
+    apply_settings();
+    std::cout << "[INFO] Reload applied: parse " << parse_ms << " ms, apply " << ms_since(start) << " ms, "
+              << dropped << " cached track(s) dropped" << std::endl;
+
+    if (use_snapshot && !paged_catalog) {
+        save_library_snapshot();
+    }
+    return true;
+}
+
+bool DJSession::apply_watched_config() {
+    ConfigWatcher::Update update;
+    if (!config_watcher.take(update)) {
+        return false;
+    }
+    std::cout << "\n[INFO] Configuration changed on disk: " << kConfigPath << std::endl;
+    std::cout << update.log;
+    if (!update.config) {
+        live_config.rejected++;
+        std::cout << "[WARNING] Configuration change rejected (" << update.rejected
+                  << "); keeping the current settings" << std::endl;
+        return false;
+    }
+
+    const SessionConfig& fresh = *update.config;
+    std::ostringstream changes;
+    if (fresh.bpm_tolerance != session_config.bpm_tolerance) {
+        changes << " bpm_tolerance " << session_config.bpm_tolerance << " -> " << fresh.bpm_tolerance << ";";
+    }
+    if (fresh.auto_sync != session_config.auto_sync) {
+        changes << " auto_sync " << (fresh.auto_sync ? "on" : "off") << ";";
+    }
+    if (fresh.controller_cache_size != session_config.controller_cache_size) {
+        changes << " cache " << session_config.controller_cache_size << " -> " << fresh.controller_cache_size
+                << " slots;";
+    }
+    if (fresh.default_crossfade_time != session_config.default_crossfade_time) {
+        changes << " crossfade " << session_config.default_crossfade_time << " -> " << fresh.default_crossfade_time
+                << " s;";
+    }
+    session_config.app_name = fresh.app_name;
+    session_config.version = fresh.version;
+    session_config.controller_cache_size = fresh.controller_cache_size;
+    session_config.default_crossfade_time = fresh.default_crossfade_time;
+    session_config.bpm_tolerance = fresh.bpm_tolerance;
+    session_config.auto_sync = fresh.auto_sync;
+    apply_settings();
+    config_size = update.size;
+    config_mtime_ns = update.mtime_ns;
+
+    const double latency_ms = ms_since(update.changed);
+    live_config.applied++;
+    live_config.total_ms += latency_ms;
+    live_config.max_ms = std::max(live_config.max_ms, latency_ms);
+    std::cout << "[INFO] Live settings applied:" << (changes.tellp() > 0 ? changes.str() : " no setting changed;")
+              << " parsed in " << update.parse_ms << " ms off the session thread, live " << latency_ms
+              << " ms after the change" << std::endl;
+
+    // Library and playlist edits wait for the next playlist boundary
+    watched_config = std::move(update.config);
+    watched_parse_ms = update.parse_ms;
+    return true;
+}
+
+void DJSession::report_duplicates() {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    const std::vector<std::vector<AudioTrack*>> groups = library_service.findDuplicates();
+    size_t copies = 0;
+    for (const std::vector<AudioTrack*>& group : groups) copies += group.size() - 1;
+    std::cout << "[INFO] Duplicate recordings: " << groups.size() << " recording(s) with " << copies
+              << " extra copies (" << ms_since(start) << " ms)" << std::endl;
+    for (const std::vector<AudioTrack*>& group : groups) {
+        std::cout << "  kept \"" << group[0]->get_title() << "\" <-";
+        for (size_t i = 1; i < group.size(); ++i) {
+            std::cout << (i > 1 ? ", \"" : " \"") << group[i]->get_title() << "\"";
+        }
+        std::cout << std::endl;
+    }
+}
+
+void DJSession::run_library_command(const std::string& input) {
+    std::stringstream ss(input);
+    std::string command;
+    std::string argument;
+    ss >> command;
+    std::getline(ss >> std::ws, argument);
+    if (library_service.isPaged()) {
+        std::cout << "[WARNING] Library queries need the in-memory library; not available with -C" << std::endl;
+        return;
+    }
+
+    std::vector<AudioTrack*> tracks;
+    if (command == "/search" && !argument.empty()) {
+        tracks = library_service.searchLibrary(argument, kLibraryResults);
+    } else if (command == "/artist" && !argument.empty()) {
+        const bool match_all = argument.find('&') != std::string::npos;
+        std::vector<std::string> artists;
+        std::stringstream names(argument);
+        std::string name;
+        while (std::getline(names, name, match_all ? '&' : '|')) {
+            const TextView trimmed = TextView(name.data(), name.size()).trim();
+            if (!trimmed.empty()) artists.push_back(std::string(trimmed.data(), trimmed.size()));
+        }
+        tracks = library_service.findTracksByArtists(artists, match_all);
+    } else if (command == "/bpm") {
+        std::stringstream range(argument);
+        int low = 0;
+        int high = 0;
+        char dash = 0;
+        if (!(range >> low >> dash >> high) || dash != '-' || low > high) {
+            std::cout << "Usage: /bpm <low>-<high>" << std::endl;
+            return;
+        }
+        tracks = library_service.queryLibrary(TrackTable::Query().bpm_between(low, high), kLibraryResults);
+    } else if (command == "/mix" && argument.empty()) {
+        if (mixing_service.getActiveTrack() == nullptr) {
+            std::cout << "[INFO] No deck is live yet; play a playlist first" << std::endl;
+            return;
+        }
+        tracks = get_mix_candidates(kLibraryResults);
+    } else {
+        std::cout << "Unknown library command. Try " << kLibraryCommands << std::endl;
+        return;
+    }
+
+    std::cout << "[Library] " << tracks.size() << " track(s)" << std::endl;
+    for (const AudioTrack* track : tracks) {
+        std::cout << "  " << track->get_title() << " -";
+        const std::vector<std::string> artists = track->get_artists();
+        for (size_t i = 0; i < artists.size(); ++i) {
+            std::cout << (i ? ", " : " ") << artists[i];
+        }
+        std::cout << " (" << track->get_bpm() << " BPM, " << track->get_duration() << "s)" << std::endl;
+    }
+}
+
+bool DJSession::open_paged_catalog() {
+    const std::string path = std::string(kConfigPath) + kPagedSuffix;
+    std::string reason;
+    bool current = library_service.openPagedCatalog(path, kPagedPoolPages, reason);
+    if (current && (library_service.getPagedCatalog().source_size() != config_size
+                    || library_service.getPagedCatalog().source_mtime_ns() != config_mtime_ns)) {
+        current = false;
+        reason = "config changed since the catalog was written";
+    }
+    if (!current) {
+        std::cout << "[INFO] Paged catalog not used (" << reason << "), rebuilding: " << path << std::endl;
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        if (!PagedCatalog::build(path, kConfigPath, session_config.library_tracks)) {
+            std::cout << "[ERROR] Cannot write paged catalog: " << path << std::endl;
+            return false;
+        }
+        std::cout << "[INFO] Paged catalog written: " << session_config.library_tracks.size() << " tracks ("
+                  << ms_since(start) << " ms)" << std::endl;
+        if (!library_service.openPagedCatalog(path, kPagedPoolPages, reason)) {
+            std::cout << "[ERROR] Cannot open paged catalog: " << path << " (" << reason << ")" << std::endl;
+            return false;
+        }
+    }
+    // The parsed track list is not needed any more: the library lives on disk
+    std::vector<SessionConfig::TrackInfo>().swap(session_config.library_tracks);
     return true;
 }
 
@@ -244,12 +740,21 @@ std::string DJSession::display_playlist_menu_from_config() {
         playlist_names.push_back(pair.first);
     }
     std::sort(playlist_names.begin(), playlist_names.end());
+    const size_t config_playlists = playlist_names.size();
+    const std::vector<std::string> playlist_files = find_playlist_files();
+    playlist_names.insert(playlist_names.end(), playlist_files.begin(), playlist_files.end());
     
-    // Display numbered list
+    // Display numbered list; files show their name and path
     for (size_t i = 0; i < playlist_names.size(); ++i) {
-        std::cout << (i + 1) << ". " << playlist_names[i] << std::endl;
+        std::cout << (i + 1) << ". ";
+        if (i < config_playlists) {
+            std::cout << playlist_names[i] << std::endl;
+        } else {
+            std::cout << SessionFileParser::extract_playlist_name(playlist_names[i]) << " (" << playlist_names[i] << ")" << std::endl;
+        }
     }
     std::cout << "0. Cancel" << std::endl;
+    std::cout << "Library: " << kLibraryCommands << std::endl;
     
     // Prompt for user selection with validation
     int selection = -1;
@@ -261,6 +766,10 @@ std::string DJSession::display_playlist_menu_from_config() {
             std::cout << "\n[ERROR] Input error. Cancelling session." << std::endl;
             return "";
         }
+        if (!input.empty() && input[0] == '/') {
+            run_library_command(input);
+            continue;
+        }
         
         std::stringstream ss(input);
         if (ss >> selection && ss.eof()) {
@@ -289,5 +798,33 @@ void DJSession::print_session_summary() const {
     std::cout << "Deck B loads: " << stats.deck_loads_b << std::endl;
     std::cout << "Transitions: " << stats.transitions << std::endl;
     std::cout << "Errors: " << stats.errors << std::endl;
+    if (preload_next) {
+        const MixingEngineService::TransitionStats& t = mixing_service.getTransitionStats();
+        size_t total = t.preloaded + t.inline_loads;
+        std::cout << "Preloaded transitions: " << t.preloaded << "/" << total << std::endl;
+        std::cout << "Transition latency (request -> deck live): avg "
+                  << (total ? t.total_us / total : 0.0) << " us, max " << t.max_us << " us" << std::endl;
+    }
+    if (watch_config) {
+        std::cout << "Live config updates: " << live_config.applied << " applied, " << live_config.rejected
+                  << " rejected; change -> live avg "
+                  << (live_config.applied ? live_config.total_ms / live_config.applied : 0.0) << " ms, max "
+                  << live_config.max_ms << " ms" << std::endl;
+    }
+    if (library_service.isPaged()) {
+        const BufferPool::Stats& pool = library_service.getPagedCatalog().pool_stats();
+        std::cout << "Catalog page reads: " << pool.misses << " (" << pool.hits << " pool hits, "
+                  << pool.evictions << " evictions)" << std::endl;
+    }
+    if (trace_latency) {
+        tracer.print_summary(std::cout);
+        if (!latency_json_path.empty()) {
+            if (tracer.export_json(latency_json_path)) {
+                std::cout << "Latency histograms exported to " << latency_json_path << std::endl;
+            } else {
+                std::cout << "[ERROR] Cannot write latency histograms to " << latency_json_path << std::endl;
+            }
+        }
+    }
     std::cout << "=== Session Complete ===" << std::endl;
 }
\ No newline at end of file
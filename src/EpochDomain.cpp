@@ -0,0 +1,77 @@
+#include "EpochDomain.h"
+#include <stdexcept>
+
+const size_t EpochDomain::kMaxReaders;
+
+EpochDomain::EpochDomain() : global_epoch(1), slots(), retired_mutex(), retired() {
+    for (Slot& slot : slots) {
+        slot.claimed.store(false);
+        slot.pinned.store(0);
+    }
+}
+
+EpochDomain::~EpochDomain() {
+    for (auto& entry : retired) entry.second();
+}
+
+EpochDomain::Reader::Reader(EpochDomain& domain) : owner(domain), slot(kMaxReaders) {
+    for (size_t i = 0; i < kMaxReaders; ++i) {
+        bool expected = false;
+        if (owner.slots[i].claimed.compare_exchange_strong(expected, true)) {
+            slot = i;
+            return;
+        }
+    }
+    throw std::runtime_error("EpochDomain: too many reader threads");
+}
+
+EpochDomain::Reader::~Reader() {
+    owner.slots[slot].pinned.store(0);
+    owner.slots[slot].claimed.store(false);
+}
+
+EpochDomain::Guard::Guard(Reader& reader) : reader(reader) {
+    // Sequentially consistent, like the writer's exchange: either collect() sees this pin,
+    // or the load that follows sees the object published after the one being retired
+    reader.owner.slots[reader.slot].pinned.store(reader.owner.global_epoch.load());
+}
+
+EpochDomain::Guard::~Guard() {
+    reader.owner.slots[reader.slot].pinned.store(0, std::memory_order_release);
+}
+
+void EpochDomain::retire(std::function<void()> reclaim) {
+    std::lock_guard<std::mutex> lock(retired_mutex);
+    retired.push_back(std::make_pair(global_epoch.fetch_add(1), std::move(reclaim)));
+}
+
+size_t EpochDomain::collect() {
+    uint64_t oldest = global_epoch.load();
+    for (const Slot& slot : slots) {
+        const uint64_t pinned = slot.pinned.load();
+        if (pinned != 0 && pinned < oldest) oldest = pinned;
+    }
+
+    // Retired at e means unreachable for readers pinned after e; anyone pinned at or
+    // before e may still hold it
+    std::vector<std::function<void()>> ready;
+    {
+        std::lock_guard<std::mutex> lock(retired_mutex);
+        size_t kept = 0;
+        for (size_t i = 0; i < retired.size(); ++i) {
+            if (retired[i].first < oldest) {
+                ready.push_back(std::move(retired[i].second));
+            } else {
+                retired[kept++] = std::move(retired[i]);
+            }
+        }
+        retired.resize(kept);
+    }
+    for (std::function<void()>& reclaim : ready) reclaim();
+    return ready.size();
+}
+
+size_t EpochDomain::pending() const {
+    std::lock_guard<std::mutex> lock(retired_mutex);
+    return retired.size();
+}
@@ -0,0 +1,122 @@
+#include "FingerprintIndex.h"
+#include <algorithm>
+
+const size_t FingerprintIndex::kBands;
+const int FingerprintIndex::kMaxDistance;
+
+FingerprintIndex::FingerprintIndex() : buckets(), prints(), indexed(0) {}
+
+uint32_t FingerprintIndex::band_key(const AudioFingerprint& print, size_t band) {
+    // Neighbouring bits compare overlapping frame pairs and are correlated, so a band takes
+    // every kBands-th bit: bits band, band + kBands, band + 2 * kBands, ...
+    uint32_t value = 0;
+    for (size_t bit = band, k = 0; bit < AudioFingerprint::kBits; bit += kBands, ++k) {
+        value |= static_cast<uint32_t>((print.bits[bit / 64] >> (bit % 64)) & 1) << k;
+    }
+    return static_cast<uint32_t>(band << 16) | value;
+}
+
+void FingerprintIndex::add(size_t row, const AudioFingerprint& print) {
+    remove(row);
+    if (print.empty()) return;
+    if (row >= prints.size()) prints.resize(row + 1);
+    prints[row] = print;
+    ++indexed;
+    for (size_t band = 0; band < kBands; ++band) {
+        Postings& rows = buckets[band_key(print, band)];
+        if (rows.empty() || rows.back() < row) {
+            rows.push_back(static_cast<uint32_t>(row));
+        } else {
+            rows.insert(std::lower_bound(rows.begin(), rows.end(), static_cast<uint32_t>(row)), static_cast<uint32_t>(row));
+        }
+    }
+}
+
+void FingerprintIndex::remove(size_t row) {
+    if (row >= prints.size() || prints[row].empty()) return;
+    for (size_t band = 0; band < kBands; ++band) {
+        auto bucket = buckets.find(band_key(prints[row], band));
+        if (bucket == buckets.end()) continue;
+        Postings& rows = bucket->second;
+        auto pos = std::lower_bound(rows.begin(), rows.end(), static_cast<uint32_t>(row));
+        if (pos != rows.end() && *pos == row) rows.erase(pos);
+        if (rows.empty()) buckets.erase(bucket);
+    }
+    prints[row] = AudioFingerprint();
+    --indexed;
+}
+
+std::vector<size_t> FingerprintIndex::near(const AudioFingerprint& print, int max_distance) const {
+    std::vector<size_t> rows;
+    if (print.empty()) return rows;
+    for (size_t band = 0; band < kBands; ++band) {
+        auto bucket = buckets.find(band_key(print, band));
+        if (bucket == buckets.end()) continue;
+        for (uint32_t row : bucket->second) {
+            if (prints[row].distance(print) <= max_distance) rows.push_back(row);
+        }
+    }
+    // A row agreeing on several bands was collected once per band
+    std::sort(rows.begin(), rows.end());
+    rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+    return rows;
+}
+
+std::vector<std::vector<size_t>> FingerprintIndex::groups(int max_distance) const {
+    // Union-find over rows, path halving; the smaller row becomes the root
+    std::vector<uint32_t> parent(prints.size());
+    for (size_t row = 0; row < parent.size(); ++row) parent[row] = static_cast<uint32_t>(row);
+    auto find = [&parent](uint32_t row) {
+        while (parent[row] != row) {
+            parent[row] = parent[parent[row]];
+            row = parent[row];
+        }
+        return row;
+    };
+
+    // Only pairs sharing a bucket can be near, so each bucket is compared within itself
+    for (const auto& bucket : buckets) {
+        const Postings& rows = bucket.second;
+        for (size_t i = 0; i < rows.size(); ++i) {
+            for (size_t j = i + 1; j < rows.size(); ++j) {
+                if (prints[rows[i]].distance(prints[rows[j]]) > max_distance) continue;
+                uint32_t a = find(rows[i]);
+                uint32_t b = find(rows[j]);
+                if (a == b) continue;
+                if (a < b) parent[b] = a; else parent[a] = b;
+            }
+        }
+    }
+
+    std::vector<std::vector<size_t>> result;
+    std::vector<size_t> slot(prints.size(), static_cast<size_t>(-1));
+    std::vector<size_t> members(prints.size(), 0);
+    for (size_t row = 0; row < prints.size(); ++row) {
+        if (!prints[row].empty()) ++members[find(static_cast<uint32_t>(row))];
+    }
+    for (size_t row = 0; row < prints.size(); ++row) {
+        if (prints[row].empty()) continue;
+        const uint32_t root = find(static_cast<uint32_t>(row));
+        if (members[root] < 2) continue;
+        if (slot[root] == static_cast<size_t>(-1)) {
+            slot[root] = result.size();
+            result.push_back(std::vector<size_t>());
+        }
+        result[slot[root]].push_back(row);
+    }
+    return result;
+}
+
+size_t FingerprintIndex::memory_bytes() const {
+    size_t bytes = prints.capacity() * sizeof(AudioFingerprint)
+                 + buckets.bucket_count() * sizeof(void*)
+                 + buckets.size() * (sizeof(uint32_t) + sizeof(Postings) + 2 * sizeof(void*));
+    for (const auto& bucket : buckets) bytes += bucket.second.capacity() * sizeof(uint32_t);
+    return bytes;
+}
+
+void FingerprintIndex::clear() {
+    buckets.clear();
+    prints.clear();
+    indexed = 0;
+}
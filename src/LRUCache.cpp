@@ -49,6 +49,13 @@ bool LRUCache::evictLRU() {
     return true;
 }
 
+bool LRUCache::remove(const std::string& track_id) {
+    size_t idx = findSlot(track_id);
+    if (idx == max_size) return false;
+    slots[idx].clear();
+    return true;
+}
+
 size_t LRUCache::size() const {
     size_t count = 0;
     for (const auto& slot : slots) if (slot.isOccupied()) ++count;
@@ -0,0 +1,140 @@
+#include "LatencyTracer.h"
+#include <fstream>
+#include <iomanip>
+
+namespace {
+
+size_t bucket_for(uint64_t ns) {
+    size_t bucket = 0;
+    while (ns > 1 && bucket + 1 < LatencyTracer::kBuckets) {
+        ns >>= 1;
+        ++bucket;
+    }
+    return bucket;
+}
+
+uint64_t bucket_upper_ns(size_t bucket) {
+    return (static_cast<uint64_t>(1) << (bucket + 1)) - 1;
+}
+
+} // namespace
+
+LatencyTracer::Histogram::Histogram() : count(0), total_ns(0), min_ns(0), max_ns(0), buckets() {}
+
+void LatencyTracer::Histogram::add(uint64_t ns) {
+    if (count == 0 || ns < min_ns) min_ns = ns;
+    if (ns > max_ns) max_ns = ns;
+    ++count;
+    total_ns += ns;
+    ++buckets[bucket_for(ns)];
+}
+
+uint64_t LatencyTracer::Histogram::percentile_ns(double percentile) const {
+    if (count == 0) return 0;
+    uint64_t rank = static_cast<uint64_t>(percentile / 100.0 * (count - 1)) + 1;
+    uint64_t seen = 0;
+    for (size_t i = 0; i < kBuckets; ++i) {
+        seen += buckets[i];
+        if (seen >= rank) {
+            uint64_t upper = bucket_upper_ns(i);
+            return upper < max_ns ? upper : max_ns;
+        }
+    }
+    return max_ns;
+}
+
+LatencyTracer::Scope::Scope(LatencyTracer* tracer, Stage stage)
+    : tracer(tracer), stage(stage), start() {
+    if (tracer) start = std::chrono::steady_clock::now();
+}
+
+LatencyTracer::Scope::~Scope() {
+    if (tracer) {
+        std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::now() - start;
+        tracer->record(stage, static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+    }
+}
+
+LatencyTracer::LatencyTracer() : mutex(), histograms() {}
+
+void LatencyTracer::record(Stage stage, uint64_t nanoseconds) {
+    std::lock_guard<std::mutex> lock(mutex);
+    histograms[stage].add(nanoseconds);
+}
+
+LatencyTracer::Histogram LatencyTracer::get_histogram(Stage stage) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return histograms[stage];
+}
+
+void LatencyTracer::reset() {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (size_t i = 0; i < STAGE_COUNT; ++i) histograms[i] = Histogram();
+}
+
+const char* LatencyTracer::stage_name(Stage stage) {
+    switch (stage) {
+        case LIBRARY_LOOKUP:   return "library_lookup";
+        case CACHE_CLONE:      return "cache_clone";
+        case CACHE_LOAD:       return "cache_load";
+        case CACHE_ANALYZE:    return "cache_analyze";
+        case CACHE_FILL:       return "cache_fill";
+        case CLONE:            return "clone";
+        case LOAD:             return "load";
+        case ANALYZE_BEATGRID: return "analyze_beatgrid";
+        case BPM_SYNC:         return "bpm_sync";
+        case DECK_SWAP:        return "deck_swap";
+        default:               return "unknown";
+    }
+}
+
+void LatencyTracer::print_summary(std::ostream& out) const {
+    out << "Stage latency (us):" << std::endl;
+    for (size_t s = 0; s < STAGE_COUNT; ++s) {
+        Histogram h = get_histogram(static_cast<Stage>(s));
+        if (h.count == 0) continue;
+        out << "  " << std::left << std::setw(17) << stage_name(static_cast<Stage>(s)) << std::right
+            << " n=" << h.count << std::fixed << std::setprecision(1)
+            << "  mean " << h.mean_ns() / 1000.0
+            << "  p50 " << h.percentile_ns(50) / 1000.0
+            << "  p99 " << h.percentile_ns(99) / 1000.0
+            << "  max " << h.max_ns / 1000.0 << std::endl;
+        out.unsetf(std::ios::fixed);
+        out << std::setprecision(6) << "    ";
+        for (size_t b = 0; b < kBuckets; ++b) {
+            if (h.buckets[b] == 0) continue;
+            out << " <" << (bucket_upper_ns(b) + 1) / 1000.0 << "us:" << h.buckets[b];
+        }
+        out << std::endl;
+    }
+}
+
+bool LatencyTracer::export_json(const std::string& path) const {
+    std::ofstream file(path.c_str());
+    if (!file.is_open()) {
+        return false;
+    }
+    file << "{\n  \"stages\": [";
+    for (size_t s = 0; s < STAGE_COUNT; ++s) {
+        Histogram h = get_histogram(static_cast<Stage>(s));
+        file << (s ? "," : "") << "\n    {\"name\": \"" << stage_name(static_cast<Stage>(s)) << "\""
+             << ", \"count\": " << h.count
+             << ", \"total_ns\": " << h.total_ns
+             << ", \"min_ns\": " << h.min_ns
+             << ", \"max_ns\": " << h.max_ns
+             << ", \"p50_ns\": " << h.percentile_ns(50)
+             << ", \"p90_ns\": " << h.percentile_ns(90)
+             << ", \"p99_ns\": " << h.percentile_ns(99)
+             << ", \"buckets\": [";
+        bool first = true;
+        for (size_t b = 0; b < kBuckets; ++b) {
+            if (h.buckets[b] == 0) continue;
+            file << (first ? "" : ", ") << "{\"le_ns\": " << bucket_upper_ns(b) << ", \"count\": " << h.buckets[b] << "}";
+            first = false;
+        }
+        file << "]}";
+    }
+    file << "\n  ]\n}\n";
+    return file.good();
+}
@@ -0,0 +1,257 @@
+#include "LibraryCatalog.h"
+#include "LibrarySnapshot.h"
+#include "MP3Track.h"
+#include "WAVTrack.h"
+#include <cstring>
+#include <utility>
+
+LibraryCatalog::LibraryCatalog()
+    : titles(), artist_names(), title_ids(), artist_begins(), artist_ends(), artist_ids(), durations(), bpms(),
+      extra_param1(), extra_param2(), formats(), first_row_by_title(), title_rows(), unused_artist_ids(0) {}
+
+size_t LibraryCatalog::add(const std::string& type, const std::string& title,
+                           const std::vector<std::string>& artists, int duration, int bpm,
+                           int param1, int param2) {
+    size_t row = size();
+    uint32_t title_id = titles.intern(title);
+    note_title_row(title_id, row);
+    title_ids.push_back(title_id);
+    artist_begins.push_back(static_cast<uint32_t>(artist_ids.size()));
+    for (const std::string& artist : artists) {
+        artist_ids.push_back(artist_names.intern(artist));
+    }
+    artist_ends.push_back(static_cast<uint32_t>(artist_ids.size()));
+    durations.push_back(duration);
+    bpms.push_back(bpm);
+    extra_param1.push_back(param1);
+    extra_param2.push_back(param2);
+    formats.push_back(type == "MP3" ? FORMAT_MP3 : FORMAT_WAV);
+    return row;
+}
+
+void LibraryCatalog::set(size_t row, const std::string& type, const std::string& title,
+                         const std::vector<std::string>& artists, int duration, int bpm,
+                         int param1, int param2) {
+    uint32_t title_id = titles.intern(title);
+    if (title_id != title_ids[row]) {
+        const uint32_t old_id = title_ids[row];
+        title_ids[row] = title_id;
+        forget_title_row(old_id, row);
+        note_title_row(title_id, row);
+    }
+
+    const size_t span = artist_ends[row] - artist_begins[row];
+    if (artists.size() <= span) {
+        uint32_t k = artist_begins[row];
+        for (const std::string& artist : artists) artist_ids[k++] = artist_names.intern(artist);
+        artist_ends[row] = k;
+        unused_artist_ids += span - artists.size();
+    } else {
+        artist_begins[row] = static_cast<uint32_t>(artist_ids.size());
+        for (const std::string& artist : artists) artist_ids.push_back(artist_names.intern(artist));
+        artist_ends[row] = static_cast<uint32_t>(artist_ids.size());
+        unused_artist_ids += span;
+    }
+    reclaim_artist_ids();
+    durations[row] = duration;
+    bpms[row] = bpm;
+    extra_param1[row] = param1;
+    extra_param2[row] = param2;
+    formats[row] = type == "MP3" ? FORMAT_MP3 : FORMAT_WAV;
+}
+
+bool LibraryCatalog::matches(size_t row, const std::string& type, const std::string& title,
+                             const std::vector<std::string>& artists, int duration, int bpm,
+                             int param1, int param2) const {
+    if (durations[row] != duration || bpms[row] != bpm || extra_param1[row] != param1
+        || extra_param2[row] != param2 || formats[row] != (type == "MP3" ? FORMAT_MP3 : FORMAT_WAV)) {
+        return false;
+    }
+    const uint32_t title_id = title_ids[row];
+    if (titles.length(title_id) != title.size()
+        || std::memcmp(titles.data(title_id), title.data(), title.size()) != 0) {
+        return false;
+    }
+    if (artist_ends[row] - artist_begins[row] != artists.size()) return false;
+    const uint32_t* id = artist_ids_begin(row);
+    for (const std::string& artist : artists) {
+        if (artist_names.length(*id) != artist.size()
+            || std::memcmp(artist_names.data(*id), artist.data(), artist.size()) != 0) {
+            return false;
+        }
+        ++id;
+    }
+    return true;
+}
+
+void LibraryCatalog::truncate(size_t rows) {
+    if (rows >= size()) return;
+    for (size_t row = size(); row-- > rows;) {
+        // Rows after a title's first row are retired too, so no other row keeps it alive
+        const uint32_t title_id = title_ids[row];
+        --title_rows[title_id];
+        if (first_row_by_title[title_id] == row) first_row_by_title[title_id] = kNoRow;
+        unused_artist_ids += artist_ends[row] - artist_begins[row];
+    }
+    title_ids.resize(rows);
+    artist_begins.resize(rows);
+    artist_ends.resize(rows);
+    durations.resize(rows);
+    bpms.resize(rows);
+    extra_param1.resize(rows);
+    extra_param2.resize(rows);
+    formats.resize(rows);
+    reclaim_artist_ids();
+}
+
+void LibraryCatalog::reclaim_artist_ids() {
+    if (unused_artist_ids == 0 || unused_artist_ids <= artist_ids.size() / 2) return;
+    // Each repack follows at least size/2 abandoned entries, so it is amortized O(1) per entry
+    std::vector<uint32_t> packed;
+    packed.reserve(artist_ids.size() - unused_artist_ids);
+    const uint32_t* ids = artist_ids.data();
+    for (size_t row = 0; row < size(); ++row) {
+        const uint32_t begin = static_cast<uint32_t>(packed.size());
+        packed.insert(packed.end(), ids + artist_begins[row], ids + artist_ends[row]);
+        artist_begins[row] = begin;
+        artist_ends[row] = static_cast<uint32_t>(packed.size());
+    }
+    artist_ids.swap(packed);
+    unused_artist_ids = 0;
+}
+
+void LibraryCatalog::note_title_row(uint32_t title_id, size_t row) {
+    if (title_id == first_row_by_title.size()) {
+        first_row_by_title.push_back(static_cast<uint32_t>(row));
+        title_rows.push_back(1);
+        return;
+    }
+    ++title_rows[title_id];
+    if (first_row_by_title[title_id] == kNoRow || first_row_by_title[title_id] > row) {
+        first_row_by_title[title_id] = static_cast<uint32_t>(row);
+    }
+}
+
+void LibraryCatalog::forget_title_row(uint32_t title_id, size_t row) {
+    if (--title_rows[title_id] == 0) {
+        first_row_by_title[title_id] = kNoRow;
+        return;
+    }
+    if (first_row_by_title[title_id] != row) return;
+    // Another row still has this (duplicate) title; find the next one
+    const uint32_t* ids = title_ids.data();
+    size_t next = row + 1;
+    while (next < size() && ids[next] != title_id) ++next;
+    first_row_by_title[title_id] = next < size() ? static_cast<uint32_t>(next) : kNoRow;
+}
+
+size_t LibraryCatalog::find_title(const std::string& title) const {
+    uint32_t id = titles.find(title);
+    if (id == StringPool::npos || first_row_by_title[id] == kNoRow) return npos;
+    return first_row_by_title[id];
+}
+
+std::vector<std::string> LibraryCatalog::artists(size_t row) const {
+    std::vector<std::string> names;
+    names.reserve(artist_ends[row] - artist_begins[row]);
+    for (uint32_t k = artist_begins[row]; k < artist_ends[row]; ++k) {
+        names.push_back(artist_names.str(artist_ids[k]));
+    }
+    return names;
+}
+
+double LibraryCatalog::quality(size_t row) const {
+    return is_mp3(row) ? MP3Track::quality_for(extra_param1[row], extra_param2[row] != 0)
+                       : WAVTrack::quality_for(extra_param1[row], extra_param2[row]);
+}
+
+AudioTrack* LibraryCatalog::materialize(size_t row) const {
+    if (is_mp3(row)) {
+        return new MP3Track(title(row), artists(row), durations[row], bpms[row],
+                            extra_param1[row], extra_param2[row] != 0);
+    }
+    return new WAVTrack(title(row), artists(row), durations[row], bpms[row],
+                        extra_param1[row], extra_param2[row]);
+}
+
+AudioFingerprint LibraryCatalog::fingerprint(size_t row) const {
+    std::vector<double> samples(AudioTrack::kDefaultWaveformSamples);
+    AudioTrack::render_waveform(title(row), artists(row), samples.data(), samples.size());
+    if (is_mp3(row)) MP3Track::encode_lossy(samples.data(), samples.size(), extra_param1[row]);
+    return AudioFingerprint::compute(samples.data(), samples.size());
+}
+
+SessionConfig::TrackInfo LibraryCatalog::info(size_t row) const {
+    SessionConfig::TrackInfo track;
+    track.type = is_mp3(row) ? "MP3" : "WAV";
+    track.title = title(row);
+    track.artists = artists(row);
+    track.duration_seconds = durations[row];
+    track.bpm = bpms[row];
+    track.extra_param1 = extra_param1[row];
+    track.extra_param2 = extra_param2[row];
+    return track;
+}
+
+size_t LibraryCatalog::memory_bytes() const {
+    return titles.memory_bytes() + artist_names.memory_bytes() + title_ids.memory_bytes()
+         + artist_begins.memory_bytes() + artist_ends.memory_bytes() + artist_ids.memory_bytes() + first_row_by_title.memory_bytes()
+         + durations.memory_bytes() + bpms.memory_bytes() + extra_param1.memory_bytes()
+         + extra_param2.memory_bytes() + formats.memory_bytes() + title_rows.memory_bytes();
+}
+
+void LibraryCatalog::save(SnapshotWriter& out) const {
+    titles.save(out);
+    artist_names.save(out);
+    out.column(title_ids);
+    out.column(artist_begins);
+    out.column(artist_ends);
+    out.column(artist_ids);
+    out.column(durations);
+    out.column(bpms);
+    out.column(extra_param1);
+    out.column(extra_param2);
+    out.column(formats);
+    out.column(first_row_by_title);
+    out.column(title_rows);
+}
+
+bool LibraryCatalog::load(SnapshotReader& in) {
+    LibraryCatalog restored;
+    if (!restored.titles.load(in) || !restored.artist_names.load(in) || !in.column(restored.title_ids)
+        || !in.column(restored.artist_begins) || !in.column(restored.artist_ends) || !in.column(restored.artist_ids) || !in.column(restored.durations)
+        || !in.column(restored.bpms) || !in.column(restored.extra_param1) || !in.column(restored.extra_param2)
+        || !in.column(restored.formats) || !in.column(restored.first_row_by_title)
+        || !in.column(restored.title_rows)) {
+        return false;
+    }
+
+    // Every column must describe the same rows, and every id must resolve.
+    // Const access: validating must not copy the mapped columns.
+    const LibraryCatalog& view = restored;
+    const size_t rows = view.title_ids.size();
+    if (view.artist_begins.size() != rows || view.artist_ends.size() != rows || view.durations.size() != rows || view.bpms.size() != rows || view.extra_param1.size() != rows
+        || view.extra_param2.size() != rows || view.formats.size() != rows
+        || view.first_row_by_title.size() != view.titles.size() || view.title_rows.size() != view.titles.size()) {
+        return false;
+    }
+    for (size_t row = 0; row < rows; ++row) {
+        if (view.title_ids[row] >= view.titles.size() || view.artist_begins[row] > view.artist_ends[row]
+            || view.artist_ends[row] > view.artist_ids.size()) {
+            return false;
+        }
+    }
+    for (uint32_t id : view.artist_ids) {
+        if (id >= view.artist_names.size()) return false;
+    }
+    // Spans never overlap, so together they cover at most the whole artist column
+    size_t spanned = 0;
+    for (size_t row = 0; row < rows; ++row) spanned += view.artist_ends[row] - view.artist_begins[row];
+    if (spanned > view.artist_ids.size()) return false;
+    restored.unused_artist_ids = view.artist_ids.size() - spanned;
+    for (uint32_t row : view.first_row_by_title) {
+        if (row >= rows && row != kNoRow) return false;
+    }
+    *this = std::move(restored);
+    return true;
+}
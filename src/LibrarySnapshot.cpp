@@ -0,0 +1,131 @@
+#include "LibrarySnapshot.h"
+#include "LibraryCatalog.h"
+#include "MappedFile.h"
+#include "SessionFileParser.h"
+#include <cstdio>
+#include <fstream>
+#include <utility>
+
+namespace {
+
+const char kMagic[8] = {'D', 'J', 'L', 'I', 'B', 'S', 'N', 'P'};
+const uint32_t kByteOrderMark = 0x01020304u;
+
+} // namespace
+
+const uint32_t LibrarySnapshot::kVersion;
+
+bool LibrarySnapshot::save(const std::string& snapshot_path, const std::string& source_path,
+                           const SessionConfig& config, const LibraryCatalog& catalog) {
+    uint64_t source_size = 0;
+    int64_t source_mtime = 0;
+    if (!MappedFile::stat(source_path, source_size, source_mtime)) return false;
+
+    const std::string temp_path = snapshot_path + ".tmp";
+    {
+        std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) return false;
+        SnapshotWriter out(file);
+
+        out.value(kMagic);
+        out.value(kVersion);
+        out.value(kByteOrderMark);
+        out.value(source_size);
+        out.value(source_mtime);
+
+        out.string(config.app_name);
+        out.string(config.version);
+        out.value(static_cast<int32_t>(config.controller_cache_size));
+        out.value(static_cast<int32_t>(config.default_crossfade_time));
+        out.value(static_cast<int32_t>(config.bpm_tolerance));
+        out.value(static_cast<uint8_t>(config.auto_sync ? 1 : 0));
+
+        out.value(static_cast<uint64_t>(config.playlists.size()));
+        for (const auto& playlist : config.playlists) {
+            out.string(playlist.first);
+            out.column(playlist.second);
+        }
+
+        catalog.save(out);
+        file.flush();
+        if (!out.good()) {
+            file.close();
+            std::remove(temp_path.c_str());
+            return false;
+        }
+    }
+    // Readers never see a half-written snapshot
+    return std::rename(temp_path.c_str(), snapshot_path.c_str()) == 0;
+}
+
+bool LibrarySnapshot::load(const std::string& snapshot_path, const std::string& source_path,
+                           SessionConfig& config, LibraryCatalog& catalog, std::string& reason) {
+    std::shared_ptr<MappedFile> file = std::make_shared<MappedFile>();
+    if (!file->open(snapshot_path)) {
+        reason = "no snapshot";
+        return false;
+    }
+    uint64_t source_size = 0;
+    int64_t source_mtime = 0;
+    if (!MappedFile::stat(source_path, source_size, source_mtime)) {
+        reason = "config file missing";
+        return false;
+    }
+
+    SnapshotReader in(file, file->data(), file->size());
+    char magic[8];
+    uint32_t version = 0;
+    uint32_t byte_order = 0;
+    uint64_t recorded_size = 0;
+    int64_t recorded_mtime = 0;
+    if (!in.value(magic) || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0 || !in.value(version)
+        || !in.value(byte_order) || byte_order != kByteOrderMark) {
+        reason = "not a library snapshot";
+        return false;
+    }
+    if (version != kVersion) {
+        reason = "snapshot format version " + std::to_string(version) + ", expected " + std::to_string(kVersion);
+        return false;
+    }
+    if (!in.value(recorded_size) || !in.value(recorded_mtime)) {
+        reason = "snapshot truncated";
+        return false;
+    }
+    if (recorded_size != source_size || recorded_mtime != source_mtime) {
+        reason = "config changed since the snapshot was written";
+        return false;
+    }
+
+    SessionConfig restored;
+    int32_t cache_size = 0;
+    int32_t crossfade = 0;
+    int32_t tolerance = 0;
+    uint8_t auto_sync = 0;
+    uint64_t playlist_count = 0;
+    in.string(restored.app_name);
+    in.string(restored.version);
+    in.value(cache_size);
+    in.value(crossfade);
+    in.value(tolerance);
+    in.value(auto_sync);
+    in.value(playlist_count);
+    for (uint64_t i = 0; i < playlist_count && in.ok(); ++i) {
+        std::string name;
+        std::vector<int> indices;
+        if (in.string(name) && in.column(indices)) restored.playlists[name].swap(indices);
+    }
+
+    LibraryCatalog restored_catalog;
+    if (!in.ok() || !restored_catalog.load(in) || !in.at_end()) {
+        reason = "snapshot truncated or corrupt";
+        return false;
+    }
+
+    restored.controller_cache_size = cache_size;
+    restored.default_crossfade_time = crossfade;
+    restored.bpm_tolerance = tolerance;
+    restored.auto_sync = auto_sync != 0;
+    config = std::move(restored);
+    catalog = std::move(restored_catalog);
+    return true;
+}
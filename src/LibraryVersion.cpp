@@ -0,0 +1,13 @@
+#include "LibraryVersion.h"
+#include "MP3Track.h"
+#include "WAVTrack.h"
+
+AudioTrack* LibraryVersion::materialize(size_t row) const {
+    const SessionConfig::TrackInfo& track = tracks[row];
+    if (track.type == "MP3") {
+        return new MP3Track(track.title, track.artists, track.duration_seconds, track.bpm,
+                            track.extra_param1, track.extra_param2 != 0);
+    }
+    return new WAVTrack(track.title, track.artists, track.duration_seconds, track.bpm,
+                        track.extra_param1, track.extra_param2);
+}
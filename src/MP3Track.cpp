@@ -4,8 +4,11 @@
 #include <algorithm>
 
 MP3Track::MP3Track(const std::string& title, const std::vector<std::string>& artists, 
-                   int duration, int bpm, int bitrate, bool has_tags)
-    : AudioTrack(title, artists, duration, bpm), bitrate(bitrate), has_id3_tags(has_tags) {
+                   int duration, int bpm, int bitrate, bool has_tags, size_t waveform_samples)
+    : AudioTrack(title, artists, duration, bpm, waveform_samples, DeferFingerprint()), bitrate(bitrate),
+      has_id3_tags(has_tags) {
+    encode_lossy(waveform_data, waveform_size, bitrate);
+    fingerprint = AudioFingerprint::compute(waveform_data, waveform_size);
 
     std::cout << "MP3Track created: " << bitrate << " kbps" << std::endl;
 }
@@ -13,34 +16,37 @@ MP3Track::MP3Track(const std::string& title, const std::vector<std::string>& art
 // ========== TODO: STUDENTS IMPLEMENT THESE VIRTUAL FUNCTIONS ==========
 
 void MP3Track::load() {
-    std::cout << "[MP3Track::load] Loading MP3: \"" << title
+    *log_stream << "[MP3Track::load] Loading MP3: \"" << title
               << "\" at " << bitrate << " kbps...\n";
     // TODO: Implement MP3 loading with format-specific operations
     // NOTE: Use exactly 2 spaces before the arrow (→) character
     if(has_id3_tags)
-        std::cout << "  → Processing ID3 metadata (artist info, album art, etc.)..."<<std::endl;
+        *log_stream << "  → Processing ID3 metadata (artist info, album art, etc.)..."<<std::endl;
     else
-        std::cout << "  →No ID3 tags found."<<std::endl;
-    std::cout <<"  → Decoding MP3 frames..."<<std::endl;
-    std::cout <<"  → Load complete."<<std::endl;
+        *log_stream << "  →No ID3 tags found."<<std::endl;
+    *log_stream <<"  → Decoding MP3 frames..."<<std::endl;
+    *log_stream <<"  → Load complete."<<std::endl;
     
 }
 
 void MP3Track::analyze_beatgrid() {
-     std::cout << "[MP3Track::analyze_beatgrid] Analyzing beat grid for: \"" << title << "\"\n";
+     *log_stream << "[MP3Track::analyze_beatgrid] Analyzing beat grid for: \"" << title << "\"\n";
     // TODO: Implement MP3-specific beat detection analysis
     // NOTE: Use exactly 2 spaces before each arrow (→) character
     double beats_estimated = (duration_seconds / 60.0) *bpm;
     double precision_factor = bitrate / 320.0;
-    std::cout <<"  → Estimated beats: " << beats_estimated << "  → Compression precision factor: " <<precision_factor<<std::endl;
+    *log_stream <<"  → Estimated beats: " << beats_estimated << "  → Compression precision factor: " <<precision_factor<<std::endl;
 }
 
 double MP3Track::get_quality_score() const {
     // TODO: Implement comprehensive quality scoring
     // NOTE: This method does NOT print anything
+    return quality_for(bitrate, has_id3_tags);
+}
 
+double MP3Track::quality_for(int bitrate, bool has_tags) {
     double base_score=(bitrate / 320.0) * 100.0;
-    if(has_id3_tags)
+    if(has_tags)
         base_score=base_score+5;
     if(bitrate<128)
         base_score=base_score-10;
@@ -52,6 +58,13 @@ double MP3Track::get_quality_score() const {
     return base_score;
 }
 
+void MP3Track::encode_lossy(double* samples, size_t count, int bitrate) {
+    const double step = std::ldexp(1.0, -(std::max(bitrate, 32) / 32));
+    for (size_t i = 0; i < count; ++i) {
+        samples[i] = std::round(samples[i] / step) * step;
+    }
+}
+
 PointerWrapper<AudioTrack> MP3Track::clone() const {
     // TODO: Implement polymorphic cloning
     return PointerWrapper<AudioTrack>(new MP3Track(*this));
@@ -1,12 +1,17 @@
 #include "MixingEngineService.h"
 #include <iostream>
 #include <memory>
+#include <cmath>
+#include <chrono>
+#include <sstream>
 
 
 /**
  * TODO: Implement MixingEngineService constructor
  */
-MixingEngineService::MixingEngineService(): decks(),active_deck(1), auto_sync(false),bpm_tolerance(0)
+MixingEngineService::MixingEngineService(): decks(),active_deck(1), auto_sync(false),bpm_tolerance(0),
+    deck_waveforms(), playheads(), render_sample_rate(0), crossfade_seconds(0), frames_since_transition(0),
+    preload_job(), preload_title(), transition_stats(), tracer(nullptr)
 {
     decks[0]=nullptr;
     decks[1]=nullptr;
@@ -18,6 +23,9 @@ MixingEngineService::MixingEngineService(): decks(),active_deck(1), auto_sync(fa
  */
 MixingEngineService::~MixingEngineService() {
     std::cout <<"[MixingEngineService] Cleaning up decks...."<<std::endl;
+    if (preload_job.valid()) {
+        delete preload_job.get().track;
+    }
     if(decks[0]!=nullptr){
         delete decks[0];
         decks[0]=nullptr;
@@ -30,9 +38,14 @@ MixingEngineService::~MixingEngineService() {
 
 
 MixingEngineService::MixingEngineService(const MixingEngineService& other): decks(),
-    active_deck(other.active_deck), auto_sync(other.auto_sync), bpm_tolerance(other.bpm_tolerance) 
+    active_deck(other.active_deck.load()), auto_sync(other.auto_sync), bpm_tolerance(other.bpm_tolerance),
+    deck_waveforms(), playheads(), render_sample_rate(other.render_sample_rate),
+    crossfade_seconds(other.crossfade_seconds), frames_since_transition(other.frames_since_transition),
+    preload_job(), preload_title(), transition_stats(other.transition_stats), tracer(other.tracer)
 {
     for (size_t i = 0; i < 2; i++) {
+        deck_waveforms[i] = other.deck_waveforms[i];
+        playheads[i] = other.playheads[i];
         if (other.decks[i] != nullptr) {
             decks[i] = other.decks[i]->clone().release();
         } else {
@@ -43,14 +56,25 @@ MixingEngineService::MixingEngineService(const MixingEngineService& other): deck
 
 MixingEngineService& MixingEngineService::operator=(const MixingEngineService& other) {
     if (this == &other) return *this;
+    if (preload_job.valid()) {
+        delete preload_job.get().track;
+    }
+    preload_title.clear();
     for (size_t i = 0; i < 2; i++) {
         delete decks[i];
         decks[i] = nullptr;
     }
-    active_deck = other.active_deck;
+    active_deck = other.active_deck.load();
+    transition_stats = other.transition_stats;
+    tracer = other.tracer;
     auto_sync = other.auto_sync;
     bpm_tolerance = other.bpm_tolerance;
+    render_sample_rate = other.render_sample_rate;
+    crossfade_seconds = other.crossfade_seconds;
+    frames_since_transition = other.frames_since_transition;
     for (size_t i = 0; i < 2; i++) {
+        deck_waveforms[i] = other.deck_waveforms[i];
+        playheads[i] = other.playheads[i];
         if (other.decks[i] != nullptr) {
             decks[i] = other.decks[i]->clone().release();
         }
@@ -65,8 +89,15 @@ MixingEngineService& MixingEngineService::operator=(const MixingEngineService& o
  * @return: Index of the deck where track was loaded, or -1 on failure
  */
 int MixingEngineService::loadTrackToDeck(const AudioTrack& track) {
+        std::chrono::steady_clock::time_point requested = std::chrono::steady_clock::now();
     
-        PointerWrapper<AudioTrack> clone = track.clone();
+        std::string preload_log;
+        PointerWrapper<AudioTrack> clone = take_preloaded(track.get_title(), preload_log);
+        const bool preloaded = static_cast<bool>(clone);
+        if (!preloaded) {
+            LatencyTracer::Scope timer(tracer, LatencyTracer::CLONE);
+            clone = track.clone();
+        }
         std::cout << "\n=== Loading Track to Deck ==="<<std::endl;
 
         if (!clone) {
@@ -77,34 +108,54 @@ int MixingEngineService::loadTrackToDeck(const AudioTrack& track) {
         int target_deck=1-active_deck;
         std::cout << "[Deck Switch] Target deck: " <<target_deck<<std::endl;
     
-    //Unload target deck if occupied
-        if(decks[target_deck]!=nullptr){
-            delete decks[target_deck];
-            decks[target_deck]=nullptr;
+        if (preloaded) {
+            std::cout << "[Preload] '" << clone->get_title() << "' was loaded and analyzed in the background" << std::endl;
+            std::cout << preload_log;
+        } else {
+            {
+                LatencyTracer::Scope timer(tracer, LatencyTracer::LOAD);
+                clone->load();
+            }
+            LatencyTracer::Scope timer(tracer, LatencyTracer::ANALYZE_BEATGRID);
+            clone->analyze_beatgrid();
         }
-        clone->load();
-        clone->analyze_beatgrid();
 
     //BPM Management
-    if(decks[active_deck]!=nullptr && auto_sync){
-        if(!can_mix_tracks(clone)){
-            sync_bpm(clone);
+    {
+        LatencyTracer::Scope timer(tracer, LatencyTracer::BPM_SYNC);
+        if(decks[active_deck]!=nullptr && auto_sync){
+            if(!can_mix_tracks(clone)){
+                sync_bpm(clone);
+            }
+        }
+        else if (decks[active_deck] == nullptr && auto_sync) {
+            std::cout << "[Sync BPM] Cannot sync - one of the decks is empty." << std::endl;
         }
     }
-    else if (decks[active_deck] == nullptr && auto_sync) {
-        std::cout << "[Sync BPM] Cannot sync - one of the decks is empty." << std::endl;
+
+    //Instant Transition: install the new track on the target deck and flip the active deck
+    {
+        LatencyTracer::Scope timer(tracer, LatencyTracer::DECK_SWAP);
+        //Unload target deck if occupied
+        if(decks[target_deck]!=nullptr){
+            delete decks[target_deck];
+            decks[target_deck]=nullptr;
+        }
+        decks[target_deck]=clone.release();
+        if (render_sample_rate > 0) {
+            prepare_deck_for_render(target_deck);
+        }
+        active_deck.store(target_deck);
     }
-    
-    decks[target_deck]=clone.release();
     std::cout << "[Load Complete] '" << decks[target_deck]->get_title() << "' is now loaded on deck " << target_deck << std::endl;
-    
-    //Instant Transition
-    // if(decks[active_deck] != nullptr)
-    //     std::cout << "[Unload] Unloading previous deck " <<active_deck << " " <<track.get_title()<<std::endl;
-    // delete decks[active_deck];
-    // decks[active_deck]=nullptr;
 
-    active_deck=target_deck;
+    double latency_us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - requested).count();
+    transition_stats.last_us = latency_us;
+    transition_stats.total_us += latency_us;
+    if (latency_us > transition_stats.max_us) transition_stats.max_us = latency_us;
+    if (preloaded) transition_stats.preloaded++;
+    else transition_stats.inline_loads++;
+
     std::cout << "[Active Deck] Switched to deck " <<target_deck <<std::endl;
     return target_deck;
     
@@ -167,3 +218,111 @@ void MixingEngineService::sync_bpm(const PointerWrapper<AudioTrack>& track) cons
         }
     }
 }
+
+
+void MixingEngineService::preloadTrack(const AudioTrack& track) {
+    if (preload_job.valid()) {
+        delete preload_job.get().track;
+    }
+    preload_title = track.get_title();
+    AudioTrack* clone = nullptr;
+    {
+        LatencyTracer::Scope timer(tracer, LatencyTracer::CLONE);
+        clone = track.clone().release();
+    }
+    if (clone == nullptr) {
+        std::cout << "[ERROR] Track: " << preload_title << " failed to clone for preload" << std::endl;
+        preload_title.clear();
+        return;
+    }
+    LatencyTracer* worker_tracer = tracer;
+    preload_job = std::async(std::launch::async, [clone, worker_tracer]() {
+        PointerWrapper<AudioTrack> owned(clone);
+        std::ostringstream log;
+        owned->set_log_stream(&log);
+        {
+            LatencyTracer::Scope timer(worker_tracer, LatencyTracer::LOAD);
+            owned->load();
+        }
+        {
+            LatencyTracer::Scope timer(worker_tracer, LatencyTracer::ANALYZE_BEATGRID);
+            owned->analyze_beatgrid();
+        }
+        owned->set_log_stream(nullptr);
+        Preloaded done = { owned.release(), log.str() };
+        return done;
+    });
+}
+
+PointerWrapper<AudioTrack> MixingEngineService::take_preloaded(const std::string& title, std::string& log) {
+    if (!preload_job.valid()) {
+        return PointerWrapper<AudioTrack>();
+    }
+    Preloaded done = preload_job.get();
+    PointerWrapper<AudioTrack> ready(done.track);
+    bool matches = (preload_title == title);
+    preload_title.clear();
+    if (!matches) {
+        return PointerWrapper<AudioTrack>();
+    }
+    log.swap(done.log);
+    return ready;
+}
+
+void MixingEngineService::enable_render(int sample_rate, int crossfade) {
+    render_sample_rate = sample_rate;
+    set_crossfade(crossfade);
+}
+
+void MixingEngineService::prepare_deck_for_render(size_t deck) {
+    const AudioTrack* track = decks[deck];
+    deck_waveforms[deck].assign(track->get_waveform_size(), 0.0);
+    track->get_waveform_copy(deck_waveforms[deck].data(), deck_waveforms[deck].size());
+    playheads[deck] = 0.0;
+    frames_since_transition = 0;
+}
+
+double MixingEngineService::next_render_sample(size_t deck) {
+    const std::vector<double>& table = deck_waveforms[deck];
+    if (table.empty() || decks[deck] == nullptr) {
+        return 0.0;
+    }
+    const double size = static_cast<double>(table.size());
+    double pos = playheads[deck];
+    size_t i = static_cast<size_t>(pos);
+    double frac = pos - static_cast<double>(i);
+    double sample = table[i] + frac * (table[(i + 1) % table.size()] - table[i]);
+
+    // One pass over the wavetable per beat, so a synced BPM really changes the tempo
+    pos += size * decks[deck]->get_bpm() / (60.0 * render_sample_rate);
+    if (pos >= size) {
+        pos = std::fmod(pos, size);
+    }
+    playheads[deck] = pos;
+    return sample;
+}
+
+void MixingEngineService::render(int16_t* out, size_t frames) {
+    const size_t incoming = active_deck;
+    const size_t outgoing = 1 - active_deck;
+    const size_t crossfade_frames = static_cast<size_t>(crossfade_seconds) * render_sample_rate;
+
+    for (size_t f = 0; f < frames; ++f) {
+        double mix = 0.0;
+        double fade = 1.0;
+        if (frames_since_transition < crossfade_frames && decks[outgoing] != nullptr) {
+            fade = static_cast<double>(frames_since_transition) / crossfade_frames;
+            mix += (1.0 - fade) * next_render_sample(outgoing);
+        }
+        mix += fade * next_render_sample(incoming);
+        ++frames_since_transition;
+
+        // Half-scale headroom, then clamp to the 16-bit range
+        double scaled = mix * 0.5 * 32767.0;
+        if (scaled > 32767.0) scaled = 32767.0;
+        if (scaled < -32768.0) scaled = -32768.0;
+        int16_t sample = static_cast<int16_t>(scaled);
+        out[2 * f] = sample;
+        out[2 * f + 1] = sample;
+    }
+}
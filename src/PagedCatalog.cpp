@@ -0,0 +1,392 @@
+#include "PagedCatalog.h"
+#include "MappedFile.h"
+#include "MP3Track.h"
+#include "WAVTrack.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+const char kMagic[8] = {'D', 'J', 'P', 'A', 'G', 'E', 'D', 'C'};
+const uint32_t kByteOrderMark = 0x01020304u;
+const uint8_t kFormatMP3 = 1;
+const uint8_t kFormatWAV = 2;
+const size_t kIndexEntryBytes = sizeof(uint64_t) + sizeof(uint32_t);
+const size_t kIndexEntriesPerPage = (PagedCatalog::kPageSize - sizeof(uint32_t)) / kIndexEntryBytes;
+
+// Header page fields, in this order from offset 0
+struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint32_t page_size;
+    uint32_t reserved;
+    uint64_t source_size;
+    int64_t source_mtime;
+    uint64_t rows;
+    uint64_t record_pages;
+    uint64_t index_entries;
+    uint64_t index_pages;
+};
+
+template <typename T>
+void put(std::vector<char>& out, const T& value) {
+    const char* bytes = reinterpret_cast<const char*>(&value);
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+template <typename T>
+T get(const char* bytes) {
+    T value;
+    std::memcpy(&value, bytes, sizeof(T));
+    return value;
+}
+
+uint64_t pages_for(uint64_t bytes) {
+    return (bytes + PagedCatalog::kPageSize - 1) / PagedCatalog::kPageSize;
+}
+
+} // namespace
+
+const size_t PagedCatalog::kPageSize;
+const uint32_t PagedCatalog::kVersion;
+
+// ========== Writer ==========
+
+PagedCatalog::Writer::Writer()
+    : file(), path(), temp_path(), source_size(0), source_mtime(0), page(), offsets(), page_fill(0),
+      first_rows(), title_entries(), rows(0), failed(false) {}
+
+PagedCatalog::Writer::~Writer() {
+    // A writer that was never finished leaves nothing behind
+    if (file.is_open()) {
+        file.close();
+        std::remove(temp_path.c_str());
+    }
+}
+
+bool PagedCatalog::Writer::open(const std::string& output_path, uint64_t size, int64_t mtime_ns) {
+    path = output_path;
+    temp_path = output_path + ".tmp";
+    source_size = size;
+    source_mtime = mtime_ns;
+    file.open(temp_path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) return false;
+    page.reserve(kPageSize);
+    std::vector<char> header(kPageSize, 0);  // rewritten by finish()
+    write_page(header.data());
+    return !failed;
+}
+
+bool PagedCatalog::Writer::add(const SessionConfig::TrackInfo& track) {
+    if (failed || track.title.size() > 0xFFFF || track.artists.size() > 0xFF) return false;
+    std::vector<char> record;
+    put(record, track.type == "MP3" ? kFormatMP3 : kFormatWAV);
+    put(record, static_cast<int32_t>(track.duration_seconds));
+    put(record, static_cast<int32_t>(track.bpm));
+    put(record, static_cast<int32_t>(track.extra_param1));
+    put(record, static_cast<int32_t>(track.extra_param2));
+    put(record, static_cast<uint16_t>(track.title.size()));
+    record.insert(record.end(), track.title.begin(), track.title.end());
+    put(record, static_cast<uint8_t>(track.artists.size()));
+    for (const std::string& artist : track.artists) {
+        if (artist.size() > 0xFFFF) return false;
+        put(record, static_cast<uint16_t>(artist.size()));
+        record.insert(record.end(), artist.begin(), artist.end());
+    }
+
+    // Slot header: count + one offset per record, then the records
+    if (sizeof(uint16_t) * (offsets.size() + 2) + page_fill + record.size() > kPageSize) {
+        if (offsets.empty()) return false;  // larger than a page on its own
+        flush_page();
+        if (sizeof(uint16_t) * 2 + record.size() > kPageSize) return false;
+    }
+    if (offsets.empty()) first_rows.push_back(static_cast<uint32_t>(rows));
+    offsets.push_back(static_cast<uint16_t>(page_fill));
+    page.insert(page.end(), record.begin(), record.end());
+    page_fill += record.size();
+    title_entries.push_back(std::make_pair(hash(track.title), static_cast<uint32_t>(rows)));
+    ++rows;
+    return !failed;
+}
+
+void PagedCatalog::Writer::flush_page() {
+    if (offsets.empty()) return;
+    std::vector<char> out;
+    out.reserve(kPageSize);
+    const size_t header_bytes = sizeof(uint16_t) * (offsets.size() + 1);
+    put(out, static_cast<uint16_t>(offsets.size()));
+    for (uint16_t offset : offsets) put(out, static_cast<uint16_t>(offset + header_bytes));
+    out.insert(out.end(), page.begin(), page.end());
+    out.resize(kPageSize, 0);
+    write_page(out.data());
+    page.clear();
+    offsets.clear();
+    page_fill = 0;
+}
+
+void PagedCatalog::Writer::write_page(const char* bytes) {
+    file.write(bytes, kPageSize);
+    if (!file.good()) failed = true;
+}
+
+bool PagedCatalog::Writer::finish() {
+    if (!file.is_open()) return false;
+    flush_page();
+    const uint64_t record_pages = first_rows.size();
+
+    // Title index: one sorted run, ties by row so the first match is the first row
+    std::sort(title_entries.begin(), title_entries.end());
+    std::vector<uint64_t> fences;
+    std::vector<char> out;
+    for (size_t start = 0; start < title_entries.size(); start += kIndexEntriesPerPage) {
+        const size_t count = std::min(kIndexEntriesPerPage, title_entries.size() - start);
+        out.clear();
+        put(out, static_cast<uint32_t>(count));
+        for (size_t i = start; i < start + count; ++i) {
+            put(out, title_entries[i].first);
+            put(out, title_entries[i].second);
+        }
+        out.resize(kPageSize, 0);
+        write_page(out.data());
+        fences.push_back(title_entries[start].first);
+    }
+
+    // Directories, padded to whole pages
+    out.clear();
+    for (uint32_t row : first_rows) put(out, row);
+    out.resize(pages_for(out.size()) * kPageSize, 0);
+    for (size_t offset = 0; offset < out.size(); offset += kPageSize) write_page(&out[offset]);
+    out.clear();
+    for (uint64_t fence : fences) put(out, fence);
+    out.resize(pages_for(out.size()) * kPageSize, 0);
+    for (size_t offset = 0; offset < out.size(); offset += kPageSize) write_page(&out[offset]);
+
+    Header header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.byte_order = kByteOrderMark;
+    header.page_size = static_cast<uint32_t>(kPageSize);
+    header.source_size = source_size;
+    header.source_mtime = source_mtime;
+    header.rows = rows;
+    header.record_pages = record_pages;
+    header.index_entries = title_entries.size();
+    header.index_pages = fences.size();
+    std::vector<char> header_page(kPageSize, 0);
+    std::memcpy(header_page.data(), &header, sizeof(header));
+    file.seekp(0);
+    write_page(header_page.data());
+    file.close();
+    std::vector<std::pair<uint64_t, uint32_t>>().swap(title_entries);
+
+    if (failed) {
+        std::remove(temp_path.c_str());
+        return false;
+    }
+    // Readers never see a half-written catalog
+    return std::rename(temp_path.c_str(), path.c_str()) == 0;
+}
+
+// ========== PagedCatalog ==========
+
+PagedCatalog::PagedCatalog()
+    : pool(), rows(0), total_pages(0), source_bytes(0), source_mtime(0), index_entries(0), index_first_page(0),
+      first_rows(), fences() {}
+
+uint64_t PagedCatalog::hash(const std::string& text) {
+    uint64_t h = 14695981039346656037ull;
+    for (char c : text) {
+        h ^= static_cast<unsigned char>(c);
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+bool PagedCatalog::build(const std::string& path, const std::string& source_path,
+                         const std::vector<SessionConfig::TrackInfo>& tracks) {
+    uint64_t size = 0;
+    int64_t mtime = 0;
+    if (!MappedFile::stat(source_path, size, mtime)) return false;
+    Writer writer;
+    if (!writer.open(path, size, mtime)) return false;
+    for (const SessionConfig::TrackInfo& track : tracks) {
+        if (!writer.add(track)) return false;
+    }
+    return writer.finish();
+}
+
+bool PagedCatalog::open(const std::string& path, size_t pool_pages, std::string& reason) {
+    close();
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        reason = "no paged catalog";
+        return false;
+    }
+    std::vector<char> page(kPageSize);
+    Header header;
+    if (!file.read(page.data(), kPageSize)) {
+        reason = "paged catalog truncated";
+        return false;
+    }
+    std::memcpy(&header, page.data(), sizeof(header));
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.byte_order != kByteOrderMark
+        || header.page_size != kPageSize) {
+        reason = "not a paged catalog";
+        return false;
+    }
+    if (header.version != kVersion) {
+        reason = "paged catalog version " + std::to_string(header.version) + ", expected " + std::to_string(kVersion);
+        return false;
+    }
+
+    // Page counts are checked against the file before they size any allocation
+    file.seekg(0, std::ios::end);
+    const uint64_t file_pages = static_cast<uint64_t>(file.tellg()) / kPageSize;
+    if (header.record_pages > file_pages || header.index_pages > file_pages
+        || header.rows > header.index_pages * kIndexEntriesPerPage || header.rows > 0xFFFFFFFFu) {
+        reason = "paged catalog truncated or corrupt";
+        return false;
+    }
+
+    // The inner level: row directory and fence keys stay in memory
+    const uint64_t directory_pages = pages_for(header.record_pages * sizeof(uint32_t));
+    const uint64_t fence_pages = pages_for(header.index_pages * sizeof(uint64_t));
+    if (1 + header.record_pages + header.index_pages + directory_pages + fence_pages > file_pages) {
+        reason = "paged catalog truncated or corrupt";
+        return false;
+    }
+    std::vector<uint32_t> directory(header.record_pages);
+    std::vector<uint64_t> fence_keys(header.index_pages);
+    file.seekg(static_cast<std::streamoff>((1 + header.record_pages + header.index_pages) * kPageSize));
+    file.read(reinterpret_cast<char*>(directory.data()), directory.size() * sizeof(uint32_t));
+    file.seekg(static_cast<std::streamoff>((1 + header.record_pages + header.index_pages + directory_pages)
+                                           * kPageSize));
+    file.read(reinterpret_cast<char*>(fence_keys.data()), fence_keys.size() * sizeof(uint64_t));
+    if (!file || (header.rows > 0) != (header.record_pages > 0) || header.index_entries != header.rows
+        || (!directory.empty() && directory[0] != 0) || !std::is_sorted(directory.begin(), directory.end())
+        || (!directory.empty() && directory.back() >= header.rows)) {
+        reason = "paged catalog truncated or corrupt";
+        return false;
+    }
+
+    if (!pool.open(path, kPageSize, pool_pages)) {
+        reason = "cannot open paged catalog";
+        return false;
+    }
+    rows = header.rows;
+    total_pages = 1 + header.record_pages + header.index_pages + directory_pages + fence_pages;
+    source_bytes = header.source_size;
+    source_mtime = header.source_mtime;
+    index_entries = header.index_entries;
+    index_first_page = 1 + header.record_pages;
+    first_rows.swap(directory);
+    fences.swap(fence_keys);
+    return true;
+}
+
+void PagedCatalog::close() {
+    pool.close();
+    rows = total_pages = source_bytes = index_entries = index_first_page = 0;
+    source_mtime = 0;
+    std::vector<uint32_t>().swap(first_rows);
+    std::vector<uint64_t>().swap(fences);
+}
+
+bool PagedCatalog::read(size_t row, SessionConfig::TrackInfo& track) {
+    if (row >= rows) return false;
+    const size_t page_index = static_cast<size_t>(
+        std::upper_bound(first_rows.begin(), first_rows.end(), static_cast<uint32_t>(row)) - first_rows.begin() - 1);
+    const char* bytes = pool.fetch(1 + page_index);
+    if (bytes == nullptr) return false;
+
+    const size_t slot = row - first_rows[page_index];
+    const uint16_t count = get<uint16_t>(bytes);
+    if (slot >= count) return false;
+    size_t at = get<uint16_t>(bytes + sizeof(uint16_t) * (slot + 1));
+    // Fixed part: format, 4 ints, title length
+    if (at + 1 + 4 * sizeof(int32_t) + sizeof(uint16_t) > kPageSize) return false;
+
+    const uint8_t format = get<uint8_t>(bytes + at);
+    at += 1;
+    track.type = format == kFormatMP3 ? "MP3" : "WAV";
+    track.duration_seconds = get<int32_t>(bytes + at);
+    track.bpm = get<int32_t>(bytes + at + 4);
+    track.extra_param1 = get<int32_t>(bytes + at + 8);
+    track.extra_param2 = get<int32_t>(bytes + at + 12);
+    at += 16;
+    const uint16_t title_length = get<uint16_t>(bytes + at);
+    at += sizeof(uint16_t);
+    if (at + title_length + 1 > kPageSize) return false;
+    track.title.assign(bytes + at, title_length);
+    at += title_length;
+    const uint8_t artist_count = get<uint8_t>(bytes + at);
+    at += 1;
+    track.artists.clear();
+    for (uint8_t i = 0; i < artist_count; ++i) {
+        if (at + sizeof(uint16_t) > kPageSize) return false;
+        const uint16_t length = get<uint16_t>(bytes + at);
+        at += sizeof(uint16_t);
+        if (at + length > kPageSize) return false;
+        track.artists.push_back(std::string(bytes + at, length));
+        at += length;
+    }
+    return true;
+}
+
+bool PagedCatalog::title_at(size_t row, std::string& title) {
+    SessionConfig::TrackInfo track;
+    if (!read(row, track)) return false;
+    title.swap(track.title);
+    return true;
+}
+
+size_t PagedCatalog::find_title(const std::string& title) {
+    if (fences.empty()) return npos;
+    const uint64_t h = hash(title);
+
+    // Entries equal to h can start at the end of the page before the first fence >= h
+    size_t page_index = static_cast<size_t>(std::lower_bound(fences.begin(), fences.end(), h) - fences.begin());
+    if (page_index > 0) --page_index;
+
+    // Collect the hash's rows first: reading records below reuses pool frames
+    std::vector<uint32_t> candidates;
+    for (bool more = true; more && page_index < fences.size(); ++page_index) {
+        if (fences[page_index] > h) break;
+        const char* bytes = pool.fetch(index_first_page + page_index);
+        if (bytes == nullptr) return npos;
+        const uint32_t count = std::min<uint32_t>(get<uint32_t>(bytes), kIndexEntriesPerPage);
+        for (uint32_t i = 0; i < count; ++i) {
+            const char* entry = bytes + sizeof(uint32_t) + i * kIndexEntryBytes;
+            const uint64_t entry_hash = get<uint64_t>(entry);
+            if (entry_hash > h) {
+                more = false;
+                break;
+            }
+            if (entry_hash == h) candidates.push_back(get<uint32_t>(entry + sizeof(uint64_t)));
+        }
+    }
+
+    std::string stored;
+    for (uint32_t row : candidates) {
+        if (title_at(row, stored) && stored == title) return row;
+    }
+    return npos;
+}
+
+AudioTrack* PagedCatalog::materialize(size_t row) {
+    SessionConfig::TrackInfo track;
+    if (!read(row, track)) return nullptr;
+    if (track.type == "MP3") {
+        return new MP3Track(track.title, track.artists, track.duration_seconds, track.bpm,
+                            track.extra_param1, track.extra_param2 != 0);
+    }
+    return new WAVTrack(track.title, track.artists, track.duration_seconds, track.bpm,
+                        track.extra_param1, track.extra_param2);
+}
+
+size_t PagedCatalog::memory_bytes() const {
+    return pool.memory_bytes() + first_rows.capacity() * sizeof(uint32_t) + fences.capacity() * sizeof(uint64_t);
+}
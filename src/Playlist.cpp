@@ -1,83 +1,51 @@
 #include "Playlist.h"
 #include "AudioTrack.h"
+#include "MP3Track.h"
+#include "WAVTrack.h"
 #include <iostream>
 #include <algorithm>
+#include <climits>
+
+Playlist::Stats::Stats()
+    : track_count(0), total_duration(0), min_bpm(INT_MAX), max_bpm(INT_MIN),
+      quality_sum(0), mp3_count(0), wav_count(0) {}
+
+Playlist::Stats Playlist::EntryMeasure::measure(const Entry& entry) {
+    Stats stats;
+    if (!entry.track) return stats;
+    stats.track_count = 1;
+    stats.total_duration = entry.track->get_duration();
+    stats.min_bpm = stats.max_bpm = entry.bpm();
+    stats.quality_sum = entry.quality;
+    stats.mp3_count = entry.format == FORMAT_MP3 ? 1 : 0;
+    stats.wav_count = entry.format == FORMAT_WAV ? 1 : 0;
+    return stats;
+}
 
-Playlist::Playlist(const std::string& name) 
-    : head(nullptr), playlist_name(name), track_count(0) {
-    std::cout << "Created playlist: " << name << std::endl;
+Playlist::Stats Playlist::EntryMeasure::combine(const Stats& a, const Stats& b) {
+    Stats stats;
+    stats.track_count = a.track_count + b.track_count;
+    stats.total_duration = a.total_duration + b.total_duration;
+    stats.min_bpm = std::min(a.min_bpm, b.min_bpm);
+    stats.max_bpm = std::max(a.max_bpm, b.max_bpm);
+    stats.quality_sum = a.quality_sum + b.quality_sum;
+    stats.mp3_count = a.mp3_count + b.mp3_count;
+    stats.wav_count = a.wav_count + b.wav_count;
+    return stats;
 }
-// TODO: Fix memory leaks!
-// Students must fix this in Phase 1
 
+Playlist::Playlist(const std::string& name)
+    : entries(), playlist_name(name), removed_count(0),
+      bpm_histogram(std::make_shared<std::map<int, int>>()), title_index(), title_indexed(false) {
+    std::cout << "Created playlist: " << name << std::endl;
+}
 
 Playlist::~Playlist() {
-    PlaylistNode* curr=head;
-    while(curr!=nullptr){
-        PlaylistNode* next=curr->next;
-        delete curr->track;
-        delete curr;
-        curr=next;
-    }
     #ifdef DEBUG
     std::cout << "Destroying playlist: " << playlist_name << std::endl;
     #endif
 }
 
-Playlist::Playlist(const Playlist& other): head(nullptr),playlist_name(other.playlist_name),track_count(0){
-
-    if(other.head==nullptr){
-        return;
-    }
-    AudioTrack* cloned_head_track = other.head->track->clone().release();
-    head = new PlaylistNode(cloned_head_track);
-    track_count++;
-    PlaylistNode* current_source = other.head->next;
-    PlaylistNode* current_dest = head;
-    while (current_source != nullptr) {
-        AudioTrack* cloned_track = current_source->track->clone().release();
-        current_dest->next = new PlaylistNode(cloned_track);
-        current_dest = current_dest->next;
-        current_source = current_source->next;
-        track_count++;
-    }
-}
-
-Playlist& Playlist ::operator=(const Playlist& other){
-    if (this != &other){
-
-        PlaylistNode* curr = head;
-        while (curr != nullptr) {
-            PlaylistNode* next = curr->next;
-            delete curr->track; 
-            delete curr;
-            curr = next;
-        }
-
-    head = nullptr;
-    track_count = 0;
-    playlist_name = other.playlist_name;
-    
-    if (other.head != nullptr) {
-        AudioTrack* cloned_head_track = other.head->track->clone().release();
-        head = new PlaylistNode(cloned_head_track);
-        track_count++;
-        PlaylistNode* current_source = other.head->next;
-        PlaylistNode* current_dest = head;
-
-        while (current_source != nullptr) {
-            AudioTrack* cloned_track = current_source->track->clone().release();
-            current_dest->next = new PlaylistNode(cloned_track);
-            
-            current_dest = current_dest->next;
-            current_source = current_source->next;
-            track_count++;
-        }
-    }
-    }
-    return *this;
-}
-
 
 void Playlist::add_track(AudioTrack* track) {
     if (!track) {
@@ -85,54 +53,55 @@ void Playlist::add_track(AudioTrack* track) {
         return;
     }
 
-    // Create new node - this allocates memory!
-    PlaylistNode* new_node = new PlaylistNode(track);
-
-    // Add to front of list
-    new_node->next = head;
-    head = new_node;
-    track_count++;
+    // Once built, the index is kept current; parts shared with copies are cloned along one path
+    if (title_indexed) title_index.link(entries.size(), track->get_title());
+    Format format = FORMAT_OTHER;
+    if (dynamic_cast<const MP3Track*>(track)) {
+        format = FORMAT_MP3;
+    } else if (dynamic_cast<const WAVTrack*>(track)) {
+        format = FORMAT_WAV;
+    }
+    entries.push_back(Entry{track, 0, track->get_quality_score(), format});
+    count_bpm(track->get_bpm(), 1);
 
-    std::cout << "Added '" << track->get_title() << "' to playlist '" 
+    std::cout << "Added '" << track->get_title() << "' to playlist '"
               << playlist_name << "'" << std::endl;
 }
 
 void Playlist::remove_track(const std::string& title) {
-    PlaylistNode* current = head;
-    PlaylistNode* prev = nullptr;
-
-    // Find the track to remove
-    while (current && current->track->get_title() != title) {
-        prev = current;
-        current = current->next;
+    const TitleChain* found = index().chains.find(title);
+    if (!found) {
+        std::cout << "Track '" << title << "' not found in playlist" << std::endl;
+        return;
     }
-
-    if (current) {
-        // Remove from linked list
-        if (prev) {
-            prev->next = current->next;
-        } else {
-            head = current->next;
-        }
-        delete current->track;
-        delete current;
-        track_count--;
-        std::cout << "Removed '" << title << "' from playlist" << std::endl;
-
+    const TitleChain chain = *found;
+
+    // Earliest occurrence goes first; leave a tombstone so later positions stay valid
+    size_t position = chain.first;
+    count_bpm(entries[position].bpm(), -1);
+    entries.set(position, Entry{nullptr, 0, 0.0, FORMAT_OTHER});
+    ++removed_count;
+    if (position == chain.last) {
+        title_index.chains.erase(title);
     } else {
-        std::cout << "Track '" << title << "' not found in playlist" << std::endl;
+        title_index.chains.set(title, TitleChain{title_index.next_same_title[position], chain.last});
+    }
+    std::cout << "Removed '" << title << "' from playlist" << std::endl;
+
+    if (removed_count > 32 && removed_count * 2 > entries.size()) {
+        compact();
     }
 }
 
 void Playlist::display() const {
     std::cout << "\n=== Playlist: " << playlist_name << " ===" << std::endl;
-    std::cout << "Track count: " << track_count << std::endl;
+    std::cout << "Track count: " << get_track_count() << std::endl;
 
-    PlaylistNode* current = head;
     int index = 1;
-
-    while (current) {
-        std::vector<std::string> artists = current->track->get_artists();
+    entries.for_each([&](const Entry& entry) {
+        const AudioTrack* track = entry.track;
+        if (!track) return;
+        std::vector<std::string> artists = track->get_artists();
         std::string artist_list;
 
         std::for_each(artists.begin(), artists.end(), [&](const std::string& artist) {
@@ -142,53 +111,126 @@ void Playlist::display() const {
             artist_list += artist;
         });
 
-        AudioTrack* track = current->track;
-        std::cout << index << ". " << track->get_title() 
+        std::cout << index << ". " << track->get_title()
                   << " by " << artist_list
-                  << " (" << track->get_duration() << "s, " 
-                  << track->get_bpm() << " BPM)" << std::endl;
-        current = current->next;
+                  << " (" << track->get_duration() << "s, "
+                  << entry.bpm()
+                  << " BPM)" << std::endl;
         index++;
-    }
+    });
 
-    if (track_count == 0) {
+    if (is_empty()) {
         std::cout << "(Empty playlist)" << std::endl;
     }
     std::cout << "========================\n" << std::endl;
 }
 
 AudioTrack* Playlist::find_track(const std::string& title) const {
-    PlaylistNode* current = head;
+    const TitleChain* chain = index().chains.find(title);
+    return chain ? entries[chain->first].track : nullptr;
+}
 
-    while (current) {
-        if (current->track->get_title() == title) {
-            return current->track;
-        }
-        current = current->next;
-    }
+int Playlist::get_total_duration() const {
+    return static_cast<int>(entries.summary().total_duration);
+}
 
-    return nullptr;
+std::vector<AudioTrack*> Playlist::getTracks() const {
+    std::vector<AudioTrack*> live;
+    live.reserve(entries.size() - removed_count);
+    entries.for_each([&live](const Entry& entry) {
+        if (entry.track) live.push_back(entry.track);
+    });
+    return live;
 }
 
-int Playlist::get_total_duration() const {
-    int total = 0;
-    PlaylistNode* current = head;
+std::vector<std::string> Playlist::getTitles() const {
+    std::vector<std::string> titles;
+    titles.reserve(entries.size() - removed_count);
+    entries.for_each([&titles](const Entry& entry) {
+        if (entry.track) titles.push_back(entry.track->get_title());
+    });
+    return titles;
+}
 
-    while (current) {
-        total += current->track->get_duration();
-        current = current->next;
+void Playlist::set_bpm_override(size_t position, int bpm) {
+    size_t raw = raw_position(position);
+    if (raw < entries.size()) {
+        Entry entry = entries[raw];
+        count_bpm(entry.bpm(), -1);
+        entry.bpm_override = bpm;
+        count_bpm(entry.bpm(), 1);
+        entries.set(raw, entry);
     }
+}
 
-    return total;
+int Playlist::get_entry_bpm(size_t position) const {
+    size_t raw = raw_position(position);
+    if (raw >= entries.size()) return 0;
+    return entries[raw].bpm();
 }
 
-std::vector<AudioTrack*> Playlist::getTracks() const {
-    std::vector<AudioTrack*> tracks;
-    PlaylistNode* current = head;
-    while (current) {
-        if (current->track)
-            tracks.push_back(current->track);
-        current = current->next;
+size_t Playlist::raw_position(size_t position) const {
+    if (removed_count == 0) return std::min(position, entries.size());
+    // First raw prefix holding position + 1 live entries
+    return entries.search([position](const Stats& prefix) {
+        return static_cast<size_t>(prefix.track_count) > position;
+    });
+}
+
+Playlist::Stats Playlist::get_stats() const {
+    Stats stats = entries.summary();
+    if (stats.track_count == 0) stats.min_bpm = stats.max_bpm = 0;
+    return stats;
+}
+
+Playlist::Stats Playlist::get_window_stats(size_t first, size_t count) const {
+    size_t live = static_cast<size_t>(get_track_count());
+    size_t last = (count >= live || first + count >= live) ? entries.size() : raw_position(first + count);
+    Stats stats = entries.summarize(raw_position(first), last);
+    if (stats.track_count == 0) stats.min_bpm = stats.max_bpm = 0;
+    return stats;
+}
+
+void Playlist::count_bpm(int bpm, int delta) {
+    // Copy-on-write, like the entries: a copy made since the last edit keeps the current counts
+    if (bpm_histogram.use_count() > 1) bpm_histogram = std::make_shared<std::map<int, int>>(*bpm_histogram);
+    int& entries_at_bpm = (*bpm_histogram)[bpm];
+    entries_at_bpm += delta;
+    if (entries_at_bpm == 0) bpm_histogram->erase(bpm);
+}
+
+void Playlist::TitleIndex::link(size_t position, const std::string& title) {
+    next_same_title.push_back(std::string::npos);
+    std::pair<TitleChain*, bool> inserted = chains.insert(title, TitleChain{position, position});
+    if (!inserted.second) {
+        next_same_title.set(inserted.first->last, position);
+        inserted.first->last = position;
     }
-    return tracks;
-}
\ No newline at end of file
+}
+
+const Playlist::TitleIndex& Playlist::index() const {
+    if (!title_indexed) {
+        TitleIndex built;
+        entries.for_each([&built](const Entry& entry) {
+            if (entry.track) {
+                built.link(built.next_same_title.size(), entry.track->get_title());
+            } else {
+                built.next_same_title.push_back(std::string::npos);
+            }
+        });
+        title_index = built;
+        title_indexed = true;
+    }
+    return title_index;
+}
+
+void Playlist::compact() {
+    PersistentVector<Entry, EntryMeasure> live;
+    entries.for_each([&live](const Entry& entry) {
+        if (entry.track) live.push_back(entry);
+    });
+    entries = live;
+    removed_count = 0;
+    title_index = TitleIndex();
+    title_indexed = false;
+}
@@ -0,0 +1,130 @@
+#include "PlaylistReader.h"
+#include <cstring>
+#include <iostream>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+
+const size_t PlaylistReader::kReadBufferBytes;
+
+namespace {
+
+// The field separator
+const char* const kPlaylistDelimiters = ",";
+
+// has_tags may be written as a number or as true/false
+bool parse_flag_or_int(const TextView& field, int& value) {
+    if (field.to_int(value)) return true;
+    if (field == "true" || field == "yes") {
+        value = 1;
+        return true;
+    }
+    if (field == "false" || field == "no") {
+        value = 0;
+        return true;
+    }
+    return false;
+}
+
+} // namespace
+
+PlaylistReader::PlaylistReader(const std::string& playlist_path)
+    : fd(::open(playlist_path.c_str(), O_RDONLY)), buffer(), filled(0), scanned(0), at_end(false),
+      lines(TextView(), kPlaylistDelimiters), delimiters(), comment(), lines_read(0), malformed_count(0) {
+    if (fd >= 0) buffer.resize(kReadBufferBytes);
+}
+
+PlaylistReader::~PlaylistReader() {
+    if (fd >= 0) ::close(fd);
+}
+
+bool PlaylistReader::refill() {
+    const size_t tail = filled - scanned;
+    if (tail > 0) std::memmove(buffer.data(), buffer.data() + scanned, tail);
+    filled = tail;
+    scanned = 0;
+    while (!at_end && scanned == 0) {
+        if (filled == buffer.size()) buffer.resize(buffer.size() * 2);  // a line longer than the buffer
+        const ssize_t got = ::read(fd, buffer.data() + filled, buffer.size() - filled);
+        if (got < 0 && errno == EINTR) continue;
+        if (got < 0) {
+            std::cout << "[ERROR] Failed to read playlist file: " << std::strerror(errno) << std::endl;
+            filled = 0;
+        }
+        if (got <= 0) {
+            at_end = true;
+            break;
+        }
+        // Scan up to the last newline; the rest waits for the next read
+        const size_t before = filled;
+        filled += static_cast<size_t>(got);
+        for (size_t i = filled; i > before; --i) {
+            if (buffer[i - 1] == '\n') {
+                scanned = i;
+                break;
+            }
+        }
+    }
+    if (at_end) scanned = filled;  // the last line need not end with a newline
+    if (scanned == 0) return false;
+    lines = LineScanner(TextView(buffer.data(), scanned), kPlaylistDelimiters);
+    return true;
+}
+
+bool PlaylistReader::parse_line(const std::string& line, Record& record) {
+    const TextView view(line.data(), line.size());
+    LineDelimiters commas;
+    commas.assign(view, kPlaylistDelimiters);
+    return parse_line(view, commas, record);
+}
+
+bool PlaylistReader::parse_line(const TextView& line, const LineDelimiters& delimiters, Record& record) {
+    // A missing last field and an empty one are both malformed, so next_token splitting is enough.
+    // The last field must run to the end of the line: an eighth field, even an empty one, is malformed.
+    TextView fields[7];
+    size_t count = 0;
+    const char* last_end = nullptr;
+    delimiters.for_each_token(line, ',', [&fields, &count, &last_end](const TextView& field) {
+        last_end = field.data() + field.size();
+        fields[count++] = field.trim();
+        return count < 7;
+    });
+    if (count < 7 || last_end != line.data() + line.size()) return false;
+
+    if (fields[0] != "MP3" && fields[0] != "WAV") return false;
+    if (!fields[3].to_int(record.duration_seconds) || !fields[4].to_int(record.bpm)
+        || !fields[5].to_int(record.extra_param1) || !parse_flag_or_int(fields[6], record.extra_param2)) {
+        return false;
+    }
+    record.type.assign(fields[0].data(), fields[0].size());
+    record.title.assign(fields[1].data(), fields[1].size());
+    record.artist.assign(fields[2].data(), fields[2].size());
+    return true;
+}
+
+bool PlaylistReader::next(Record& record) {
+    TextView line;
+    for (;;) {
+        if (!lines.next(line, delimiters)) {
+            if (fd < 0 || !refill()) return false;
+            continue;
+        }
+        ++lines_read;
+
+        const TextView text = line.trim();
+        if (text.empty()) continue;
+        if (text.front() == '#') {
+            const TextView note = text.sub(1).trim();
+            if (comment.empty() && !note.empty()) comment.assign(note.data(), note.size());
+            continue;
+        }
+
+        if (parse_line(line, delimiters, record)) {
+            record.line_number = lines_read;
+            return true;
+        }
+        ++malformed_count;
+        std::cout << "[WARNING] Invalid playlist track at line " << lines_read << std::endl;
+    }
+    return false;
+}
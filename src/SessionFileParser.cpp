@@ -1,11 +1,142 @@
 #include "SessionFileParser.h"
+#include "PlaylistReader.h"
+#include "MappedFile.h"
+#include "TextView.h"
+#include "TextScan.h"
+#include "ConfigKeys.h"
 #include <iostream>
 #include <sstream>
 #include <algorithm>
+#include <iterator>
+#include <thread>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+
+const size_t SessionFileParser::kMinChunkBytes;
+
+namespace {
+
+// One worker's share of a parallel config parse
+struct ConfigChunk {
+    TextView text;
+    int lines_before;                               // lines in earlier chunks
+    SessionConfig partial;                          // this chunk's tracks and playlists
+    std::vector<std::pair<TextView, int>> settings; // setting lines, replayed in order at merge
+    std::ostringstream log;                         // this chunk's warnings, in line order
+
+    ConfigChunk() : text(), lines_before(0), partial(), settings(), log() {}
+};
+
+// Typed setter for each named key, in ConfigKey order; a null setter means not a session setting
+constexpr SettingBinding<SessionConfig> kSettingBindings[ConfigKeyHash::kCount] = {
+    {ConfigKey::AppName, &ConfigKeys::set_text<SessionConfig, &SessionConfig::app_name>, ""},
+    {ConfigKey::Version, &ConfigKeys::set_text<SessionConfig, &SessionConfig::version>, ""},
+    {ConfigKey::ControllerCacheSize, &ConfigKeys::set_int<SessionConfig, &SessionConfig::controller_cache_size>,
+     "Invalid cache size"},
+    {ConfigKey::CacheSize, nullptr, ""},    // ConfigurationManager's spelling; a playlist name here
+    {ConfigKey::DefaultCrossfadeTime, &ConfigKeys::set_int<SessionConfig, &SessionConfig::default_crossfade_time>,
+     "Invalid crossfade time"},
+    {ConfigKey::BpmTolerance, &ConfigKeys::set_int<SessionConfig, &SessionConfig::bpm_tolerance>,
+     "Invalid BPM tolerance"},
+    {ConfigKey::AutoSync, &ConfigKeys::set_flag<SessionConfig, &SessionConfig::auto_sync>, ""},
+};
+
+static_assert(bindings_in_order(kSettingBindings), "kSettingBindings must list the named keys in ConfigKey order");
+
+// The key/value split and the field separators of tracks, artists and playlists
+const char* const kConfigDelimiters = "=,;";
+
+// Read the whole file into contents with read(); unlike a mapping, the copy stays valid if the file is truncated
+bool read_file(const std::string& path, std::string& contents) {
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    contents.clear();
+    char buffer[64 * 1024];
+    for (;;) {
+        const ssize_t got = ::read(fd, buffer, sizeof(buffer));
+        if (got < 0 && errno == EINTR) continue;
+        if (got < 0) {
+            ::close(fd);
+            return false;
+        }
+        if (got == 0) break;
+        contents.append(buffer, static_cast<size_t>(got));
+    }
+    ::close(fd);
+    return true;
+}
+
+
+} // namespace
 
 // ========== PUBLIC METHODS (PROVIDED FOR STUDENTS) ==========
 
-bool SessionFileParser::parse_config_file(const std::string& config_path, SessionConfig& config) {
+bool SessionFileParser::parse_config_file(const std::string& config_path, SessionConfig& config, unsigned threads) {
+    MappedFile file;
+    if (!file.open(config_path)) {
+        // The stream parser reports a missing file the usual way
+        return parse_config_stream(config_path, config);
+    }
+    parse_config_text(TextView(file.data(), file.size()), config, threads, std::cout);
+    return true;
+}
+
+bool SessionFileParser::parse_config_file(const std::string& config_path, SessionConfig& config, unsigned threads,
+                                          std::ostream& log) {
+    std::string contents;
+    if (!read_file(config_path, contents)) {
+        log << "[ERROR] Cannot open config file: " << config_path << std::endl;
+        return false;
+    }
+    parse_config_text(TextView(contents.data(), contents.size()), config, threads, log);
+    return true;
+}
+
+bool SessionFileParser::validate_config(const SessionConfig& config, std::string& reason) {
+    if (config.controller_cache_size < 1) {
+        reason = "controller_cache_size must be at least 1";
+    } else if (config.bpm_tolerance < 0) {
+        reason = "bpm_tolerance must not be negative";
+    } else if (config.default_crossfade_time < 0) {
+        reason = "default_crossfade_time must not be negative";
+    } else if (config.library_tracks.empty()) {
+        reason = "no library tracks";
+    } else if (config.playlists.empty()) {
+        reason = "no playlists";
+    } else {
+        return true;
+    }
+    return false;
+}
+
+void SessionFileParser::parse_config_text(const TextView& text, SessionConfig& config, unsigned threads,
+                                          std::ostream& log) {
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = static_cast<unsigned>(std::min<size_t>(threads, std::max<size_t>(1, text.size() / kMinChunkBytes)));
+
+    if (threads > 1) {
+        parse_config_chunks(text, threads, config, log);
+    } else {
+        LineScanner lines(text, kConfigDelimiters);
+        TextView line;
+        LineDelimiters delimiters;
+        int line_number = 0;
+        while (lines.next(line, delimiters)) {
+            line_number++;
+            TextView trimmed = line.trim();
+            if (trimmed.empty() || trimmed.front() == '#') {
+                continue;
+            }
+            apply_config_line(trimmed, delimiters, line_number, config, log);
+        }
+    }
+
+    log << "Parsed config file: " << config.library_tracks.size() << " tracks found, "
+        << config.playlists.size() << " playlists found" << std::endl;
+}
+
+bool SessionFileParser::parse_config_stream(const std::string& config_path, SessionConfig& config) {
     std::ifstream file(config_path);
     
     if (!file.is_open()) {
@@ -61,6 +192,13 @@ bool SessionFileParser::parse_config_file(const std::string& config_path, Sessio
             } else if (key == "auto_sync") {
                 config.auto_sync = parse_bool(value);
                 
+            } else if (key == "default_crossfade_time") {
+                try {
+                    config.default_crossfade_time = std::stoi(value);
+                } catch (const std::exception& e) {
+                    std::cout << "[WARNING] Invalid crossfade time at line " << line_number << std::endl;
+                }
+                
             } else {
                 // Check if it's a playlist definition (any other key=value where value contains numbers/commas)
                 std::string playlist_name;
@@ -84,6 +222,33 @@ bool SessionFileParser::parse_config_file(const std::string& config_path, Sessio
     return true;
 }
 
+bool SessionFileParser::parse_playlist_file(const std::string& playlist_path, PlaylistData& playlist_data) {
+    PlaylistReader reader(playlist_path);
+    if (!reader.is_open()) {
+        std::cout << "[ERROR] Cannot open playlist file: " << playlist_path << std::endl;
+        return false;
+    }
+
+    playlist_data.name = extract_playlist_name(playlist_path);
+    playlist_data.tracks.clear();
+
+    PlaylistReader::Record record;
+    while (reader.next(record)) {
+        PlaylistData::PlaylistTrack track;
+        track.type = record.type;
+        track.title = record.title;
+        track.artist = record.artist;
+        track.duration_seconds = record.duration_seconds;
+        track.bpm = record.bpm;
+        track.extra_param1 = record.extra_param1;
+        track.extra_param2 = record.extra_param2;
+        playlist_data.tracks.push_back(track);
+    }
+    playlist_data.comment = reader.get_comment();
+
+    std::cout << "Parsed playlist file: " << playlist_data.tracks.size() << " tracks found" << std::endl;
+    return true;
+}
 
 std::string SessionFileParser::extract_playlist_name(const std::string& playlist_path) {
     // TODO: Students implement name extraction
@@ -150,10 +315,8 @@ std::string SessionFileParser::trim_string(const std::string& str) {
 }
 
 bool SessionFileParser::parse_bool(const std::string& str) {
-    std::string lower_str = str;
-    std::transform(lower_str.begin(), lower_str.end(), lower_str.begin(), ::tolower);
-    
-    return (lower_str == "true" || lower_str == "1" || lower_str == "yes");
+    // Case-folds while comparing instead of lowering a copy
+    return ConfigKeys::parse_flag(TextView(str.data(), str.size()));
 }
 
 bool SessionFileParser::is_comment_line(const std::string& line) {
@@ -255,4 +418,200 @@ bool SessionFileParser::parse_playlist_line(const std::string& line, std::string
     }
     
     return !track_indices.empty();
-}
\ No newline at end of file
+}
+
+bool SessionFileParser::parse_playlist_track(const std::string& line, PlaylistData::PlaylistTrack& track) {
+    PlaylistReader::Record record;
+    if (!PlaylistReader::parse_line(line, record)) {
+        return false;
+    }
+    track.type = record.type;
+    track.title = record.title;
+    track.artist = record.artist;
+    track.duration_seconds = record.duration_seconds;
+    track.bpm = record.bpm;
+    track.extra_param1 = record.extra_param1;
+    track.extra_param2 = record.extra_param2;
+    return true;
+}
+// ========== VIEW-BASED HELPERS (parse_config_file) ==========
+
+void SessionFileParser::parse_config_chunks(const TextView& text, unsigned threads, SessionConfig& config,
+                                            std::ostream& log) {
+    // Cut just after a newline near every 1/threads of the file; trailing chunks may be empty
+    std::vector<ConfigChunk> chunks(threads);
+    size_t begin = 0;
+    for (unsigned t = 0; t < threads; ++t) {
+        size_t end = text.size();
+        if (t + 1 < threads) {
+            end = std::max(begin, text.size() / threads * (t + 1));
+            size_t newline = text.sub(end).find('\n');
+            end = newline == TextView::npos ? text.size() : end + newline + 1;
+        }
+        chunks[t].text = text.sub(begin, end - begin);
+        begin = end;
+    }
+
+    // Pass 1: line counts, so every worker knows its first line number
+    std::vector<int> line_counts(threads, 0);
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < threads; ++t) {
+        workers.push_back(std::thread([&chunks, &line_counts, t]() {
+            const TextView& chunk = chunks[t].text;
+            line_counts[t] = static_cast<int>(TextScan::count(chunk, '\n'));
+        }));
+    }
+    for (std::thread& worker : workers) worker.join();
+    workers.clear();
+    for (unsigned t = 1; t < threads; ++t) {
+        chunks[t].lines_before = chunks[t - 1].lines_before + line_counts[t - 1];
+    }
+
+    // Pass 2: parse each chunk on its own
+    for (unsigned t = 0; t < threads; ++t) {
+        workers.push_back(std::thread([&chunks, t]() {
+            ConfigChunk& chunk = chunks[t];
+            LineScanner lines(chunk.text, kConfigDelimiters);
+            TextView line;
+            LineDelimiters delimiters;
+            int line_number = chunk.lines_before;
+            while (lines.next(line, delimiters)) {
+                line_number++;
+                TextView trimmed = line.trim();
+                if (trimmed.empty() || trimmed.front() == '#') {
+                    continue;
+                }
+                if (apply_config_line(trimmed, delimiters, line_number, chunk.partial, chunk.log)) {
+                    chunk.settings.push_back(std::make_pair(trimmed, line_number));
+                }
+            }
+        }));
+    }
+    for (std::thread& worker : workers) worker.join();
+
+    // Merge in file order: later lines win, exactly as in a sequential parse
+    size_t total_tracks = config.library_tracks.size();
+    for (const ConfigChunk& chunk : chunks) total_tracks += chunk.partial.library_tracks.size();
+    config.library_tracks.reserve(total_tracks);
+    std::ostream silent(nullptr);
+    LineDelimiters delimiters;
+    for (ConfigChunk& chunk : chunks) {
+        log << chunk.log.str() << std::flush;
+        std::vector<SessionConfig::TrackInfo>& tracks = chunk.partial.library_tracks;
+        config.library_tracks.insert(config.library_tracks.end(), std::make_move_iterator(tracks.begin()),
+                                     std::make_move_iterator(tracks.end()));
+        for (auto& playlist : chunk.partial.playlists) {
+            config.playlists[playlist.first].swap(playlist.second);
+        }
+        // Warnings for these lines were already logged by the worker
+        for (const auto& setting : chunk.settings) {
+            delimiters.assign(setting.first, kConfigDelimiters);
+            apply_config_line(setting.first, delimiters, setting.second, config, silent);
+        }
+    }
+}
+
+bool SessionFileParser::apply_config_line(const TextView& line, const LineDelimiters& delimiters, int line_number,
+                                          SessionConfig& config, std::ostream& log) {
+    const char* equals = delimiters.find(line, '=');
+    const size_t equals_pos = equals ? static_cast<size_t>(equals - line.data()) : TextView::npos;
+    TextView key = equals_pos == TextView::npos ? TextView() : line.sub(0, equals_pos).trim();
+    if (key.empty()) {
+        log << "[WARNING] Cannot parse line " << line_number << ": " << line.str() << std::endl;
+        return false;
+    }
+    TextView value = line.sub(equals_pos + 1).trim();
+
+    const ConfigKey id = ConfigKeys::lookup(key);
+    if (id == ConfigKey::LibraryTrack) {
+        // Parse straight into the vector's slot; a bad line is dropped again
+        config.library_tracks.emplace_back();
+        if (!parse_library_track(value, delimiters, config.library_tracks.back())) {
+            config.library_tracks.pop_back();
+            log << "[WARNING] Invalid track format at line " << line_number << std::endl;
+        }
+        return false;
+    }
+
+    if (id != ConfigKey::Unknown) {
+        const SettingBinding<SessionConfig>& binding = kSettingBindings[static_cast<size_t>(id)];
+        if (binding.set) {
+            if (!binding.set(config, value)) {
+                log << "[WARNING] " << binding.invalid << " at line " << line_number << std::endl;
+            }
+            return true;
+        }
+    }
+
+    // Any other key=value is a playlist definition
+    std::vector<int> track_indices;
+    parse_playlist_indices(key, value, delimiters, track_indices, log);
+    if (!track_indices.empty()) {
+        config.playlists[key.str()].swap(track_indices);
+    } else {
+        log << "[WARNING] Unknown config key '" << key.str() << "' at line " << line_number << std::endl;
+    }
+    return false;
+}
+
+bool SessionFileParser::parse_library_track(const TextView& value, const LineDelimiters& delimiters,
+                                            SessionConfig::TrackInfo& track_info) {
+    TextView parts[7];
+    size_t fields = 0;
+    delimiters.for_each_token(value, ',', [&parts, &fields](const TextView& field) {
+        parts[fields++] = field.trim();
+        return fields < 7;
+    });
+    if (fields < 7) {
+        return false;
+    }
+
+    if (parts[0] != "MP3" && parts[0] != "WAV") {
+        return false;
+    }
+    if (!parts[3].to_int(track_info.duration_seconds) || !parts[4].to_int(track_info.bpm)
+        || !parts[5].to_int(track_info.extra_param1) || !parts[6].to_int(track_info.extra_param2)) {
+        return false;
+    }
+    track_info.type.assign(parts[0].data(), parts[0].size());
+    track_info.title.assign(parts[1].data(), parts[1].size());
+    track_info.artists.clear();
+    parse_artist_list(parts[2], delimiters, track_info.artists);
+    return true;
+}
+
+void SessionFileParser::parse_artist_list(const TextView& artist_str, const LineDelimiters& delimiters,
+                                          std::vector<std::string>& artists) {
+    TextView cleaned = artist_str.trim();
+    if (cleaned.size() >= 2 && cleaned.front() == '{' && cleaned.back() == '}') {
+        cleaned = cleaned.sub(1, cleaned.size() - 2);
+    }
+
+    const size_t first = artists.size();
+    delimiters.for_each_token(cleaned, ';', [&artists](const TextView& artist) {
+        const TextView name = artist.trim();
+        if (!name.empty()) {
+            artists.push_back(name.str());
+        }
+        return true;
+    });
+    if (artists.size() == first) {
+        artists.push_back("Unknown Artist");
+    }
+}
+
+void SessionFileParser::parse_playlist_indices(const TextView& playlist_name, const TextView& value,
+                                               const LineDelimiters& delimiters, std::vector<int>& track_indices,
+                                               std::ostream& log) {
+    delimiters.for_each_token(value, ',', [&](const TextView& field) {
+        const TextView index = field.trim();
+        int parsed = 0;
+        if (index.to_int(parsed)) {
+            track_indices.push_back(parsed);
+        } else {
+            log << "[WARNING] Invalid track index in playlist '" << playlist_name.str() << "': "
+                      << index.str() << std::endl;
+        }
+        return true;
+    });
+}
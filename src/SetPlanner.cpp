@@ -0,0 +1,255 @@
+#include "SetPlanner.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+#include <unordered_map>
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+const double kEpsilon = 1e-9;
+
+struct Node {
+    int bpm;
+    int key;
+    int id;
+};
+
+double edge_cost(const SetPlanner::Options& options, int bpm_a, int key_a, int bpm_b, int key_b, bool same_track) {
+    int bpm_gap = std::abs(bpm_a - bpm_b);
+    double c = options.bpm_weight * bpm_gap;
+    if (bpm_gap > options.bpm_tolerance) c += options.over_tolerance_penalty;
+    if (key_a > 0 && key_b > 0) {
+        int d = std::abs(key_a - key_b) % 12;
+        c += options.key_weight * std::min(d, 12 - d);
+    }
+    if (same_track) c += options.repeat_penalty;
+    return c;
+}
+
+/**
+ * One worker's tour: nearest-neighbour seed, then 2-opt / Or-opt local search.
+ */
+class TourSearch {
+public:
+    TourSearch(const std::vector<Node>& nodes, const SetPlanner::Options& options,
+               Clock::time_point deadline, double lower_bound)
+        : nodes(nodes), options(options), deadline(deadline), lower_bound(lower_bound),
+          tour(), current_cost(0) {}
+
+    void seed_nearest_neighbour(size_t start) {
+        const size_t n = nodes.size();
+        std::vector<bool> visited(n, false);
+        tour.clear();
+        tour.reserve(n);
+        size_t current = start;
+        visited[current] = true;
+        tour.push_back(current);
+        for (size_t step = 1; step < n; ++step) {
+            size_t best = n;
+            double best_cost = 0;
+            for (size_t candidate = 0; candidate < n; ++candidate) {
+                if (visited[candidate]) continue;
+                double c = cost(current, candidate);
+                if (best == n || c < best_cost) {
+                    best = candidate;
+                    best_cost = c;
+                }
+            }
+            visited[best] = true;
+            tour.push_back(best);
+            current_cost += best_cost;
+            current = best;
+        }
+    }
+
+    void improve() {
+        bool improved = true;
+        while (improved && !should_stop()) {
+            improved = two_opt_pass();
+            improved = or_opt_pass() || improved;
+        }
+    }
+
+    double total_cost() const { return current_cost; }
+
+    const std::vector<size_t>& get_tour() const { return tour; }
+
+private:
+    const std::vector<Node>& nodes;
+    const SetPlanner::Options& options;
+    Clock::time_point deadline;
+    double lower_bound;
+    std::vector<size_t> tour;
+    double current_cost;
+
+    // A tour that already sweeps the BPM range exactly once cannot get any cheaper.
+    bool should_stop() const {
+        return current_cost <= lower_bound + kEpsilon || Clock::now() >= deadline;
+    }
+
+    double cost(size_t a, size_t b) const {
+        const Node& x = nodes[a];
+        const Node& y = nodes[b];
+        return edge_cost(options, x.bpm, x.key, y.bpm, y.key, x.id == y.id);
+    }
+
+    // Reverse tour[i..j] when it shortens the path.
+    bool two_opt_pass() {
+        const size_t n = tour.size();
+        bool improved = false;
+        for (size_t i = 0; i + 1 < n; ++i) {
+            if (should_stop()) return improved;
+            for (size_t j = i + 1; j < n; ++j) {
+                double delta = 0;
+                if (i > 0) delta += cost(tour[i - 1], tour[j]) - cost(tour[i - 1], tour[i]);
+                if (j + 1 < n) delta += cost(tour[i], tour[j + 1]) - cost(tour[j], tour[j + 1]);
+                if (delta < -kEpsilon) {
+                    std::reverse(tour.begin() + i, tour.begin() + j + 1);
+                    current_cost += delta;
+                    improved = true;
+                }
+            }
+        }
+        return improved;
+    }
+
+    // Move a run of 1-3 tracks (optionally reversed) to the cheapest other gap.
+    bool or_opt_pass() {
+        const int n = static_cast<int>(tour.size());
+        bool improved = false;
+        for (int len = 1; len <= 3 && len < n; ++len) {
+            for (int i = 0; i + len <= n; ++i) {
+                if (should_stop()) return improved;
+                const size_t first = tour[i];
+                const size_t last = tour[i + len - 1];
+                const int prev = i - 1;
+                const int next = i + len;
+
+                double removal_gain = 0;
+                if (prev >= 0) removal_gain += cost(tour[prev], first);
+                if (next < n) removal_gain += cost(last, tour[next]);
+                if (prev >= 0 && next < n) removal_gain -= cost(tour[prev], tour[next]);
+
+                int best_k = -2;
+                bool best_reversed = false;
+                double best_delta = -kEpsilon;
+                // Insert between tour[k] and tour[k + 1]; k == -1 means before the first track.
+                for (int k = -1; k < n; ++k) {
+                    if (k >= prev && k <= i + len - 1) continue;
+                    for (int reversed = 0; reversed < 2; ++reversed) {
+                        const size_t head = reversed ? last : first;
+                        const size_t tail = reversed ? first : last;
+                        double added = 0;
+                        if (k >= 0) added += cost(tour[k], head);
+                        if (k + 1 < n) added += cost(tail, tour[k + 1]);
+                        if (k >= 0 && k + 1 < n) added -= cost(tour[k], tour[k + 1]);
+                        double delta = added - removal_gain;
+                        if (delta < best_delta) {
+                            best_delta = delta;
+                            best_k = k;
+                            best_reversed = reversed != 0;
+                        }
+                    }
+                }
+                if (best_k == -2) continue;
+
+                std::vector<size_t> segment(tour.begin() + i, tour.begin() + i + len);
+                if (best_reversed) std::reverse(segment.begin(), segment.end());
+                tour.erase(tour.begin() + i, tour.begin() + i + len);
+                int insert_at = (best_k < i) ? best_k + 1 : best_k + 1 - len;
+                tour.insert(tour.begin() + insert_at, segment.begin(), segment.end());
+                current_cost += best_delta;
+                improved = true;
+            }
+        }
+        return improved;
+    }
+};
+
+} // namespace
+
+SetPlanner::SetPlanner(const Options& options) : options(options) {}
+
+double SetPlanner::path_cost(const std::vector<Stop>& stops, const std::vector<size_t>& order) const {
+    double total = 0;
+    for (size_t i = 1; i < order.size(); ++i) {
+        const Stop& a = stops[order[i - 1]];
+        const Stop& b = stops[order[i]];
+        total += edge_cost(options, a.bpm, a.key, b.bpm, b.key, a.title == b.title);
+    }
+    return total;
+}
+
+SetPlanner::Result SetPlanner::plan(const std::vector<Stop>& stops) const {
+    Clock::time_point started = Clock::now();
+    Result result;
+    const size_t n = stops.size();
+
+    std::vector<size_t> identity(n);
+    for (size_t i = 0; i < n; ++i) identity[i] = i;
+    result.cost_before = path_cost(stops, identity);
+
+    if (n < 3) {
+        result.order = identity;
+        result.cost_after = result.cost_before;
+        result.threads_used = 1;
+        result.elapsed_ms = std::chrono::duration<double, std::milli>(Clock::now() - started).count();
+        return result;
+    }
+
+    // Repeated tracks share an id so the repeat penalty is an int compare in the hot loop.
+    std::vector<Node> nodes(n);
+    std::unordered_map<std::string, int> ids;
+    int min_bpm = stops[0].bpm;
+    int max_bpm = stops[0].bpm;
+    for (size_t i = 0; i < n; ++i) {
+        auto inserted = ids.insert(std::make_pair(stops[i].title, static_cast<int>(ids.size())));
+        nodes[i].bpm = stops[i].bpm;
+        nodes[i].key = stops[i].key;
+        nodes[i].id = inserted.first->second;
+        min_bpm = std::min(min_bpm, stops[i].bpm);
+        max_bpm = std::max(max_bpm, stops[i].bpm);
+    }
+    const double lower_bound = options.bpm_weight * (max_bpm - min_bpm);
+
+    unsigned threads = options.threads;
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = static_cast<unsigned>(std::min<size_t>(threads, n));
+
+    Clock::time_point deadline = started + std::chrono::microseconds(
+        static_cast<long long>(options.time_budget_ms * 1000.0));
+
+    std::vector<std::vector<size_t>> tours(threads);
+    std::vector<double> costs(threads, 0);
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < threads; ++t) {
+        workers.push_back(std::thread([&, t]() {
+            TourSearch search(nodes, options, deadline, lower_bound);
+            search.seed_nearest_neighbour((t * n) / threads);
+            search.improve();
+            tours[t] = search.get_tour();
+            costs[t] = search.total_cost();
+        }));
+    }
+    for (std::thread& worker : workers) worker.join();
+
+    size_t best = 0;
+    for (size_t t = 1; t < threads; ++t) {
+        if (costs[t] < costs[best]) best = t;
+    }
+
+    // Never hand back something worse than what the DJ already had.
+    if (costs[best] < result.cost_before) {
+        result.order = tours[best];
+        result.cost_after = path_cost(stops, result.order);
+    } else {
+        result.order = identity;
+        result.cost_after = result.cost_before;
+    }
+    result.threads_used = threads;
+    result.elapsed_ms = std::chrono::duration<double, std::milli>(Clock::now() - started).count();
+    return result;
+}
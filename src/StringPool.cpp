@@ -0,0 +1,111 @@
+#include "StringPool.h"
+#include "LibrarySnapshot.h"
+#include <cstring>
+#include <utility>
+
+StringPool::StringPool() : bytes(), offsets(1, 0), hashes(), slots(16, 0) {}
+
+uint32_t StringPool::hash(const char* text, size_t length) {
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < length; ++i) {
+        h ^= static_cast<unsigned char>(text[i]);
+        h *= 16777619u;
+    }
+    return h;
+}
+
+bool StringPool::equals(uint32_t id, const char* text, size_t length) const {
+    return this->length(id) == length && std::memcmp(data(id), text, length) == 0;
+}
+
+uint32_t StringPool::find(const std::string& text) const {
+    const uint32_t h = hash(text.data(), text.size());
+    const size_t mask = slots.size() - 1;
+    for (size_t slot = h & mask; slots[slot] != 0; slot = (slot + 1) & mask) {
+        uint32_t id = slots[slot] - 1;
+        if (hashes[id] == h && equals(id, text.data(), text.size())) return id;
+    }
+    return npos;
+}
+
+uint32_t StringPool::intern(const std::string& text) {
+    const uint32_t h = hash(text.data(), text.size());
+    size_t mask = slots.size() - 1;
+    size_t slot = h & mask;
+    for (; slots[slot] != 0; slot = (slot + 1) & mask) {
+        uint32_t id = slots[slot] - 1;
+        if (hashes[id] == h && equals(id, text.data(), text.size())) return id;
+    }
+
+    uint32_t id = static_cast<uint32_t>(size());
+    bytes.append(text.data(), text.size());
+    offsets.push_back(static_cast<uint32_t>(bytes.size()));
+    hashes.push_back(h);
+    slots[slot] = id + 1;
+    if (2 * size() > slots.size()) grow();
+    return id;
+}
+
+void StringPool::grow() {
+    std::vector<uint32_t> bigger(slots.size() * 2, 0);
+    const size_t mask = bigger.size() - 1;
+    for (uint32_t id = 0; id < size(); ++id) {
+        size_t slot = hashes[id] & mask;
+        while (bigger[slot] != 0) slot = (slot + 1) & mask;
+        bigger[slot] = id + 1;
+    }
+    slots.swap(bigger);
+}
+
+size_t StringPool::memory_bytes() const {
+    return bytes.memory_bytes() + offsets.memory_bytes() + hashes.memory_bytes() + slots.memory_bytes();
+}
+
+void StringPool::save(SnapshotWriter& out) const {
+    out.column(bytes);
+    out.column(offsets);
+    out.column(hashes);
+    out.column(slots);
+}
+
+bool StringPool::load(SnapshotReader& in) {
+    StringPool restored;
+    if (!in.column(restored.bytes) || !in.column(restored.offsets) || !in.column(restored.hashes)
+        || !in.column(restored.slots)) {
+        return false;
+    }
+    const size_t table = restored.slots.size();
+    if (restored.offsets.empty() || restored.offsets.back() != restored.bytes.size()
+        || restored.hashes.size() != restored.size() || table < 16 || (table & (table - 1)) != 0
+        || 2 * restored.size() > table) {
+        return false;
+    }
+    // Const access: validating must not copy the mapped columns
+    const StringPool& view = restored;
+    for (size_t id = 0; id < view.size(); ++id) {
+        if (view.offsets[id] > view.offsets[id + 1]) return false;
+        if (view.hashes[id] != hash(view.data(static_cast<uint32_t>(id)), view.length(static_cast<uint32_t>(id)))) {
+            return false;
+        }
+    }
+    // Every id in exactly one slot, reachable from its home slot without crossing an empty
+    // one; out-of-range ids would make find() read past the columns, a full table would never stop probing
+    std::vector<bool> placed(view.size(), false);
+    const size_t mask = table - 1;
+    size_t empty = 0;
+    for (size_t slot = 0; slot < table; ++slot) {
+        const uint32_t entry = view.slots[slot];
+        if (entry == 0) {
+            ++empty;
+            continue;
+        }
+        if (entry > view.size() || placed[entry - 1]) return false;
+        placed[entry - 1] = true;
+        for (size_t probe = view.hashes[entry - 1] & mask; probe != slot; probe = (probe + 1) & mask) {
+            if (view.slots[probe] == 0) return false;
+        }
+    }
+    if (empty == 0 || empty != table - view.size()) return false;
+    *this = std::move(restored);
+    return true;
+}
@@ -0,0 +1,202 @@
+#include "TextScan.h"
+#include <cstring>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <immintrin.h>
+#define TEXT_SCAN_AVX2 1
+#endif
+
+const size_t TextScan::kBlockBytes;
+const size_t TextScan::kMaxDelimiters;
+const size_t TextScan::kBatchBlocks;
+
+namespace {
+
+typedef TextScan::Delimiters Delimiters;
+
+uint64_t hits_scalar(const char* block, const Delimiters& delimiters) {
+    uint64_t bits = 0;
+    for (size_t i = 0; i < TextScan::kBlockBytes; ++i) {
+        bool hit = false;
+        for (size_t d = 0; d < delimiters.count; ++d) hit |= block[i] == delimiters.bytes[d];
+        bits |= static_cast<uint64_t>(hit) << i;
+    }
+    return bits;
+}
+
+void masks_scalar(const char* text, size_t blocks, const Delimiters& first, const Delimiters& second,
+                  uint64_t* first_bits, uint64_t* second_bits) {
+    for (size_t b = 0; b < blocks; ++b) {
+        first_bits[b] = hits_scalar(text + b * TextScan::kBlockBytes, first);
+        second_bits[b] = hits_scalar(text + b * TextScan::kBlockBytes, second);
+    }
+}
+
+#ifdef __SSE2__
+// Bytes of a 16-byte chunk equal to any of count needles, as a movemask
+inline uint64_t hits_sse2(__m128i chunk, const __m128i* needles, size_t count) {
+    __m128i hit = _mm_setzero_si128();
+    for (size_t d = 0; d < count; ++d) hit = _mm_or_si128(hit, _mm_cmpeq_epi8(chunk, needles[d]));
+    return static_cast<uint32_t>(_mm_movemask_epi8(hit));
+}
+
+// Needles are broadcast once per call; each block is four 16-byte steps, loaded once for both sets
+void masks_sse2(const char* text, size_t blocks, const Delimiters& first, const Delimiters& second,
+                uint64_t* first_bits, uint64_t* second_bits) {
+    __m128i first_needles[TextScan::kMaxDelimiters];
+    __m128i second_needles[TextScan::kMaxDelimiters];
+    for (size_t d = 0; d < first.count; ++d) first_needles[d] = _mm_set1_epi8(first.bytes[d]);
+    for (size_t d = 0; d < second.count; ++d) second_needles[d] = _mm_set1_epi8(second.bytes[d]);
+    for (size_t b = 0; b < blocks; ++b) {
+        const char* block = text + b * TextScan::kBlockBytes;
+        uint64_t first_mask = 0;
+        uint64_t second_mask = 0;
+        for (size_t step = 0; step < TextScan::kBlockBytes; step += 16) {
+            const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + step));
+            first_mask |= hits_sse2(chunk, first_needles, first.count) << step;
+            second_mask |= hits_sse2(chunk, second_needles, second.count) << step;
+        }
+        first_bits[b] = first_mask;
+        second_bits[b] = second_mask;
+    }
+}
+#endif
+
+#ifdef TEXT_SCAN_AVX2
+// Built for AVX2 regardless of the compiler flags; only called once the CPU is known to have it
+__attribute__((target("avx2")))
+inline uint64_t hits_avx2(__m256i chunk, const __m256i* needles, size_t count) {
+    __m256i hit = _mm256_setzero_si256();
+    for (size_t d = 0; d < count; ++d) hit = _mm256_or_si256(hit, _mm256_cmpeq_epi8(chunk, needles[d]));
+    return static_cast<uint32_t>(_mm256_movemask_epi8(hit));
+}
+
+__attribute__((target("avx2")))
+void masks_avx2(const char* text, size_t blocks, const Delimiters& first, const Delimiters& second,
+                uint64_t* first_bits, uint64_t* second_bits) {
+    __m256i first_needles[TextScan::kMaxDelimiters];
+    __m256i second_needles[TextScan::kMaxDelimiters];
+    for (size_t d = 0; d < first.count; ++d) first_needles[d] = _mm256_set1_epi8(first.bytes[d]);
+    for (size_t d = 0; d < second.count; ++d) second_needles[d] = _mm256_set1_epi8(second.bytes[d]);
+    for (size_t b = 0; b < blocks; ++b) {
+        const char* block = text + b * TextScan::kBlockBytes;
+        const __m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+        const __m256i high = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 32));
+        first_bits[b] = hits_avx2(low, first_needles, first.count)
+                      | hits_avx2(high, first_needles, first.count) << 32;
+        second_bits[b] = hits_avx2(low, second_needles, second.count)
+                       | hits_avx2(high, second_needles, second.count) << 32;
+    }
+}
+#endif
+
+const Delimiters kNone("");
+
+TextScan::Level detect_level() {
+#ifdef TEXT_SCAN_AVX2
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return TextScan::Level::AVX2;
+#endif
+#ifdef __SSE2__
+    return TextScan::Level::SSE2;
+#else
+    return TextScan::Level::Scalar;
+#endif
+}
+
+}  // namespace
+
+TextScan::Delimiters::Delimiters(const char* set) : bytes(), count(0) {
+    while (count < kMaxDelimiters && set[count] != '\0') {
+        bytes[count] = set[count];
+        ++count;
+    }
+}
+
+TextScan::Level TextScan::best_level() {
+    static const Level level = detect_level();
+    return level;
+}
+
+const char* TextScan::level_name(Level level) {
+    switch (level) {
+        case Level::AVX2: return "AVX2";
+        case Level::SSE2: return "SSE2";
+        default: return "scalar";
+    }
+}
+
+void TextScan::masks(const char* text, size_t blocks, const Delimiters& first, const Delimiters& second,
+                     Level level, uint64_t* first_bits, uint64_t* second_bits) {
+#ifdef TEXT_SCAN_AVX2
+    if (level == Level::AVX2) return masks_avx2(text, blocks, first, second, first_bits, second_bits);
+#endif
+#ifdef __SSE2__
+    if (level != Level::Scalar) return masks_sse2(text, blocks, first, second, first_bits, second_bits);
+#endif
+    (void)level;
+    masks_scalar(text, blocks, first, second, first_bits, second_bits);
+}
+
+uint64_t TextScan::mask(const char* block, const Delimiters& delimiters, Level level) {
+    uint64_t bits = 0;
+    uint64_t none = 0;
+    masks(block, 1, delimiters, kNone, level, &bits, &none);
+    return bits;
+}
+
+size_t TextScan::count(const TextView& text, char c, Level level) {
+    const char needle[2] = {c, '\0'};
+    const Delimiters delimiters(needle);
+    uint64_t bits[kBatchBlocks];
+    uint64_t none[kBatchBlocks];
+    size_t total = 0;
+    size_t base = 0;
+    while (text.size() - base >= kBlockBytes) {
+        size_t blocks = (text.size() - base) / kBlockBytes;
+        if (blocks > kBatchBlocks) blocks = kBatchBlocks;
+        masks(text.data() + base, blocks, delimiters, kNone, level, bits, none);
+        for (size_t b = 0; b < blocks; ++b) total += static_cast<size_t>(__builtin_popcountll(bits[b]));
+        base += blocks * kBlockBytes;
+    }
+    for (; base < text.size(); ++base) total += text[base] == c;
+    return total;
+}
+
+BlockMasks::BlockMasks(const TextView& text, const char* first, const char* second, TextScan::Level level)
+    : text(text), first(first), second(second), level(level), batch_base(0), batch_bytes(0), first_masks(),
+      second_masks() {}
+
+void BlockMasks::fill(size_t base) {
+    batch_base = base;
+    const size_t remaining = text.size() - base;
+    size_t blocks = remaining / TextScan::kBlockBytes;
+    if (blocks > 0) {
+        if (blocks > TextScan::kBatchBlocks) blocks = TextScan::kBatchBlocks;
+        TextScan::masks(text.data() + base, blocks, first, second, level, first_masks, second_masks);
+        batch_bytes = blocks * TextScan::kBlockBytes;
+        return;
+    }
+    // The last, partial block: nothing past the text is read
+    char padded[TextScan::kBlockBytes] = {};
+    std::memcpy(padded, text.data() + base, remaining);
+    TextScan::masks(padded, 1, first, second, level, first_masks, second_masks);
+    const uint64_t inside = (static_cast<uint64_t>(1) << remaining) - 1;
+    first_masks[0] &= inside;
+    second_masks[0] &= inside;
+    batch_bytes = TextScan::kBlockBytes;
+}
+
+void LineDelimiters::assign(const TextView& text, const char* delimiters, TextScan::Level level) {
+    BlockMasks blocks(text, delimiters, "", level);
+    base = text.data();
+    words.clear();
+    for (size_t block = 0; block < text.size(); block += TextScan::kBlockBytes) {
+        uint64_t bits = 0;
+        uint64_t none = 0;
+        blocks.get(block, bits, none);
+        words.push_back(bits);
+    }
+}
@@ -0,0 +1,219 @@
+#include "TrackTable.h"
+#include <algorithm>
+#include <cctype>
+#include <climits>
+#include <limits>
+
+namespace {
+
+const size_t kBlock = 64;
+
+std::string lower_copy(const std::string& text) {
+    std::string lower(text);
+    std::transform(lower.begin(), lower.end(), lower.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return lower;
+}
+
+} // namespace
+
+TrackTable::Query::Query()
+    : has_format(false), format_value(0), bpm_low(INT_MIN), bpm_high(INT_MAX),
+      duration_low(INT_MIN), duration_high(INT_MAX),
+      quality_low(-std::numeric_limits<float>::infinity()), artist_text() {}
+
+TrackTable::Query& TrackTable::Query::format(Format value) {
+    has_format = true;
+    format_value = value;
+    return *this;
+}
+
+TrackTable::Query& TrackTable::Query::bpm_between(int low, int high) {
+    bpm_low = low;
+    bpm_high = high;
+    return *this;
+}
+
+TrackTable::Query& TrackTable::Query::duration_between(int low, int high) {
+    duration_low = low;
+    duration_high = high;
+    return *this;
+}
+
+TrackTable::Query& TrackTable::Query::min_quality(double score) {
+    quality_low = static_cast<float>(score);
+    return *this;
+}
+
+TrackTable::Query& TrackTable::Query::artist_contains(const std::string& text) {
+    artist_text = lower_copy(text);
+    return *this;
+}
+
+TrackTable::TrackTable()
+    : bpm(), duration(), format(), quality(), artist_signature(), artist_begins(), artist_ends(),
+      artist_ids(), unused_artist_ids(0), artist_lookup(), artist_names() {}
+
+void TrackTable::clear() {
+    *this = TrackTable();
+}
+
+uint32_t TrackTable::intern_artist(const std::string& name) {
+    auto found = artist_lookup.find(name);
+    if (found != artist_lookup.end()) return found->second;
+    uint32_t id = static_cast<uint32_t>(artist_names.size());
+    artist_lookup.insert(std::make_pair(name, id));
+    artist_names.push_back(lower_copy(name));
+    return id;
+}
+
+size_t TrackTable::add(const std::vector<std::string>& artists, int track_bpm, int duration_seconds,
+                       Format track_format, double track_quality) {
+    size_t row = bpm.size();
+    bpm.push_back(track_bpm);
+    duration.push_back(duration_seconds);
+    format.push_back(track_format);
+    quality.push_back(static_cast<float>(track_quality));
+    artist_signature.push_back(0);
+    artist_begins.push_back(static_cast<uint32_t>(artist_ids.size()));
+    artist_ends.push_back(static_cast<uint32_t>(artist_ids.size()));
+    store_artists(row, artists);
+    return row;
+}
+
+void TrackTable::set(size_t row, const std::vector<std::string>& artists, int track_bpm, int duration_seconds,
+                     Format track_format, double track_quality) {
+    bpm[row] = track_bpm;
+    duration[row] = duration_seconds;
+    format[row] = track_format;
+    quality[row] = static_cast<float>(track_quality);
+    store_artists(row, artists);
+}
+
+void TrackTable::store_artists(size_t row, const std::vector<std::string>& artists) {
+    // A longer list than before goes to the end of artist_ids (always the case for a new row)
+    const size_t span = artist_ends[row] - artist_begins[row];
+    if (artists.size() > span) {
+        artist_begins[row] = static_cast<uint32_t>(artist_ids.size());
+        artist_ids.resize(artist_ids.size() + artists.size());
+        unused_artist_ids += span;
+    } else {
+        unused_artist_ids += span - artists.size();
+    }
+    uint64_t signature = 0;
+    uint32_t k = artist_begins[row];
+    for (const std::string& artist : artists) {
+        uint32_t id = intern_artist(artist);
+        artist_ids[k++] = id;
+        signature |= static_cast<uint64_t>(1) << (id % 64);
+    }
+    artist_ends[row] = k;
+    artist_signature[row] = signature;
+    reclaim_artist_ids();
+}
+
+void TrackTable::reclaim_artist_ids() {
+    if (unused_artist_ids == 0 || unused_artist_ids <= artist_ids.size() / 2) return;
+    std::vector<uint32_t> packed;
+    packed.reserve(artist_ids.size() - unused_artist_ids);
+    for (size_t row = 0; row < artist_begins.size(); ++row) {
+        const uint32_t begin = static_cast<uint32_t>(packed.size());
+        packed.insert(packed.end(), artist_ids.begin() + artist_begins[row], artist_ids.begin() + artist_ends[row]);
+        artist_begins[row] = begin;
+        artist_ends[row] = static_cast<uint32_t>(packed.size());
+    }
+    artist_ids.swap(packed);
+    unused_artist_ids = 0;
+}
+
+void TrackTable::truncate(size_t rows) {
+    if (rows >= size()) return;
+    for (size_t row = rows; row < size(); ++row) unused_artist_ids += artist_ends[row] - artist_begins[row];
+    bpm.resize(rows);
+    duration.resize(rows);
+    format.resize(rows);
+    quality.resize(rows);
+    artist_signature.resize(rows);
+    artist_begins.resize(rows);
+    artist_ends.resize(rows);
+    reclaim_artist_ids();
+}
+
+std::vector<size_t> TrackTable::select(const Query& query, size_t limit) const {
+    std::vector<size_t> rows;
+    const size_t n = size();
+
+    // Resolve the artist predicate to a set of ids once, up front
+    const bool by_artist = !query.artist_text.empty();
+    std::vector<bool> wanted_artist;
+    uint64_t wanted_signature = 0;
+    if (by_artist) {
+        wanted_artist.assign(artist_names.size(), false);
+        for (size_t id = 0; id < artist_names.size(); ++id) {
+            if (artist_names[id].find(query.artist_text) != std::string::npos) {
+                wanted_artist[id] = true;
+                wanted_signature |= static_cast<uint64_t>(1) << (id % 64);
+            }
+        }
+        if (wanted_signature == 0) return rows;
+    }
+
+    const bool by_bpm = query.bpm_low != INT_MIN || query.bpm_high != INT_MAX;
+    const bool by_duration = query.duration_low != INT_MIN || query.duration_high != INT_MAX;
+    const bool by_quality = query.quality_low != -std::numeric_limits<float>::infinity();
+
+    for (size_t base = 0; base < n; base += kBlock) {
+        const size_t len = std::min(kBlock, n - base);
+        uint64_t mask = (len == kBlock) ? ~static_cast<uint64_t>(0) : ((static_cast<uint64_t>(1) << len) - 1);
+
+        if (query.has_format) {
+            const uint8_t* column = &format[base];
+            uint64_t bits = 0;
+            for (size_t i = 0; i < len; ++i) bits |= static_cast<uint64_t>(column[i] == query.format_value) << i;
+            mask &= bits;
+        }
+        if (mask && by_bpm) {
+            const int32_t* column = &bpm[base];
+            uint64_t bits = 0;
+            for (size_t i = 0; i < len; ++i) {
+                bits |= static_cast<uint64_t>((column[i] >= query.bpm_low) & (column[i] <= query.bpm_high)) << i;
+            }
+            mask &= bits;
+        }
+        if (mask && by_duration) {
+            const int32_t* column = &duration[base];
+            uint64_t bits = 0;
+            for (size_t i = 0; i < len; ++i) {
+                bits |= static_cast<uint64_t>((column[i] >= query.duration_low) & (column[i] <= query.duration_high)) << i;
+            }
+            mask &= bits;
+        }
+        if (mask && by_quality) {
+            const float* column = &quality[base];
+            uint64_t bits = 0;
+            for (size_t i = 0; i < len; ++i) bits |= static_cast<uint64_t>(column[i] >= query.quality_low) << i;
+            mask &= bits;
+        }
+        if (mask && by_artist) {
+            const uint64_t* column = &artist_signature[base];
+            uint64_t bits = 0;
+            for (size_t i = 0; i < len; ++i) bits |= static_cast<uint64_t>((column[i] & wanted_signature) != 0) << i;
+            mask &= bits;
+        }
+
+        while (mask) {
+            const size_t row = base + static_cast<size_t>(__builtin_ctzll(mask));
+            mask &= mask - 1;
+            if (by_artist) {
+                bool hit = false;
+                for (uint32_t k = artist_begins[row]; k < artist_ends[row] && !hit; ++k) {
+                    hit = wanted_artist[artist_ids[k]];
+                }
+                if (!hit) continue;
+            }
+            rows.push_back(row);
+            if (limit && rows.size() == limit) return rows;
+        }
+    }
+    return rows;
+}
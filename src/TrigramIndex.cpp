@@ -0,0 +1,172 @@
+#include "TrigramIndex.h"
+#include <algorithm>
+#include <cctype>
+#include <iterator>
+
+namespace {
+
+uint32_t pack(char a, char b, char c) {
+    return (static_cast<uint32_t>(static_cast<unsigned char>(a)) << 16)
+         | (static_cast<uint32_t>(static_cast<unsigned char>(b)) << 8)
+         | static_cast<uint32_t>(static_cast<unsigned char>(c));
+}
+
+} // namespace
+
+TrigramIndex::TrigramIndex() : postings(), gram_counts() {}
+
+std::string TrigramIndex::normalize(const std::string& text) {
+    std::string normalized;
+    normalized.reserve(text.size());
+    for (char raw : text) {
+        unsigned char c = static_cast<unsigned char>(raw);
+        if (std::isalnum(c)) {
+            normalized.push_back(static_cast<char>(std::tolower(c)));
+        } else if (!normalized.empty() && normalized.back() != ' ') {
+            normalized.push_back(' ');
+        }
+    }
+    if (!normalized.empty() && normalized.back() == ' ') normalized.pop_back();
+    return normalized;
+}
+
+std::vector<uint32_t> TrigramIndex::trigrams(const std::string& text, bool prefix) {
+    std::vector<uint32_t> grams;
+    const std::string words = normalize(text);
+    // " w1 w2 ... wn " -- single spaces between words double as both padding sides
+    std::string padded = " " + words;
+    if (!prefix) padded += ' ';
+    for (size_t i = 0; i + 2 < padded.size(); ++i) {
+        // Skip grams that span a word break (" x " is a one-letter word and is kept)
+        if (padded[i + 1] == ' ') continue;
+        grams.push_back(pack(padded[i], padded[i + 1], padded[i + 2]));
+    }
+    std::sort(grams.begin(), grams.end());
+    grams.erase(std::unique(grams.begin(), grams.end()), grams.end());
+    return grams;
+}
+
+void TrigramIndex::add(size_t row, const std::string& text) {
+    if (row >= gram_counts.size()) gram_counts.resize(row + 1, 0);
+    std::vector<uint32_t> grams = trigrams(text, false);
+    for (uint32_t gram : grams) {
+        Postings& list = postings[gram];
+        if (list.empty() || list.back() < row) {
+            list.push_back(static_cast<uint32_t>(row));
+        } else {
+            auto pos = std::lower_bound(list.begin(), list.end(), static_cast<uint32_t>(row));
+            if (*pos != row) list.insert(pos, static_cast<uint32_t>(row));
+        }
+    }
+    gram_counts[row] = static_cast<uint16_t>(std::min<size_t>(grams.size(), 0xFFFF));
+}
+
+void TrigramIndex::remove(size_t row, const std::string& text) {
+    for (uint32_t gram : trigrams(text, false)) unlink(gram, row);
+    if (row + 1 == gram_counts.size()) {
+        gram_counts.pop_back();
+    } else if (row < gram_counts.size()) {
+        gram_counts[row] = 0;
+    }
+}
+
+std::vector<TrigramIndex::Match> TrigramIndex::search(const std::string& query, size_t limit,
+                                                      size_t max_typos) const {
+    std::vector<Match> matches;
+    std::vector<uint32_t> grams = trigrams(query, true);
+    if (grams.empty() || limit == 0) return matches;
+    if (grams.size() > 255) grams.resize(255);  // per-row counts are 8-bit
+
+    // Rarest first; a trigram no row contains has an empty list
+    static const Postings none;
+    std::vector<const Postings*> lists;
+    for (uint32_t gram : grams) {
+        auto found = postings.find(gram);
+        lists.push_back(found == postings.end() ? &none : &found->second);
+    }
+    std::sort(lists.begin(), lists.end(),
+              [](const Postings* a, const Postings* b) { return a->size() < b->size(); });
+
+    // Count, per row, how many of the query's trigrams it contains. A row reaching t must appear
+    // in one of the q - t + 1 rarest lists, so only those can add candidates; the longer lists
+    // just bump the counts of rows already seen.
+    const size_t q = lists.size();
+    const size_t t = std::max((q + 1) / 2, q > 3 * max_typos ? q - 3 * max_typos : 0);
+    const size_t scanned = q - t + 1;
+
+    thread_local std::vector<uint8_t> counts;  // all zero between calls
+    thread_local std::vector<uint32_t> touched;
+    if (counts.size() < gram_counts.size()) counts.resize(gram_counts.size(), 0);
+    touched.clear();
+    for (size_t k = 0; k < scanned; ++k) {
+        for (uint32_t row : *lists[k]) {
+            if (counts[row]++ == 0) touched.push_back(row);
+        }
+    }
+    for (size_t k = scanned; k < q && !touched.empty(); ++k) {
+        for (uint32_t row : *lists[k]) {
+            if (counts[row] != 0) ++counts[row];
+        }
+    }
+
+    struct Scored {
+        uint32_t row;
+        uint32_t overlap;
+        uint16_t length;
+    };
+    std::vector<Scored> scored;
+    for (uint32_t row : touched) {
+        if (counts[row] >= t) scored.push_back(Scored{row, counts[row], gram_counts[row]});
+        counts[row] = 0;
+    }
+
+    const size_t keep = std::min(limit, scored.size());
+    std::partial_sort(scored.begin(), scored.begin() + keep, scored.end(), [](const Scored& a, const Scored& b) {
+        if (a.overlap != b.overlap) return a.overlap > b.overlap;
+        if (a.length != b.length) return a.length < b.length;
+        return a.row < b.row;
+    });
+    for (size_t i = 0; i < keep; ++i) {
+        matches.push_back(Match{scored[i].row, static_cast<double>(scored[i].overlap) / q});
+    }
+    return matches;
+}
+
+void TrigramIndex::update(size_t row, const std::string& old_text, const std::string& new_text) {
+    const std::vector<uint32_t> before = trigrams(old_text, false);
+    const std::vector<uint32_t> after = trigrams(new_text, false);
+    std::vector<uint32_t> gone;
+    std::vector<uint32_t> added;
+    std::set_difference(before.begin(), before.end(), after.begin(), after.end(), std::back_inserter(gone));
+    std::set_difference(after.begin(), after.end(), before.begin(), before.end(), std::back_inserter(added));
+    for (uint32_t gram : gone) unlink(gram, row);
+    for (uint32_t gram : added) {
+        Postings& list = postings[gram];
+        auto pos = std::lower_bound(list.begin(), list.end(), static_cast<uint32_t>(row));
+        if (pos == list.end() || *pos != row) list.insert(pos, static_cast<uint32_t>(row));
+    }
+    if (row >= gram_counts.size()) gram_counts.resize(row + 1, 0);
+    gram_counts[row] = static_cast<uint16_t>(std::min<size_t>(after.size(), 0xFFFF));
+}
+
+void TrigramIndex::unlink(uint32_t gram, size_t row) {
+    auto found = postings.find(gram);
+    if (found == postings.end()) return;
+    Postings& list = found->second;
+    auto pos = std::lower_bound(list.begin(), list.end(), static_cast<uint32_t>(row));
+    if (pos != list.end() && *pos == row) list.erase(pos);
+    if (list.empty()) postings.erase(found);
+}
+
+size_t TrigramIndex::memory_bytes() const {
+    size_t bytes = gram_counts.capacity() * sizeof(uint16_t)
+                 + postings.bucket_count() * sizeof(void*)
+                 + postings.size() * (sizeof(uint32_t) + sizeof(Postings) + 2 * sizeof(void*));
+    for (const auto& entry : postings) bytes += entry.second.capacity() * sizeof(uint32_t);
+    return bytes;
+}
+
+void TrigramIndex::clear() {
+    postings.clear();
+    gram_counts.clear();
+}
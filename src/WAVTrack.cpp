@@ -2,8 +2,8 @@
 #include <iostream>
 
 WAVTrack::WAVTrack(const std::string& title, const std::vector<std::string>& artists, 
-                   int duration, int bpm, int sample_rate, int bit_depth)
-    : AudioTrack(title, artists, duration, bpm), sample_rate(sample_rate), bit_depth(bit_depth) {
+                   int duration, int bpm, int sample_rate, int bit_depth, size_t waveform_samples)
+    : AudioTrack(title, artists, duration, bpm, waveform_samples), sample_rate(sample_rate), bit_depth(bit_depth) {
 
     std::cout << "WAVTrack created: " << sample_rate << "Hz/" << bit_depth << "bit" << std::endl;
 }
@@ -13,14 +13,14 @@ WAVTrack::WAVTrack(const std::string& title, const std::vector<std::string>& art
 void WAVTrack::load() {
     // TODO: Implement realistic WAV loading simulation
     // NOTE: Use exactly 2 spaces before the arrow (→) character
-    std::cout << "[WAVTrack::load] Loading WAV: \"" << title << "\" at " << sample_rate << "Hz/" << bit_depth << "bit (uncompressed)..." << std::endl;
+    *log_stream << "[WAVTrack::load] Loading WAV: \"" << title << "\" at " << sample_rate << "Hz/" << bit_depth << "bit (uncompressed)..." << std::endl;
     long size = duration_seconds * sample_rate * (bit_depth / 8) * 2;
-    std::cout <<"  → Estimated file size: " << size << " bytes"<<std::endl;
-    std::cout <<"  → Fast loading due to uncompressed format."<<std::endl;
+    *log_stream <<"  → Estimated file size: " << size << " bytes"<<std::endl;
+    *log_stream <<"  → Fast loading due to uncompressed format."<<std::endl;
 }
 
 void WAVTrack::analyze_beatgrid() {
-    std::cout << "[WAVTrack::analyze_beatgrid] Analyzing beat grid for: \"" << title << "\"" << std::endl;
+    *log_stream << "[WAVTrack::analyze_beatgrid] Analyzing beat grid for: \"" << title << "\"" << std::endl;
     // TODO: Implement WAV-specific beat detection analysis
     // Requirements:
     // 1. Print analysis message with track title
@@ -29,13 +29,17 @@ void WAVTrack::analyze_beatgrid() {
     // should print "  → Estimated beats: <beats>  → Precision factor: 1.0 (uncompressed audio)"
     double beats_estimated = (duration_seconds / 60.0) *bpm;
     // int precision_factor=1;
-    std::cout << "  → Estimated beats: " <<beats_estimated<< "  → Precision factor: 1 (uncompressed audio)"<<std::endl;
+    *log_stream << "  → Estimated beats: " <<beats_estimated<< "  → Precision factor: 1 (uncompressed audio)"<<std::endl;
 }
 
 double WAVTrack::get_quality_score() const {
     // TODO: Implement WAV quality scoring
     // NOTE: Use exactly 2 spaces before each arrow (→) character
     // NOTE: Cast beats to integer when printing
+    return quality_for(sample_rate, bit_depth);
+}
+
+double WAVTrack::quality_for(int sample_rate, int bit_depth) {
     double base_score=70;
     if(sample_rate>=44100)
         base_score=base_score+10;
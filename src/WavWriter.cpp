@@ -0,0 +1,101 @@
+#include "WavWriter.h"
+#include <iostream>
+#include <vector>
+
+namespace {
+
+const uint64_t kMaxDataBytes = 0xFFFFFFFFull - 36;
+
+bool host_is_little_endian() {
+    const uint16_t probe = 1;
+    return *reinterpret_cast<const unsigned char*>(&probe) == 1;
+}
+
+void put_u32(std::ofstream& out, uint32_t value) {
+    char bytes[4] = {
+        static_cast<char>(value & 0xFF), static_cast<char>((value >> 8) & 0xFF),
+        static_cast<char>((value >> 16) & 0xFF), static_cast<char>((value >> 24) & 0xFF)
+    };
+    out.write(bytes, 4);
+}
+
+void put_u16(std::ofstream& out, uint16_t value) {
+    char bytes[2] = {static_cast<char>(value & 0xFF), static_cast<char>((value >> 8) & 0xFF)};
+    out.write(bytes, 2);
+}
+
+} // namespace
+
+WavWriter::WavWriter() : file(), path(), data_bytes(0), sample_rate(0), channels(0) {}
+
+WavWriter::~WavWriter() {
+    if (file.is_open()) {
+        close();
+    }
+}
+
+bool WavWriter::open(const std::string& output_path, int rate, int channel_count) {
+    if (file.is_open()) {
+        close();
+    }
+    file.open(output_path.c_str(), std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        std::cout << "[ERROR] Cannot open WAV output: " << output_path << std::endl;
+        return false;
+    }
+    path = output_path;
+    sample_rate = rate;
+    channels = channel_count;
+    data_bytes = 0;
+    write_header(0);
+    return file.good();
+}
+
+bool WavWriter::write(const int16_t* samples, size_t sample_count) {
+    if (!file.is_open()) return false;
+    const uint64_t bytes = static_cast<uint64_t>(sample_count) * 2;
+    if (data_bytes + bytes > kMaxDataBytes) {
+        std::cout << "[WARNING] WAV output reached the 4 GiB RIFF limit: " << path << std::endl;
+        return false;
+    }
+    if (host_is_little_endian()) {
+        file.write(reinterpret_cast<const char*>(samples), static_cast<std::streamsize>(bytes));
+    } else {
+        std::vector<char> swapped(static_cast<size_t>(bytes));
+        for (size_t i = 0; i < sample_count; ++i) {
+            uint16_t v = static_cast<uint16_t>(samples[i]);
+            swapped[2 * i] = static_cast<char>(v & 0xFF);
+            swapped[2 * i + 1] = static_cast<char>(v >> 8);
+        }
+        file.write(swapped.data(), static_cast<std::streamsize>(bytes));
+    }
+    data_bytes += bytes;
+    return file.good();
+}
+
+bool WavWriter::close() {
+    if (!file.is_open()) return false;
+    file.seekp(0);
+    write_header(static_cast<uint32_t>(data_bytes));
+    bool ok = file.good();
+    file.close();
+    return ok;
+}
+
+void WavWriter::write_header(uint32_t data_size) {
+    const uint16_t bits_per_sample = 16;
+    const uint16_t block_align = static_cast<uint16_t>(channels * bits_per_sample / 8);
+    file.write("RIFF", 4);
+    put_u32(file, 36 + data_size);
+    file.write("WAVE", 4);
+    file.write("fmt ", 4);
+    put_u32(file, 16);                  // PCM fmt chunk size
+    put_u16(file, 1);                   // PCM
+    put_u16(file, static_cast<uint16_t>(channels));
+    put_u32(file, static_cast<uint32_t>(sample_rate));
+    put_u32(file, static_cast<uint32_t>(sample_rate) * block_align);
+    put_u16(file, block_align);
+    put_u16(file, bits_per_sample);
+    file.write("data", 4);
+    put_u32(file, data_size);
+}
@@ -13,6 +13,7 @@
 #include "DJControllerService.h"
 #include "MixingEngineService.h"
 #include "PointerWrapper.h"
+#include "BenchmarkRunner.h"
 /**
  * DJ Track Session Manager - Test Program
  * 
@@ -23,7 +24,7 @@
  * Students must fix the issues to make this program run cleanly.
  */
 
-bool del = false; // hint: what is the purpose of this variable? how it changes the ownership semantics?
+bool del = true; // hint: what is the purpose of this variable? how it changes the ownership semantics?
 void test_phase_1_memory_leaks() {
     
     std::cout << "\n======== PHASE 1: MEMORY LEAK TESTING ========" << std::endl;
@@ -161,21 +162,73 @@ int main(int argc, char* argv[]) {
     /**
      * Command-line argument parsing
      * - If "-I" is provided as the first argument, run interactive DJ software
-     * - If "-A" is provided as the second argument, enable play_all mode
+     * - If "-A" is provided after it, enable play_all mode
+     * - If "-P" is provided after it, reorder each playlist with the set planner
+     * - If "-R <file.wav>" is provided after it, render the session's mix to a WAV file
+     * - If "-L" is provided after it, preload the next track on a background thread
+     * - If "-T" is provided after it, trace per-stage latency; "-J <file.json>" also exports it
+     * - If "-S" is provided after it, start from the binary library snapshot (bin/dj_config.txt.snap)
+     * - If "-C" is provided after it, serve the library from a paged catalog file (bin/dj_config.txt.pages)
+     * - If "-D" is provided after it, collapse duplicate recordings found by acoustic fingerprint
+     * - If "-W" is provided after it, watch bin/dj_config.txt and apply edits during the set
+     * - If "-B" is provided as the first argument, run benchmarks: -B [name] [args...]
      */
     bool run_software = false;
     bool play_all = false;
+    bool plan_set_order = false;
+    bool preload_next = false;
+    bool trace_latency = false;
+    bool use_snapshot = false;
+    bool paged_catalog = false;
+    bool collapse_duplicates = false;
+    bool watch_config = false;
+    std::string latency_json_path;
+    std::string render_path;
+    if (argc > 1 && std::string(argv[1]) == "-B") {
+        return BenchmarkRunner::run(std::vector<std::string>(argv + 2, argv + argc));
+    }
+
     if (argc > 1 && std::string(argv[1]) == "-I") {
         run_software = true;
     }
 
-    if (argc > 2 && std::string(argv[2]) == "-A") {
-        play_all = true;
+    for (int i = 2; i < argc; ++i) {
+        std::string arg(argv[i]);
+        if (arg == "-A") {
+            play_all = true;
+        } else if (arg == "-P") {
+            plan_set_order = true;
+        } else if (arg == "-L") {
+            preload_next = true;
+        } else if (arg == "-T") {
+            trace_latency = true;
+        } else if (arg == "-S") {
+            use_snapshot = true;
+        } else if (arg == "-C") {
+            paged_catalog = true;
+        } else if (arg == "-D") {
+            collapse_duplicates = true;
+        } else if (arg == "-W") {
+            watch_config = true;
+        } else if (arg == "-J" && i + 1 < argc) {
+            trace_latency = true;
+            latency_json_path = argv[++i];
+        } else if (arg == "-R" && i + 1 < argc) {
+            render_path = argv[++i];
+        }
     }
 
     if (run_software) {
         std::cout << "\n============= RUNNING INTERACTIVE SOFTWARE =============" << std::endl;
         DJSession live_session("Interactive Session", play_all);
+        live_session.set_plan_set_order(plan_set_order);
+        live_session.set_render_output(render_path);
+        live_session.set_preload_next(preload_next);
+        live_session.set_use_snapshot(use_snapshot);
+        live_session.set_paged_catalog(paged_catalog);
+        live_session.set_collapse_duplicates(collapse_duplicates);
+        live_session.set_watch_config(watch_config);
+        live_session.set_latency_tracing(trace_latency, latency_json_path);
         live_session.simulate_dj_performance();
         std::cout << "============= INTERACTIVE SESSION ENDED =============\n" << std::endl;
     } else {